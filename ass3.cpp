@@ -7,8 +7,34 @@
 *
 */
 
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include "contractionhierarchy.h"
 #include "graph.h"
+#include "frozengraph.h"
+#include "landmarks.h"
+#include "snapshot.h"
+#include "threadpool.h"
+#include "writer.h"
+
+#ifdef GRAPH_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef GRAPH_ZSTD
+#include <zstd.h>
+#endif
+
+/* Traversal order recorded by recordVisit */
+static Graph::Label order;
+
+/* Number of Vertices visited by countVisit on each thread */
+static thread_local int visits;
 
 /* Constant array for testing */
 static const Graph::Label arr[10] {"A", "B", "C", "D", "E",
@@ -191,6 +217,284 @@ void getEdges() {
 	}
 }
 
+/*
+* Unit test for labels added out of order and for copying a Graph
+*/
+void copy() {
+
+	Graph g;
+
+	assert(g.Connect("Zeta", "Beta", 2) && g.Connect("Zeta", "Alpha", 1) &&
+		   g.Connect("Beta", "Zeta", 3) && g.Connect("Zeta", "Gamma", 4));
+
+	assert(g.GetEdges("Zeta") == "Alpha(1),Beta(2),Gamma(4)" &&
+		   g.GetEdges("Beta") == "Zeta(3)");
+
+	Graph copied(g);
+
+	assert(copied.NumberOfVertices() == 4 && copied.NumberOfEdges() == 4 &&
+		   copied.GetEdges("Zeta") == "Alpha(1),Beta(2),Gamma(4)" &&
+		   copied.GetEdges("Beta") == "Zeta(3)");
+
+	assert(copied.Disconnect("Zeta", "Beta") &&
+		   g.GetEdges("Zeta") == "Alpha(1),Beta(2),Gamma(4)");
+
+	Graph assigned;
+
+	assert(assigned.Connect("X", "Y"));
+
+	assigned = copied;
+
+	assert(!assigned.HasVertex("X") && assigned.NumberOfEdges() == 3 &&
+		   assigned.GetEdges("Zeta") == "Alpha(1),Gamma(4)");
+}
+
+/*
+* Unit test for moving a Graph, the Graph moved from is left empty
+*/
+void move() {
+
+	static_assert(std::is_nothrow_move_constructible<Graph>::value &&
+		          std::is_nothrow_move_assignable<Graph>::value,
+		          "Graph moves must not throw");
+
+	Graph g;
+
+	assert(g.Connect("A", "B", 1) && g.Connect("B", "C", 2));
+
+	Graph moved(std::move(g));
+
+	assert(moved.NumberOfVertices() == 3 && moved.NumberOfEdges() == 2 &&
+		   moved.GetEdges("A") == "B(1)" && g.NumberOfVertices() == 0 &&
+		   g.NumberOfEdges() == 0 && g.MemoryUsage() == 0);
+
+	assert(g.Connect("X", "Y", 3) && g.GetEdges("X") == "Y(3)");
+
+	g = std::move(moved);
+
+	assert(g.NumberOfVertices() == 3 && !g.HasVertex("X") &&
+		   g.GetEdges("B") == "C(2)" && moved.NumberOfVertices() == 0);
+
+	g = g.MinSpanningTree("A");
+
+	assert(g.NumberOfEdges() == 2 && g.SumOfEdges() == 3);
+}
+
+/*
+* Unit test for copy-on-write, copies share adjacency lists and each
+* Graph only sees its own changes
+*/
+void copyOnWrite() {
+
+	Graph g;
+
+	assert(!g.IsCopyOnWrite());
+
+	g.SetCopyOnWrite(true);
+
+	for (int i(0); i < 100; ++i) {
+
+		assert(g.Connect("hub", std::to_string(i), i) &&
+			   g.Connect(std::to_string(i), "hub", i));
+	}
+
+	std::ostringstream before;
+
+	assert(g.AddVertex("x"));
+	before << g;
+
+	Graph* shared = new Graph(g);
+
+	assert(shared->IsCopyOnWrite() && shared->NumberOfEdges() == 200 &&
+		   shared->MemoryUsage() < g.MemoryUsage() / 2);
+
+	assert(shared->Disconnect("hub", "5") && shared->Connect("5", "7", 57) &&
+		   g.Connect("hub", "x", 1) && g.Disconnect("7", "hub"));
+
+	assert(g.GetEdges("5") == "hub(5)" && g.GetEdges("7") == "" &&
+		   g.NumberOfEdges("hub") == 101 && g.NumberOfEdges() == 200 &&
+		   shared->GetEdges("5") == "7(57),hub(5)" &&
+		   shared->GetEdges("7") == "hub(7)" &&
+		   shared->NumberOfEdges("hub") == 99 &&
+		   shared->NumberOfEdges() == 200);
+
+	Graph chained;
+
+	chained = *shared;
+
+	std::istringstream in("- 5 7\n8 9 89\n");
+	Graph::EdgeStream edges(in, "stdin");
+
+	assert(chained.ReadBatch(edges, 10) == 2 &&
+		   chained.GetEdges("5") == "hub(5)" &&
+		   chained.GetEdges("8") == "9(89),hub(8)" &&
+		   shared->GetEdges("5") == "7(57),hub(5)" &&
+		   shared->GetEdges("8") == "hub(8)");
+
+	delete shared;
+
+	assert(chained.NumberOfEdges() == 200 &&
+		   chained.GetEdges("7") == "hub(7)");
+
+	Graph deep(chained);
+
+	deep.SetCopyOnWrite(false);
+
+	Graph copied(deep);
+
+	assert(!copied.IsCopyOnWrite() && copied.GetEdges("8") == "9(89),hub(8)");
+
+	assert(g.Connect("7", "hub", 7) && g.Disconnect("hub", "x"));
+
+	std::ostringstream after;
+
+	after << g;
+	assert(after.str() == before.str());
+
+	assert(g.ReadFile("graph1.txt") && g.IsCopyOnWrite() &&
+		   chained.GetEdges("8") == "9(89),hub(8)");
+
+	Graph hub;
+
+	hub.SetCopyOnWrite(true);
+
+	for (int i(0); i < 1000; ++i) {
+
+		assert(hub.Connect("hub", std::to_string(i), i));
+	}
+
+	std::size_t used = hub.MemoryUsage();
+
+	for (int i(0); i < 200; ++i) {
+
+		Graph copy(hub);
+		Graph::Label lbl = std::to_string(i);
+
+		if (i % 2 == 0) {
+
+			assert(copy.Disconnect("hub", lbl));
+		}
+
+		assert(hub.Disconnect("hub", lbl) && hub.Connect("hub", lbl, -i));
+
+		if (i % 2 == 1) {
+
+			assert(copy.Disconnect("hub", lbl) &&
+				   copy.NumberOfEdges("hub") == 999);
+		}
+	}
+
+	assert(hub.MemoryUsage() <= 2 * used && hub.NumberOfEdges() == 1000 &&
+		   hub.GetEdges("hub").substr(0, 15) == "0(0),1(-1),10(-");
+
+	Graph source;
+
+	source.SetCopyOnWrite(true);
+
+	for (int i(0); i < 500; ++i) {
+
+		assert(source.Connect(std::to_string(i), std::to_string(i + 1), i));
+	}
+
+	const Graph& readOnly = source;
+	std::vector<std::vector<Graph>> copies(4);
+	std::vector<std::thread> threads;
+
+	for (std::vector<Graph>& list : copies) {
+
+		threads.emplace_back([&readOnly, &list] {
+
+			for (int i(0); i < 20; ++i) {
+
+				list.emplace_back(readOnly);
+			}
+
+			assert(list.back().Disconnect("0", "1"));
+		});
+	}
+
+	for (std::thread& thread : threads) {
+
+		thread.join();
+	}
+
+	assert(source.Disconnect("1", "2") && source.NumberOfEdges() == 499);
+
+	for (std::vector<Graph>& list : copies) {
+
+		assert(list.front().NumberOfEdges() == 500 &&
+			   list.front().GetEdges("1") == "2(1)" &&
+			   list.back().NumberOfEdges() == 499 &&
+			   list.back().GetEdges("1") == "2(1)");
+	}
+
+	Graph wide;
+
+	wide.SetCopyOnWrite(true);
+
+	for (int i(0); i < 1000; ++i) {
+
+		assert(wide.Connect("A", std::to_string(i), i));
+	}
+
+	assert(wide.AddVertex("B"));
+
+	Graph unchanged(wide);
+	std::size_t sharedUsage = unchanged.MemoryUsage();
+	std::istringstream noops("A 5 7\n- A B\n");
+	Graph::EdgeStream noopEdges(noops, "stdin");
+
+	assert(!unchanged.Connect("A", "5", 7) &&
+		   !unchanged.Disconnect("A", "B") &&
+		   unchanged.ReadBatch(noopEdges, 10) == 2);
+	assert(unchanged.MemoryUsage() == sharedUsage &&
+		   unchanged.NumberOfEdges() == 1000);
+
+	assert(unchanged.Disconnect("A", "5") &&
+		   unchanged.MemoryUsage() > sharedUsage &&
+		   wide.NumberOfEdges("A") == 1000);
+}
+
+/*
+* Unit test for MemoryUsage, disconnected Edges are reused and clearing
+* frees the adjacency lists
+*/
+void memoryUsage() {
+
+	Graph g;
+
+	assert(g.MemoryUsage() == 0);
+
+	for (int i(0); i < 1000; ++i) {
+
+		assert(g.Connect("hub", std::to_string(i), i));
+	}
+
+	std::size_t used = g.MemoryUsage();
+
+	assert(used > 0 && used < 1001 * 64);
+
+	for (int i(0); i < 1000; i += 2) {
+
+		assert(g.Disconnect("hub", std::to_string(i)));
+	}
+
+	for (int i(0); i < 1000; i += 2) {
+
+		assert(g.Connect("hub", std::to_string(i), -i));
+	}
+
+	Graph copied(g);
+
+	assert(g.MemoryUsage() == used && g.NumberOfEdges() == 1000 &&
+		   g.GetEdges("hub").substr(0, 21) == "0(0),1(1),10(-10),100" &&
+		   copied.GetEdges("hub") == g.GetEdges("hub") &&
+		   copied.MemoryUsage() <= used);
+
+	assert(g.ReadFile("graph1.txt") && g.MemoryUsage() < used &&
+		   copied.NumberOfEdges() == 1000);
+}
+
 /*
 * Test readFile for graph0.txt
 */
@@ -282,269 +586,2158 @@ void file2() {
 }
 
 /*
-* Unit test for readFile
+* Unit test for ReadFile with graph3.txt, multi-character labels separated
+* by any whitespace
 */
-void readFile() {
+void file3() {
 
-	file0();
-	file1();
-	file2();
-}
+	Graph g;
+	std::string error;
 
-/*
-* Visit function to use in DFS & BFS
-* @param lbl The label of each visited Vertex
-*/
-void printVisit(const Graph::Label& lbl) {
-	
-	std::cout << lbl;
+	assert(g.ReadFile("graph3.txt", error) && error.empty());
+
+	assert(g.NumberOfEdges() == 4 && g.NumberOfVertices() == 4 &&
+		   g.GetEdges("Seattle") == "Portland(173),Spokane(280)" &&
+		   g.GetEdges("Portland") == "Boise(430)" &&
+		   g.GetEdges("Spokane") == "Boise(290)" && g.GetEdges("Boise") == "");
 }
 
 /*
-* Helper for DepthFirstSearch & BreadthFirstSearch unit tests
-* @param g The Graph to search on
-* @param arr The array of Vertex Labels to search from
-* @param size The size of the array
-* @param dfs True if DepthFirstSearch, else false (BreadthFirstSearch)
+* Helper for badFiles, writes a file and checks ReadFile rejects it
+* @param text The contents of the file
+* @param expected The error ReadFile should report
+* @param format The format of the file, defaults to EDGES
 */
-void searchTest(Graph* g, const Graph::Label arr[], int size, bool dfs) {
+void badFile(const std::string& text, const std::string& expected,
+			 Graph::Format format = Graph::Format::EDGES) {
 
-	for (int i(0); i < size; ++i) {
+	Graph g;
+	std::string error;
 
-		std::cout << "From " << arr[i] << ": ";
+	std::ofstream("bad.txt", std::ios::binary) << text;
 
-		if (dfs) {
+	assert(g.ReadFile("graph0.txt"));
+	assert(!g.ReadFile("bad.txt", format, error) && error == expected);
+	assert(g.NumberOfEdges() == 3 && g.GetEdges("A") == "B(1),C(8)");
 
-			g->DFS(arr[i], printVisit);
+	std::remove("bad.txt");
+}
 
-		} else {
-		
-			g->BFS(arr[i], printVisit);
-		}
-	
-		std::cout << std::endl;
-	}
+/*
+* Unit test for ReadFile errors, a file that cannot be read leaves the
+* Graph unchanged
+*/
+void badFiles() {
+
+	badFile("", "bad.txt:1: expected number of Edges, found ''");
+	badFile("two\nA B 1\n", "bad.txt:1: expected number of Edges, found 'two'");
+	badFile("-1\n", "bad.txt:1: expected number of Edges, found '-1'");
+	badFile("3\nA B 1\nB C 2\n", "bad.txt:3: expected 3 Edges, found 2");
+	badFile("2\nA B 1\nB C\n", "bad.txt:3: expected Edge weight, found ''");
+	badFile("2\nA B 1\nC\nB 2\n", "bad.txt:3: expected Edge ending label");
+	badFile("2\nA B 1\n\nB C 2x\n",
+			"bad.txt:4: expected Edge weight, found '2x'");
+	badFile("1\nA B 99999999999\n",
+			"bad.txt:2: expected Edge weight, found '99999999999'");
 
-	std::cout << std::endl;
+	Graph g;
+	std::string error;
+
+	assert(!g.ReadFile("missing.txt", error) &&
+		   error == "missing.txt: cannot read file");
 }
 
 /*
-* Unit test for DepthFirstSearch
+* Unit test for ThreadPool::Run, an exception on any worker reaches the
+* caller only after every worker finished
 */
-void DFS() {
-	
-	std::cout << "DFS" << std::endl << std::endl;
+void threadPool() {
 
-	Graph g;
+	for (int threads(1); threads <= 4; threads += 3) {
 
-	assert(g.ReadFile("graph0.txt"));
-	Graph::Label arr0[3] {"A", "B", "C"};
-	std::cout << "graph0" << std::endl;
-	searchTest(&g, arr0, 3, true);
+		ThreadPool pool(threads);
 
+		for (int thrower(0); thrower < pool.Size(); ++thrower) {
 
-	assert(g.ReadFile("graph1.txt"));
-	Graph::Label arr1[5] {"A", "B", "C", "H", "X"};
-	std::cout << "graph1" << std::endl;
-	searchTest(&g, arr1, 5, true);
+			std::atomic<int> finished(0);
+			bool thrown(false);
 
-	assert(g.ReadFile("graph2.txt"));
-	Graph::Label arr2[6] {"A", "D", "O", "T", "R", "S"};
-	std::cout << "graph2" << std::endl;
-	searchTest(&g, arr2, 6, true);
-}
+			try {
 
-/*
-* Unit test for BreadthFirstSearch
-*/
-void BFS() {
-	
-	std::cout << "BFS" << std::endl << std::endl;
+				pool.Run([&finished, thrower](int worker) {
 
-	Graph g;
+					std::this_thread::sleep_for(
+						std::chrono::milliseconds(worker == thrower ? 0 : 5));
 
-	assert(g.ReadFile("graph0.txt"));
-	Graph::Label arr0[3]{ "A", "B", "C" };
-	std::cout << "graph0" << std::endl;
-	searchTest(&g, arr0, 3, false);
+					++finished;
 
-	std::cout << std::endl;
+					if (worker == thrower) {
 
-	assert(g.ReadFile("graph1.txt"));
-	Graph::Label arr1[5]{ "A", "B", "C", "H", "X" };
-	std::cout << "graph1" << std::endl;
-	searchTest(&g, arr1, 5, false);
+						throw std::runtime_error("task");
+					}
+				});
 
-	std::cout << std::endl;
+			} catch (const std::runtime_error& e) {
 
-	assert(g.ReadFile("graph2.txt"));
-	Graph::Label arr2[6]{ "A", "D", "O", "T", "R", "S" };
-	std::cout << "graph2" << std::endl;
-	searchTest(&g, arr2, 6, false);
+				thrown = std::string(e.what()) == "task";
+			}
+
+			assert(thrown && finished == pool.Size());
+		}
+
+		std::atomic<int> ran(0);
+
+		pool.Run([&ran](int) { ++ran; });
+		assert(ran == pool.Size());
+	}
 }
 
 /*
-* Unit test for Dijkstra shortest path
+* Unit test for ReadFile on a ThreadPool, the Graph must match one built
+* with Connect in file order, including rejected self-loops and duplicates
 */
-void Dijkstra() {
+void parallelFile() {
 
-	Graph g;
-	Graph::WeightMap wMap;
-	Graph::PrevMap pMap;
+	Graph expected;
+	std::ostringstream text;
+	unsigned seed(7);
 
-	assert(g.ReadFile("graph0.txt"));
+	text << 3000 << "\n";
 
-	g.Dijkstra("A", wMap, pMap);
-	assert(wMap["B"] == 1 && wMap["C"] == 4 && pMap["B"] == "A" &&
-		   pMap["C"] == "B");
+	for (int i(0); i < 3000; ++i) {
 
-	wMap.clear();
-	pMap.clear();
+		seed = seed * 1103515245 + 12345;
 
-	g.Dijkstra("B", wMap, pMap);
-	assert(wMap["C"] == 3 && pMap["C"] == "B");
+		Graph::Label from = "v" + std::to_string(seed % 500),
+					 to = "v" + std::to_string(seed / 500 % 500);
+		Graph::Weight weight = static_cast<Graph::Weight>(seed / 250000 % 50);
 
-	wMap.clear();
-	pMap.clear();
+		expected.Connect(from, to, weight);
 
-	assert(g.ReadFile("graph1.txt"));
+		text << from << ((i % 7) ? " " : "\t ") << to << " " << weight
+			 << ((i % 5) ? "\n" : " ");
+	}
 
-	g.Dijkstra("A", wMap, pMap);
-	assert(wMap["B"] == 1 && wMap["C"] == 2 && wMap["D"] == 3 && wMap["E"] == 4
-		&& wMap["F"] == 5 && wMap["G"] == 4 && wMap["H"] == 3
-		&& pMap["B"] == "A" && pMap["C"] == "B" && pMap["D"] == "C" &&
-		   pMap["E"] == "D" && pMap["F"] == "E" && pMap["G"] == "H" &&
-		   pMap["H"] == "A");
+	text << "\nnot an edge\n";
 
-	wMap.clear();
-	pMap.clear();
+	std::ofstream("parallel.txt", std::ios::binary) << text.str();
 
-	g.Dijkstra("B", wMap, pMap);
-	assert(wMap["C"] == 1 && wMap["D"] == 2 && wMap["E"] == 3 && wMap["F"] == 4
-		&& wMap["G"] == 5 && pMap["C"] == "B" && pMap["D"] == "C" &&
-		   pMap["E"] == "D" && pMap["F"] == "E" && pMap["G"] == "F");
+	for (int threads : { 1, 3, 8 }) {
 
-	wMap.clear();
-	pMap.clear();
+		ThreadPool pool(threads);
+		Graph g;
+		std::string error;
 
-	g.Dijkstra("X", wMap, pMap);
-	assert(wMap["Y"] == 10 && pMap["Y"] == "X");
+		assert(g.ReadFile("parallel.txt", error, pool) && error.empty());
+		assert(g.NumberOfVertices() == expected.NumberOfVertices() &&
+			   g.NumberOfEdges() == expected.NumberOfEdges());
 
-	wMap.clear();
-	pMap.clear();
+		for (int v(0); v < 500; ++v) {
 
-	assert(g.ReadFile("graph2.txt"));
+			Graph::Label label = "v" + std::to_string(v);
+			Graph::WeightMap gw, ew;
+			Graph::PrevMap gp, ep;
 
-	g.Dijkstra("A", wMap, pMap);
-	assert(wMap["B"] == 0 && wMap["C"] == 0 && wMap["D"] == 0 && wMap["E"] == 0
-		&& wMap["F"] == 0 && wMap["G"] == 0 && wMap["H"] == 0 && wMap["I"] == 0
-		&& wMap["J"] == 0 && wMap["K"] == 0 && wMap["L"] == 0 && wMap["M"] == 0
-		&& wMap["N"] == 0 && pMap["B"] == "A" && pMap["C"] == "A" &&
-		   pMap["D"] == "A" && pMap["E"] == "B" && pMap["F"] == "B" &&
-		   pMap["G"] == "C" && pMap["H"] == "D" && pMap["I"] == "D" &&
-		   pMap["J"] == "F" && pMap["K"] == "G" && pMap["L"] == "G" &&
-		   pMap["M"] == "H" && pMap["N"] == "I");
+			assert(g.GetEdges(label) == expected.GetEdges(label));
 
-	wMap.clear();
-	pMap.clear();
+			g.Dijkstra(label, gw, gp);
+			expected.Dijkstra(label, ew, ep);
+			assert(gw == ew && gp == ep);
+		}
 
-	g.Dijkstra("O", wMap, pMap);
-	assert(wMap["P"] == 5 && wMap["Q"] == 2 && wMap["R"] == 3 && wMap["S"] == 6
-		&& wMap["T"] == 8 && wMap["U"] == 9 && pMap["P"] == "O" &&
-		   pMap["Q"] == "O" && pMap["R"] == "Q" && pMap["S"] == "R" &&
-		   pMap["T"] == "S" && pMap["U"] == "S");
+		std::ofstream("parallel.txt", std::ios::binary | std::ios::app)
+			<< "A B\n";
 
-	wMap.clear();
-	pMap.clear();
+		assert(g.ReadFile("parallel.txt", error, pool) && error.empty());
 
-	g.Dijkstra("T", wMap, pMap);
-	assert(wMap["O"] == 8 && wMap["P"] == 13 && wMap["Q"] == 10 &&
-	       wMap["R"] == 11 && wMap["S"] == 14 && wMap["U"] == 17 &&
-		   pMap["P"] == "O" && pMap["Q"] == "O" && pMap["R"] == "Q" &&
-		   pMap["S"] == "R" && pMap["U"] == "S");
+		std::ofstream("bad.txt", std::ios::binary)
+			<< "4000" << text.str().substr(4);
 
-	wMap.clear();
-	pMap.clear();
+		assert(!g.ReadFile("bad.txt", error, pool) &&
+			   error == "bad.txt:2403: expected Edge weight, found 'edge'");
+		assert(g.NumberOfEdges() == expected.NumberOfEdges());
+	}
 
-	g.Dijkstra("S", wMap, pMap);
-	assert(wMap["O"] == 2 && wMap["P"] == 7 && wMap["Q"] == 4 &&
-		   wMap["R"] == 1 && wMap["T"] == 2 && wMap["U"] == 3 &&
-		   pMap["P"] == "O" && pMap["Q"] == "O" && pMap["R"] == "S" &&
-		   pMap["U"] == "S" &&pMap["T"] == "S" && pMap["O"] == "R");
+	std::remove("parallel.txt");
+	std::remove("bad.txt");
+}
 
-	wMap.clear();
-	pMap.clear();
+/*
+* Helper for formats unit test, writes a file and reads it on one and on
+* three threads
+* @param text The contents of the file
+* @param format The format of the file
+* @param g The Graph to read into
+*/
+void formatFile(const std::string& text, Graph::Format format, Graph* g) {
 
-	g.Dijkstra("R", wMap, pMap);
-	assert(wMap["O"] == 1 && wMap["P"] == 6 && wMap["Q"] == 3 && wMap["S"] == 3
-		&& wMap["T"] == 5 && wMap["U"] == 6 && pMap["P"] == "O" &&
-		   pMap["Q"] == "O" && pMap["S"] == "R" && pMap["U"] == "S" &&
-		   pMap["T"] == "S" && pMap["O"] == "R");
+	ThreadPool pool(3);
+	Graph parallel;
+	std::string error;
+	std::ostringstream expected, actual;
+
+	std::ofstream("format.txt", std::ios::binary) << text;
+
+	assert(g->ReadFile("format.txt", format, error) && error.empty());
+	assert(parallel.ReadFile("format.txt", format, error, pool));
+
+	expected << *g;
+	actual << parallel;
+	assert(actual.str() == expected.str() &&
+		   parallel.NumberOfEdges() == g->NumberOfEdges());
+
+	std::remove("format.txt");
 }
 
 /*
-* Unit test for SumOfEdges
+* Unit test for ReadFile of DIMACS, SNAP, Matrix Market and METIS files
 */
-void sumOfEdges() {
+void formats() {
+
+	Graph g;
+
+	formatFile("c sample\np sp 5 4\nc arcs\na 1 2 7\na 2 3 1\n"
+			   "a 1 3 9\na 3 1 2\n", Graph::Format::DIMACS, &g);
+	assert(g.NumberOfVertices() == 5 && g.NumberOfEdges() == 4 &&
+		   g.GetEdges("1") == "2(7),3(9)" && g.GetEdges("3") == "1(2)" &&
+		   g.HasVertex("5") && g.GetEdges("5") == "");
+
+	formatFile("# Directed graph\n# FromNodeId\tToNodeId\n0\t1\n0\t2\n"
+			   "1\t2\t5\n2\t0\n2\t2\n", Graph::Format::SNAP, &g);
+	assert(g.NumberOfVertices() == 3 && g.NumberOfEdges() == 4 &&
+		   g.GetEdges("0") == "1(1),2(1)" && g.GetEdges("1") == "2(5)");
+
+	formatFile("%%MatrixMarket matrix coordinate real symmetric\n% comment\n"
+			   "3 3 3\n1 1 4.0\n2 1 2.6\n3 2 -1.4\n",
+			   Graph::Format::MATRIX_MARKET, &g);
+	assert(g.NumberOfVertices() == 3 && g.NumberOfEdges() == 4 &&
+		   g.GetEdges("1") == "2(3)" && g.GetEdges("2") == "1(3),3(-1)");
+
+	formatFile("%%MatrixMarket matrix coordinate pattern general\n"
+			   "2 4 1\n2 4\n", Graph::Format::MATRIX_MARKET, &g);
+	assert(g.NumberOfVertices() == 4 && g.GetEdges("2") == "4(1)");
+
+	formatFile("% comment\n4 2 001\n2 5 3 2\n1 5\n% comment\n1 2\n\n",
+			   Graph::Format::METIS, &g);
+	assert(g.NumberOfVertices() == 4 && g.NumberOfEdges() == 4 &&
+		   g.GetEdges("1") == "2(5),3(2)" && g.GetEdges("3") == "1(2)" &&
+		   g.GetEdges("4") == "");
+
+	formatFile("3 2 10\n7 2 3\n8 1\n9 1\n\n", Graph::Format::METIS, &g);
+	assert(g.NumberOfVertices() == 3 && g.GetEdges("1") == "2(1),3(1)");
+
+	badFile("a 1 2 3\n", "bad.txt:1: expected problem line 'p sp', found 'a'",
+			Graph::Format::DIMACS);
+	badFile("c x\np sp 2 1\na 1 3 4\n",
+			"bad.txt:3: expected Vertex from 1 to 2, found '3'",
+			Graph::Format::DIMACS);
+	badFile("p sp 2 2\na 1 2 4\n\n", "bad.txt:2: expected 2 arcs, found 1",
+			Graph::Format::DIMACS);
+	badFile("p sp 2 1\na 1 2\n", "bad.txt:2: expected Edge weight, found ''",
+			Graph::Format::DIMACS);
+	badFile("A B\nB C x\n", "bad.txt:2: expected Edge weight, found 'x'",
+			Graph::Format::SNAP);
+	badFile("%%MatrixMarket matrix coordinate complex general\n",
+			"bad.txt:1: unsupported field 'complex'",
+			Graph::Format::MATRIX_MARKET);
+	badFile("%%MatrixMarket matrix array real general\n",
+			"bad.txt:1: expected '%%MatrixMarket matrix coordinate' header",
+			Graph::Format::MATRIX_MARKET);
+	badFile("%%MatrixMarket matrix coordinate integer general\n%\n2 2 1\n"
+			"1 2 1.5\n", "bad.txt:4: expected Edge weight, found '1.5'",
+			Graph::Format::MATRIX_MARKET);
+	badFile("2 1\n2\n1\n1\n", "bad.txt:4: expected 2 Vertices, found more",
+			Graph::Format::METIS);
+	badFile("2 1\n2\n\n", "bad.txt:2: expected 2 neighbors, found 1",
+			Graph::Format::METIS);
+	badFile("2 1 2\n", "bad.txt:1: expected METIS format, found '2'",
+			Graph::Format::METIS);
+}
+
+/*
+* Unit test for ReadBatch, after every batch the Graph must match one
+* built with Connect and Disconnect in stream order
+*/
+void stream() {
+
+	std::ostringstream text;
+	std::vector<std::string> lines;
+	unsigned seed(11);
+
+	for (int i(0); i < 2000; ++i) {
+
+		seed = seed * 1103515245 + 12345;
+
+		std::string from = "v" + std::to_string(seed % 30),
+					to = "v" + std::to_string(seed / 30 % 30),
+					line = (seed / 900 % 3 == 0) ? "- " + from + " " + to :
+						   from + " " + to + " " + std::to_string(seed % 7);
+
+		lines.push_back(line);
+		text << line << ((i % 10) ? "\n" : "\r\n\n");
+	}
+
+	for (std::size_t batch : { 1, 7, 64, 5000 }) {
+
+		std::istringstream in(text.str());
+		Graph::EdgeStream edges(in, "stdin");
+		Graph g, expected;
+		std::size_t applied(0), read;
+
+		while ((read = g.ReadBatch(edges, batch)) > 0) {
+
+			assert(read <= batch);
+
+			for (std::size_t i(applied); i < applied + read; ++i) {
+
+				std::istringstream line(lines[i]);
+				Graph::Label from, to;
+				Graph::Weight weight;
+
+				if (lines[i][0] == '-') {
+
+					line >> from >> from >> to;
+					expected.Disconnect(from, to);
+
+				} else {
+
+					line >> from >> to >> weight;
+					expected.Connect(from, to, weight);
+				}
+			}
+
+			applied += read;
+
+			std::ostringstream actual, wanted;
+
+			actual << g;
+			wanted << expected;
+			assert(actual.str() == wanted.str() &&
+				   g.NumberOfEdges() == expected.NumberOfEdges());
+		}
+
+		assert(applied == lines.size() && !edges.Good() &&
+			   edges.Error().empty() && edges.Lines() == 2200);
+	}
+
+	std::istringstream in("A B 1\nB C 2\n- A B\nC D x\nD E 4\n");
+	Graph::EdgeStream edges(in, "stdin");
+	Graph g;
+
+	assert(g.ReadBatch(edges, 10) == 3 && !edges.Good() &&
+		   edges.Error() == "stdin:4: expected Edge weight, found 'x'");
+	assert(g.NumberOfEdges() == 1 && g.GetEdges("B") == "C(2)" &&
+		   g.GetEdges("A") == "" && !g.HasVertex("D"));
+	assert(g.ReadBatch(edges, 10) == 0);
+
+	std::istringstream bad("A B 1 2\n-\n");
+	Graph::EdgeStream extra(bad, "pipe");
+
+	assert(g.ReadBatch(extra, 10) == 0 &&
+		   extra.Error() == "pipe:1: expected end of line, found '2'");
+}
+
+/*
+* Helper for compressed unit test, reads a compressed file on one and on
+* three threads and compares it with the plain file
+* @param fileName The name of the compressed file
+* @param plain The name of the plain file
+* @param format The format of both files
+*/
+void compressedFile(const std::string& fileName, const std::string& plain,
+					Graph::Format format) {
+
+	ThreadPool pool(3);
+	Graph g, parallel, expected;
+	std::string error;
+	std::ostringstream actual, both, wanted;
+
+	assert(expected.ReadFile(plain, format, error));
+	assert(g.ReadFile(fileName, format, error) && error.empty());
+	assert(parallel.ReadFile(fileName, format, error, pool) && error.empty());
+
+	actual << g;
+	both << parallel;
+	wanted << expected;
+	assert(actual.str() == wanted.str() && both.str() == wanted.str() &&
+		   g.NumberOfEdges() == expected.NumberOfEdges());
+}
+
+/*
+* Unit test for ReadFile of gzip and zstd files, the text spans several
+* blocks of FileReader
+*/
+void compressed() {
+
+	std::ostringstream edges, metis;
+	unsigned seed(5);
+	int vertices(300000);
+
+	edges << 400000 << "\n";
+
+	for (int i(0); i < 400000; ++i) {
+
+		seed = seed * 1103515245 + 12345;
+
+		edges << "v" << seed % 5000 << " v" << seed / 5000 % 5000 << " "
+			  << seed % 100 << "\n";
+	}
+
+	metis << "% ring\n" << vertices << " " << vertices << "\n";
+
+	for (int v(1); v <= vertices; ++v) {
+
+		metis << (v + vertices - 2) % vertices + 1 << " " << v % vertices + 1
+			  << "\n";
+	}
+
+	std::ofstream("plain.txt", std::ios::binary) << edges.str();
+	std::ofstream("metis.txt", std::ios::binary) << metis.str();
+
+	Graph g;
+	std::string error;
+
+	std::ofstream("bad.txt", std::ios::binary) << "\x1f\x8b\x08";
+#ifdef GRAPH_ZLIB
+	assert(!g.ReadFile("bad.txt", error) &&
+		   error == "bad.txt: truncated gzip data");
+
+	std::string half = edges.str().substr(0, edges.str().size() / 2);
+	gzFile gz = gzopen("edges.gz", "wb");
+
+	gzwrite(gz, half.data(), static_cast<unsigned>(half.size()));
+	gzclose(gz);
+
+	gz = gzopen("edges.gz", "ab");
+	gzwrite(gz, edges.str().data() + half.size(),
+			static_cast<unsigned>(edges.str().size() - half.size()));
+	gzclose(gz);
+
+	gz = gzopen("metis.gz", "wb");
+	gzwrite(gz, metis.str().data(), static_cast<unsigned>(metis.str().size()));
+	gzclose(gz);
+
+	compressedFile("edges.gz", "plain.txt", Graph::Format::EDGES);
+	compressedFile("metis.gz", "metis.txt", Graph::Format::METIS);
+
+	std::ifstream file("metis.gz", std::ios::binary);
+	std::string bytes((std::istreambuf_iterator<char>(file)),
+					  std::istreambuf_iterator<char>());
+
+	bytes[bytes.size() / 2] ^= 0x55;
+	std::ofstream("bad.txt", std::ios::binary) << bytes;
+	assert(!g.ReadFile("bad.txt", Graph::Format::METIS, error) &&
+		   error == "bad.txt: corrupt gzip data");
+
+	std::remove("edges.gz");
+	std::remove("metis.gz");
+#else
+	assert(!g.ReadFile("bad.txt", error) && error ==
+		   "bad.txt: gzip compressed, build with GRAPH_ZLIB to read it");
+#endif
+
+	std::ofstream("bad.txt", std::ios::binary) << "\x28\xb5\x2f\xfd";
+#ifdef GRAPH_ZSTD
+	assert(!g.ReadFile("bad.txt", error) &&
+		   error == "bad.txt: truncated zstd data");
+
+	std::string packed(ZSTD_compressBound(edges.str().size()), '\0');
+
+	packed.resize(ZSTD_compress(&packed[0], packed.size(), edges.str().data(),
+								edges.str().size(), 1));
+	std::ofstream("edges.zst", std::ios::binary) << packed;
+
+	compressedFile("edges.zst", "plain.txt", Graph::Format::EDGES);
+
+	std::ofstream("bad.txt", std::ios::binary)
+		<< packed.substr(0, packed.size() / 2);
+	assert(!g.ReadFile("bad.txt", error) &&
+		   error == "bad.txt: truncated zstd data");
+
+	std::remove("edges.zst");
+#else
+	assert(!g.ReadFile("bad.txt", error) && error ==
+		   "bad.txt: zstd compressed, build with GRAPH_ZSTD to read it");
+#endif
+
+	std::remove("plain.txt");
+	std::remove("metis.txt");
+	std::remove("bad.txt");
+}
+
+/*
+* Unit test for readFile
+*/
+void readFile() {
+
+	file0();
+	file1();
+	file2();
+	file3();
+	badFiles();
+	parallelFile();
+	formats();
+	stream();
+	compressed();
+}
+
+/*
+* Visit function to use in DFS & BFS
+* @param lbl The label of each visited Vertex
+*/
+void printVisit(const Graph::Label& lbl) {
+	
+	std::cout << lbl;
+}
+
+/*
+* Helper for DepthFirstSearch & BreadthFirstSearch unit tests
+* @param g The Graph to search on
+* @param arr The array of Vertex Labels to search from
+* @param size The size of the array
+* @param dfs True if DepthFirstSearch, else false (BreadthFirstSearch)
+*/
+void searchTest(Graph* g, const Graph::Label arr[], int size, bool dfs) {
+
+	for (int i(0); i < size; ++i) {
+
+		std::cout << "From " << arr[i] << ": ";
+
+		if (dfs) {
+
+			g->DFS(arr[i], printVisit);
+
+		} else {
+		
+			g->BFS(arr[i], printVisit);
+		}
+	
+		std::cout << std::endl;
+	}
+
+	std::cout << std::endl;
+}
+
+/*
+* Unit test for DepthFirstSearch
+*/
+void DFS() {
 	
+	std::cout << "DFS" << std::endl << std::endl;
+
 	Graph g;
 
 	assert(g.ReadFile("graph0.txt"));
-	assert(g.SumOfEdges() == 12);
-	assert(g.Disconnect("A", "C"));
-	assert(g.SumOfEdges() == 4);
+	Graph::Label arr0[3] {"A", "B", "C"};
+	std::cout << "graph0" << std::endl;
+	searchTest(&g, arr0, 3, true);
+
 
 	assert(g.ReadFile("graph1.txt"));
-	assert(g.SumOfEdges() == 20);
-	assert(g.Disconnect("X", "Y"));
-	assert(g.SumOfEdges() == 10);
+	Graph::Label arr1[5] {"A", "B", "C", "H", "X"};
+	std::cout << "graph1" << std::endl;
+	searchTest(&g, arr1, 5, true);
 
 	assert(g.ReadFile("graph2.txt"));
-	assert(g.SumOfEdges() == 28);
-	assert(g.Disconnect("T", "O"));
-	assert(g.SumOfEdges() == 20);
+	Graph::Label arr2[6] {"A", "D", "O", "T", "R", "S"};
+	std::cout << "graph2" << std::endl;
+	searchTest(&g, arr2, 6, true);
 }
 
 /*
-* Unit test for MinSpanningTree
+* Unit test for BreadthFirstSearch
 */
-void MinSpanTree() {
+void BFS() {
 	
+	std::cout << "BFS" << std::endl << std::endl;
+
 	Graph g;
 
 	assert(g.ReadFile("graph0.txt"));
+	Graph::Label arr0[3]{ "A", "B", "C" };
+	std::cout << "graph0" << std::endl;
+	searchTest(&g, arr0, 3, false);
 
-	Graph* mst = g.MinSpanningTree("A");
-	assert(mst->SumOfEdges() == 4);
-	delete mst;
+	std::cout << std::endl;
 
 	assert(g.ReadFile("graph1.txt"));
+	Graph::Label arr1[5]{ "A", "B", "C", "H", "X" };
+	std::cout << "graph1" << std::endl;
+	searchTest(&g, arr1, 5, false);
 
-	mst = g.MinSpanningTree("A");
-	assert(mst->SumOfEdges() == 9);
-	delete mst;
+	std::cout << std::endl;
 
-	mst = g.MinSpanningTree("B");
-	assert(mst->SumOfEdges() == 5);
-	delete mst;
+	assert(g.ReadFile("graph2.txt"));
+	Graph::Label arr2[6]{ "A", "D", "O", "T", "R", "S" };
+	std::cout << "graph2" << std::endl;
+	searchTest(&g, arr2, 6, false);
+}
+
+/*
+* Unit test for DFS and BFS with callables that return a Control
+*/
+void visitors() {
+
+	Graph g;
+	Graph::Label visited;
 
 	assert(g.ReadFile("graph2.txt"));
 
-	mst = g.MinSpanningTree("A");
-	assert(mst->SumOfEdges() == 0);
-	delete mst;
+	g.DFS("A", [&visited](const Graph::Label& lbl) { visited += lbl; });
+	assert(visited == "ABEFJCGKLDHMIN");
 
-	mst = g.MinSpanningTree("R");
-	assert(mst->SumOfEdges() == 16);
-	delete mst;
+	visited.clear();
+	g.DFS("A", [&visited](const Graph::Label& lbl) {
 
-	mst = g.MinSpanningTree("P");
-	assert(mst->SumOfEdges() == 13);
-	delete mst;
+		visited += lbl;
 
-	mst = g.MinSpanningTree("S");
-	assert(mst->SumOfEdges() == 14);
-	delete mst;
+		return (visited.size() == 3) ? Graph::Control::STOP :
+									   Graph::Control::CONTINUE;
+	});
+	assert(visited == "ABE");
+
+	visited.clear();
+	g.DFS("A", [&visited](const Graph::Label& lbl) {
+
+		visited += lbl;
+
+		return (lbl == "D") ? Graph::Control::SKIP : Graph::Control::CONTINUE;
+	});
+	assert(visited == "ABEFJCGKLD");
+
+	visited.clear();
+	g.BFS("A", [&visited](const Graph::Label& lbl) {
+
+		visited += lbl;
+
+		return (lbl == "B") ? Graph::Control::SKIP : Graph::Control::CONTINUE;
+	});
+	assert(visited == "ABCDGHIKLMN");
+
+	visited.clear();
+	g.BFS("A", [&visited](const Graph::Label& lbl) {
+
+		visited += lbl;
+
+		return (lbl == "A") ? Graph::Control::STOP : Graph::Control::CONTINUE;
+	});
+	assert(visited == "A");
+
+	bool found(false);
+	int count(0);
+
+	g.BFS("O", [&found, &count](const Graph::Label& lbl) {
+
+		++count;
+		found = lbl == "S";
+
+		return (found) ? Graph::Control::STOP : Graph::Control::CONTINUE;
+	});
+	assert(found && count == 5);
+
+	visited.clear();
+	g.DFS("?", [&visited](const Graph::Label& lbl) { visited += lbl; });
+	g.BFS("?", [&visited](const Graph::Label& lbl) { visited += lbl; });
+	assert(visited.empty());
+}
+
+/*
+* Unit test for lazy DFS and BFS ranges
+*/
+void ranges() {
+
+	Graph g;
+	Graph::Label visited;
+
+	assert(g.ReadFile("graph2.txt"));
+
+	for (const Graph::Label& lbl : g.DFSRange("A")) {
+
+		visited += lbl;
+	}
+	assert(visited == "ABEFJCGKLDHMIN");
+
+	visited.clear();
+	for (const Graph::Label& lbl : g.BFSRange("A")) {
+
+		visited += lbl;
+	}
+	assert(visited == "ABCDEFGHIJKLMN");
+
+	visited.clear();
+	for (const Graph::Label& lbl : g.DFSRange("A")) {
+
+		visited += lbl;
+
+		if (visited.size() == 3) {
+
+			break;
+		}
+	}
+	assert(visited == "ABE");
+
+	visited.clear();
+	Graph::Traversal dfs = g.DFSRange("A");
+
+	for (Graph::Traversal::Iterator it = dfs.begin(); it != dfs.end(); ++it) {
+
+		visited += *it;
+
+		if (*it == "D") {
+
+			dfs.Skip();
+		}
+	}
+	assert(visited == "ABEFJCGKLD");
+
+	visited.clear();
+	Graph::Traversal bfs = g.BFSRange("A");
+	int depth(0);
+
+	for (const Graph::Label& lbl : bfs) {
+
+		assert(bfs.Depth() >= depth);
+
+		depth = bfs.Depth();
+		visited += lbl;
+
+		if (depth == 1) {
+
+			bfs.Skip();
+		}
+	}
+	assert(visited == "ABCD");
+
+	Graph::Traversal path = g.DFSRange("O");
+	int count(0);
+
+	for (Graph::Traversal::Iterator it = path.begin(); *it != "T"; it++) {
+
+		assert(path.Depth() == count++);
+	}
+	assert(count == 4 && path.Depth() == 4);
+
+	Graph::Traversal post = g.BFSRange("A");
+	Graph::Traversal::Iterator it = post.begin();
+
+	assert(*it++ == "A" && *it == "B" && *it++ == "B" && *it == "C");
+
+	visited.clear();
+	for (const Graph::Label& lbl : g.DFSRange("?")) {
+
+		visited += lbl;
+	}
+	for (const Graph::Label& lbl : g.BFSRange("?")) {
+
+		visited += lbl;
+	}
+	assert(visited.empty());
+}
+
+/*
+* Unit test for Dijkstra shortest path
+*/
+void Dijkstra() {
+
+	Graph g;
+	Graph::WeightMap wMap;
+	Graph::PrevMap pMap;
+
+	assert(g.ReadFile("graph0.txt"));
+
+	g.Dijkstra("A", wMap, pMap);
+	assert(wMap["B"] == 1 && wMap["C"] == 4 && pMap["B"] == "A" &&
+		   pMap["C"] == "B");
+
+	wMap.clear();
+	pMap.clear();
+
+	g.Dijkstra("B", wMap, pMap);
+	assert(wMap["C"] == 3 && pMap["C"] == "B");
+
+	wMap.clear();
+	pMap.clear();
+
+	assert(g.ReadFile("graph1.txt"));
+
+	g.Dijkstra("A", wMap, pMap);
+	assert(wMap["B"] == 1 && wMap["C"] == 2 && wMap["D"] == 3 && wMap["E"] == 4
+		&& wMap["F"] == 5 && wMap["G"] == 4 && wMap["H"] == 3
+		&& pMap["B"] == "A" && pMap["C"] == "B" && pMap["D"] == "C" &&
+		   pMap["E"] == "D" && pMap["F"] == "E" && pMap["G"] == "H" &&
+		   pMap["H"] == "A");
+
+	wMap.clear();
+	pMap.clear();
+
+	g.Dijkstra("B", wMap, pMap);
+	assert(wMap["C"] == 1 && wMap["D"] == 2 && wMap["E"] == 3 && wMap["F"] == 4
+		&& wMap["G"] == 5 && pMap["C"] == "B" && pMap["D"] == "C" &&
+		   pMap["E"] == "D" && pMap["F"] == "E" && pMap["G"] == "F");
+
+	wMap.clear();
+	pMap.clear();
+
+	g.Dijkstra("X", wMap, pMap);
+	assert(wMap["Y"] == 10 && pMap["Y"] == "X");
+
+	wMap.clear();
+	pMap.clear();
+
+	assert(g.ReadFile("graph2.txt"));
+
+	g.Dijkstra("A", wMap, pMap);
+	assert(wMap["B"] == 0 && wMap["C"] == 0 && wMap["D"] == 0 && wMap["E"] == 0
+		&& wMap["F"] == 0 && wMap["G"] == 0 && wMap["H"] == 0 && wMap["I"] == 0
+		&& wMap["J"] == 0 && wMap["K"] == 0 && wMap["L"] == 0 && wMap["M"] == 0
+		&& wMap["N"] == 0 && pMap["B"] == "A" && pMap["C"] == "A" &&
+		   pMap["D"] == "A" && pMap["E"] == "B" && pMap["F"] == "B" &&
+		   pMap["G"] == "C" && pMap["H"] == "D" && pMap["I"] == "D" &&
+		   pMap["J"] == "F" && pMap["K"] == "G" && pMap["L"] == "G" &&
+		   pMap["M"] == "H" && pMap["N"] == "I");
+
+	wMap.clear();
+	pMap.clear();
+
+	g.Dijkstra("O", wMap, pMap);
+	assert(wMap["P"] == 5 && wMap["Q"] == 2 && wMap["R"] == 3 && wMap["S"] == 6
+		&& wMap["T"] == 8 && wMap["U"] == 9 && pMap["P"] == "O" &&
+		   pMap["Q"] == "O" && pMap["R"] == "Q" && pMap["S"] == "R" &&
+		   pMap["T"] == "S" && pMap["U"] == "S");
+
+	wMap.clear();
+	pMap.clear();
+
+	g.Dijkstra("T", wMap, pMap);
+	assert(wMap["O"] == 8 && wMap["P"] == 13 && wMap["Q"] == 10 &&
+	       wMap["R"] == 11 && wMap["S"] == 14 && wMap["U"] == 17 &&
+		   pMap["P"] == "O" && pMap["Q"] == "O" && pMap["R"] == "Q" &&
+		   pMap["S"] == "R" && pMap["U"] == "S");
+
+	wMap.clear();
+	pMap.clear();
+
+	g.Dijkstra("S", wMap, pMap);
+	assert(wMap["O"] == 2 && wMap["P"] == 7 && wMap["Q"] == 4 &&
+		   wMap["R"] == 1 && wMap["T"] == 2 && wMap["U"] == 3 &&
+		   pMap["P"] == "O" && pMap["Q"] == "O" && pMap["R"] == "S" &&
+		   pMap["U"] == "S" &&pMap["T"] == "S" && pMap["O"] == "R");
+
+	wMap.clear();
+	pMap.clear();
+
+	g.Dijkstra("R", wMap, pMap);
+	assert(wMap["O"] == 1 && wMap["P"] == 6 && wMap["Q"] == 3 && wMap["S"] == 3
+		&& wMap["T"] == 5 && wMap["U"] == 6 && pMap["P"] == "O" &&
+		   pMap["Q"] == "O" && pMap["S"] == "R" && pMap["U"] == "S" &&
+		   pMap["T"] == "S" && pMap["O"] == "R");
+
+	wMap.clear();
+	pMap.clear();
+
+	Graph ties;
+
+	ties.Connect("A", "C", 1);
+	ties.Connect("A", "B", 1);
+	ties.Connect("B", "D", 1);
+	ties.Connect("C", "D", 1);
+
+	ties.Dijkstra("A", wMap, pMap);
+	assert(wMap["D"] == 2 && pMap["D"] == "B");
+}
+
+/*
+* Unit test for Dijkstra into a reused ShortestPathWorkspace
+*/
+void shortestPathWorkspace() {
+
+	Graph g, h;
+	Graph::ShortestPathWorkspace workspace;
+	Graph::Path path;
+
+	assert(g.ReadFile("graph2.txt"));
+	assert(h.ReadFile("graph1.txt"));
+
+	for (const char* origin : { "O", "T", "S", "R", "A" }) {
+
+		Graph::WeightMap wMap;
+		Graph::PrevMap pMap;
+
+		g.Dijkstra(origin, wMap, pMap);
+
+		Graph::ShortestPaths paths = g.Dijkstra(origin, workspace);
+
+		assert(paths.Origin() == origin && paths.Distance(origin) == 0 &&
+			   paths.Previous(origin) == Graph::NO_LABEL);
+		assert(paths.NumberOfReached() == static_cast<int>(pMap.size()) + 1);
+
+		for (const auto& prev : pMap) {
+
+			Graph::Weight weight = (wMap.count(prev.first)) ?
+				                   wMap.at(prev.first) : 0;
+
+			assert(paths.Distance(prev.first) == weight);
+			assert(paths.Previous(prev.first) == prev.second);
+			assert(paths.GetPath(prev.first, path) == weight);
+			assert(path.front() == origin && path.back() == prev.first);
+			assert(path[path.size() - 2] == prev.second);
+		}
+	}
+
+	Graph::ShortestPaths paths = g.Dijkstra("T", workspace);
+
+	assert(paths.GetPath("U", path) == 17);
+	assert((path == Graph::Path{ "T", "O", "Q", "R", "S", "U" }));
+	assert(paths.Distance("A") == INT_MAX && paths.Previous("A").empty());
+	assert(paths.GetPath("A", path) == INT_MAX && path.empty());
+
+	paths = h.Dijkstra("A", workspace);
+
+	assert(paths.Distance("G") == 4 && paths.Previous("G") == "H");
+	assert(paths.Distance("X") == INT_MAX);
+
+	paths = g.Dijkstra("?", workspace);
+
+	assert(paths.Origin() == Graph::NO_LABEL && paths.NumberOfReached() == 0);
+	assert(paths.Distance("A") == INT_MAX);
+
+	Graph cycle;
+	Graph::WeightMap wMap;
+	Graph::PrevMap pMap;
+
+	assert(cycle.Connect("A", "B", -1) && cycle.Connect("B", "A", -1));
+
+	cycle.Dijkstra("A", wMap, pMap);
+	assert(wMap.size() == 1 && wMap["B"] == -1 && pMap.size() == 1 &&
+		   pMap["B"] == "A");
+
+	paths = cycle.Dijkstra("A", workspace);
+
+	assert(paths.Distance("A") == 0 && paths.Distance("B") == -1);
+}
+
+/*
+* Unit test for batched Dijkstra and DistanceTable
+*/
+void batchedDijkstra() {
+
+	Graph g;
+	Graph::LabelList labels;
+	Graph::WeightTable table;
+
+	assert(g.ReadFile("graph2.txt"));
+
+	for (char c('A'); c <= 'U'; ++c) {
+
+		labels.push_back(Graph::Label(1, c));
+	}
+
+	labels.push_back("?");
+
+	for (int threads(1); threads <= 4; threads += 3) {
+
+		ThreadPool pool(threads);
+		std::vector<int> reached(labels.size(), -1);
+
+		g.Dijkstra(labels, [&reached](std::size_t source,
+			                          const Graph::ShortestPaths& paths) {
+
+			reached[source] = paths.NumberOfReached();
+		}, pool);
+
+		bool thrown(false);
+
+		try {
+
+			g.Dijkstra(labels, [](std::size_t source,
+				                  const Graph::ShortestPaths&) {
+
+				if (source % 5 == 3) {
+
+					throw std::runtime_error("sink");
+				}
+			}, pool);
+
+		} catch (const std::runtime_error& e) {
+
+			thrown = std::string(e.what()) == "sink";
+		}
+
+		assert(thrown);
+
+		g.DistanceTable(labels, labels, table, pool);
+		assert(table.size() == labels.size() * labels.size());
+
+		for (std::size_t i(0); i < labels.size(); ++i) {
+
+			Graph::WeightMap wMap;
+			Graph::PrevMap pMap;
+
+			g.Dijkstra(labels[i], wMap, pMap);
+			assert(reached[i] == static_cast<int>(pMap.size()) +
+				                 (labels[i] != "?"));
+
+			for (std::size_t j(0); j < labels.size(); ++j) {
+
+				Graph::Weight expected = (i == j && labels[i] != "?") ? 0 :
+					                     (pMap.count(labels[j]) == 0) ? INT_MAX :
+					                     (wMap.count(labels[j]) == 0) ? 0 :
+					                     wMap.at(labels[j]);
+
+				assert(table[i * labels.size() + j] == expected);
+			}
+		}
+	}
+
+	ThreadPool pool(2);
+
+	g.DistanceTable({ "O", "S" }, { "U", "A" }, table, pool);
+	assert((table == Graph::WeightTable{ 9, INT_MAX, 3, INT_MAX }));
+
+	g.DistanceTable({}, labels, table, pool);
+	assert(table.empty());
+}
+
+/*
+* Unit test for SumOfEdges
+*/
+void sumOfEdges() {
+	
+	Graph g;
+
+	assert(g.ReadFile("graph0.txt"));
+	assert(g.SumOfEdges() == 12);
+	assert(g.Disconnect("A", "C"));
+	assert(g.SumOfEdges() == 4);
+
+	assert(g.ReadFile("graph1.txt"));
+	assert(g.SumOfEdges() == 20);
+	assert(g.Disconnect("X", "Y"));
+	assert(g.SumOfEdges() == 10);
+
+	assert(g.ReadFile("graph2.txt"));
+	assert(g.SumOfEdges() == 28);
+	assert(g.Disconnect("T", "O"));
+	assert(g.SumOfEdges() == 20);
+}
+
+/*
+* Unit test for MinSpanningTree
+*/
+void MinSpanTree() {
+	
+	Graph g;
+
+	assert(g.ReadFile("graph0.txt"));
+
+	Graph mst = g.MinSpanningTree("A");
+	assert(mst.SumOfEdges() == 4);
+
+	assert(g.ReadFile("graph1.txt"));
+
+	mst = g.MinSpanningTree("A");
+	assert(mst.SumOfEdges() == 9);
+
+	mst = g.MinSpanningTree("B");
+	assert(mst.SumOfEdges() == 5);
+
+	assert(g.ReadFile("graph2.txt"));
+
+	mst = g.MinSpanningTree("A");
+	assert(mst.SumOfEdges() == 0);
+
+	mst = g.MinSpanningTree("R");
+	assert(mst.SumOfEdges() == 16);
+
+	mst = g.MinSpanningTree("P");
+	assert(mst.SumOfEdges() == 13);
+
+	mst = g.MinSpanningTree("S");
+	assert(mst.SumOfEdges() == 14);
+}
+
+/*
+* Visit function that records the traversal order
+* @param lbl The label of each visited Vertex
+*/
+void recordVisit(const Graph::Label& lbl) {
+
+	order += lbl;
+}
+
+/*
+* Visit function that counts visited Vertices on the calling thread,
+* the label of each visited Vertex is ignored
+*/
+void countVisit(const Graph::Label&) {
+
+	++visits;
+}
+
+/*
+* Unit test for const traversals, a reused VisitedSet gives the same order
+* and threads can query the same Graph at once
+*/
+void constTraversals() {
+
+	Graph g;
+
+	assert(g.ReadFile("graph2.txt"));
+
+	const Graph& c = g;
+	Graph::VisitedSet visited;
+	std::map<Graph::Label, int> dfsCount, bfsCount;
+	std::map<Graph::Label, Graph::WeightMap> weights;
+
+	for (char ch('A'); ch <= 'Z'; ++ch) {
+
+		Graph::Label lbl(1, ch), expected;
+		Graph::PrevMap pMap;
+
+		order.clear();
+		c.DFS(lbl, recordVisit);
+		expected = order;
+		order.clear();
+		c.DFS(lbl, recordVisit, visited);
+		assert(order == expected);
+		dfsCount[lbl] = static_cast<int>(order.size());
+
+		order.clear();
+		c.BFS(lbl, recordVisit);
+		expected = order;
+		order.clear();
+		c.BFS(lbl, recordVisit, visited);
+		assert(order == expected);
+		bfsCount[lbl] = static_cast<int>(order.size());
+
+		c.Dijkstra(lbl, weights[lbl], pMap);
+	}
+
+	bool passed[4] { false, false, false, false };
+	std::vector<std::thread> threads;
+
+	for (bool& ok : passed) {
+
+		threads.emplace_back([&c, &ok, &dfsCount, &bfsCount, &weights]() {
+
+			Graph::VisitedSet mine;
+
+			ok = true;
+
+			for (int round(0); round < 20; ++round) {
+
+				for (char ch('A'); ch <= 'Z'; ++ch) {
+
+					Graph::Label lbl(1, ch);
+					Graph::WeightMap wMap;
+					Graph::PrevMap pMap;
+
+					visits = 0;
+					c.DFS(lbl, countVisit, mine);
+					ok = ok && visits == dfsCount.at(lbl);
+
+					visits = 0;
+					c.BFS(lbl, countVisit, mine);
+					ok = ok && visits == bfsCount.at(lbl);
+
+					c.Dijkstra(lbl, wMap, pMap);
+					ok = ok && wMap == weights.at(lbl);
+
+					Graph mst = c.MinSpanningTree(lbl);
+					ok = ok && mst.NumberOfVertices() <= c.NumberOfVertices();
+				}
+			}
+		});
+	}
+
+	for (std::thread& thread : threads) {
+
+		thread.join();
+	}
+
+	for (const bool& ok : passed) {
+
+		assert(ok);
+	}
+}
+
+/*
+* Helper for FrozenGraph unit test, compares every query from every Vertex
+* @param fileName The name of the file to read the Graph from
+*/
+void frozenFile(const std::string& fileName) {
+
+	Graph g;
+
+	assert(g.ReadFile(fileName));
+
+	FrozenGraph f(g);
+
+	assert(f.NumberOfVertices() == g.NumberOfVertices() &&
+		   f.NumberOfEdges() == g.NumberOfEdges() &&
+		   f.SumOfEdges() == g.SumOfEdges() && !f.HasVertex("?") &&
+		   f.NumberOfEdges("?") == -1 && f.GetEdges("?") == "");
+
+	for (char c('A'); c <= 'Z'; ++c) {
+
+		Graph::Label lbl(1, c);
+
+		assert(f.HasVertex(lbl) == g.HasVertex(lbl) &&
+			   f.NumberOfEdges(lbl) == g.NumberOfEdges(lbl) &&
+			   f.GetEdges(lbl) == g.GetEdges(lbl));
+
+		if (!g.HasVertex(lbl)) {
+
+			continue;
+		}
+
+		Graph::Label expected;
+
+		order.clear();
+		g.DFS(lbl, recordVisit);
+		expected = order;
+		order.clear();
+		f.DFS(lbl, recordVisit);
+		assert(order == expected);
+
+		order.clear();
+		g.BFS(lbl, recordVisit);
+		expected = order;
+		order.clear();
+		f.BFS(lbl, recordVisit);
+		assert(order == expected);
+
+		Graph::WeightMap gw, fw;
+		Graph::PrevMap gp, fp;
+
+		g.Dijkstra(lbl, gw, gp);
+		f.Dijkstra(lbl, fw, fp, FrozenGraph::Queue::BINARY_HEAP);
+		assert(gw == fw && gp == fp);
+
+		Graph gMst = g.MinSpanningTree(lbl);
+		Graph fMst = f.MinSpanningTree(lbl);
+
+		assert(gMst.SumOfEdges() == fMst.SumOfEdges() &&
+			   gMst.NumberOfEdges() == fMst.NumberOfEdges());
+
+		for (char d('A'); d <= 'Z'; ++d) {
+
+			assert(gMst.GetEdges(Graph::Label(1, d)) ==
+				   fMst.GetEdges(Graph::Label(1, d)));
+		}
+	}
+}
+
+/*
+* Unit test for FrozenGraph
+*/
+void frozen() {
+
+	Graph g;
+	FrozenGraph empty(g);
+
+	assert(empty.NumberOfVertices() == 0 && empty.NumberOfEdges() == 0 &&
+		   empty.SumOfEdges() == 0);
+
+	assert(empty.MinSpanningTree("A").NumberOfVertices() == 0);
+
+	frozenFile("graph0.txt");
+	frozenFile("graph1.txt");
+	frozenFile("graph2.txt");
+}
+
+/*
+* Helper for Snapshot unit test, saves a Graph and compares every query on
+* the file and on the Graph loaded back from it
+* @param fileName The name of the file to read the Graph from
+*/
+void snapshotFile(const std::string& fileName) {
+
+	Graph g, loaded;
+	Snapshot snapshot;
+	std::ostringstream expected, actual;
+
+	assert(g.ReadFile(fileName) && g.Save("snapshot.bin"));
+	assert(loaded.Load("snapshot.bin") && snapshot.Open("snapshot.bin"));
+
+	expected << g;
+	actual << loaded;
+	assert(actual.str() == expected.str() &&
+		   loaded.NumberOfEdges() == g.NumberOfEdges());
+
+	assert(snapshot.IsOpen() &&
+		   snapshot.NumberOfVertices() == g.NumberOfVertices() &&
+		   snapshot.NumberOfEdges() == g.NumberOfEdges() &&
+		   !snapshot.HasVertex("?") && snapshot.NumberOfEdges("?") == -1 &&
+		   snapshot.GetEdges("?") == "");
+
+	for (char c('A'); c <= 'Z'; ++c) {
+
+		Graph::Label lbl(1, c);
+
+		assert(snapshot.HasVertex(lbl) == g.HasVertex(lbl) &&
+			   snapshot.NumberOfEdges(lbl) == g.NumberOfEdges(lbl) &&
+			   snapshot.GetEdges(lbl) == g.GetEdges(lbl) &&
+			   loaded.GetEdges(lbl) == g.GetEdges(lbl));
+
+		Graph::Label bfs;
+
+		order.clear();
+		g.BFS(lbl, recordVisit);
+		bfs = order;
+		order.clear();
+		snapshot.BFS(lbl, recordVisit);
+		assert(order == bfs);
+
+		Graph::WeightMap gw, lw;
+		Graph::PrevMap gp, lp;
+
+		g.Dijkstra(lbl, gw, gp);
+		loaded.Dijkstra(lbl, lw, lp);
+		assert(gw == lw && gp == lp);
+	}
+
+	snapshot.Close();
+	assert(!snapshot.IsOpen() && snapshot.NumberOfVertices() == 0 &&
+		   snapshot.NumberOfEdges() == 0);
+}
+
+/*
+* Unit test for Snapshot, Graph::Save and Graph::Load
+*/
+void snapshot() {
+
+	snapshotFile("graph0.txt");
+	snapshotFile("graph1.txt");
+	snapshotFile("graph2.txt");
+	snapshotFile("graph3.txt");
+
+	Graph g, empty;
+	Snapshot snapshot;
+
+	assert(empty.Save("snapshot.bin") && g.Load("snapshot.bin") &&
+		   g.NumberOfVertices() == 0 && g.NumberOfEdges() == 0);
+
+	Graph ties, loaded;
+	Graph::WeightMap tw, lw;
+	Graph::PrevMap tp, lp;
+
+	assert(ties.Connect("Z", "B", 1) && ties.Connect("Z", "A", 1) &&
+		   ties.Connect("B", "C", 1) && ties.Connect("A", "C", 1));
+	assert(ties.Save("snapshot.bin") && loaded.Load("snapshot.bin"));
+
+	ties.Dijkstra("Z", tw, tp);
+	loaded.Dijkstra("Z", lw, lp);
+	assert(tp["C"] == "A" && tw == lw && tp == lp);
+	assert(snapshot.Open("snapshot.bin") && snapshot.GetEdges("Z") ==
+		                                    ties.GetEdges("Z"));
+	snapshot.Close();
+
+	assert(g.ReadFile("graph1.txt") && g.Save("snapshot.bin"));
+
+	std::ifstream file("snapshot.bin", std::ios::binary);
+	std::string bytes((std::istreambuf_iterator<char>(file)),
+		              std::istreambuf_iterator<char>());
+	Graph::Label edges = g.GetEdges("A");
+	std::string corrupt(bytes), truncated(bytes.substr(0, bytes.size() - 8)),
+		        magic(bytes);
+
+	file.close();
+
+	corrupt[corrupt.size() - 9] ^= 1;
+	magic[0] = 'X';
+
+	for (const std::string& bad : { corrupt, truncated, magic }) {
+
+		std::ofstream("snapshot.bin", std::ios::binary) << bad;
+
+		assert(!g.Load("snapshot.bin") && !snapshot.Open("snapshot.bin"));
+		assert(!snapshot.IsOpen() && g.GetEdges("A") == edges);
+	}
+
+	std::ofstream("snapshot.bin", std::ios::binary) << corrupt;
+	assert(snapshot.Open("snapshot.bin", false) && snapshot.IsOpen());
+
+	std::remove("snapshot.bin");
+
+	assert(!g.Load("snapshot.bin") && !snapshot.Open("snapshot.bin") &&
+		   g.GetEdges("A") == edges);
+}
+
+/*
+* Helper for writer unit test, checks that an edge list written by Writer
+* reads back into the same Graph
+* @param fileName The name of the file to read
+*/
+void writerFile(const std::string& fileName) {
+
+	Graph g, read;
+	std::ostringstream expected, actual;
+
+	assert(g.ReadFile(fileName) &&
+		   Writer::Save(g, "writer.txt", Writer::Format::EDGES) &&
+		   read.ReadFile("writer.txt"));
+
+	expected << g;
+	actual << read;
+	assert(actual.str() == expected.str() &&
+		   read.NumberOfVertices() == g.NumberOfVertices() &&
+		   read.NumberOfEdges() == g.NumberOfEdges());
+
+	std::remove("writer.txt");
+}
+
+/*
+* Unit test for Writer and operator<<
+*/
+void writer() {
+
+	writerFile("graph0.txt");
+	writerFile("graph1.txt");
+	writerFile("graph2.txt");
+	writerFile("graph3.txt");
+
+	Graph g;
+	std::ostringstream adjacency, edges, dot, json, printed;
+	Writer writer(adjacency);
+
+	g.Connect("B", "A", -12);
+	g.Connect("A", "C", 7);
+	g.Connect("A", "B", 2147483647);
+	g.AddVertex("D");
+
+	assert(writer.Write(g, Writer::Format::ADJACENCY));
+	printed << g;
+	assert(adjacency.str() == "A: B(2147483647),C(7)\nB: A(-12)\nC: \nD: \n" &&
+		   printed.str() == adjacency.str());
+
+	assert(Writer(edges).Write(g, Writer::Format::EDGES) &&
+		   edges.str() == "3\nA B 2147483647\nA C 7\nB A -12\n");
+
+	assert(Writer(dot).Write(g, Writer::Format::DOT) &&
+		   dot.str() == "digraph {\n"
+			            "\t\"A\" -> \"B\" [label=2147483647];\n"
+			            "\t\"A\" -> \"C\" [label=7];\n"
+			            "\t\"B\" -> \"A\" [label=-12];\n"
+			            "\t\"C\";\n\t\"D\";\n}\n");
+
+	assert(Writer(json).Write(g, Writer::Format::JSON) &&
+		   json.str() == "{\n\t\"vertices\": [\n"
+			             "\t\t\"A\",\n\t\t\"B\",\n\t\t\"C\",\n\t\t\"D\"\n\t],\n"
+			             "\t\"edges\": [\n"
+			             "\t\t{\"from\": \"A\", \"to\": \"B\", "
+			             "\"weight\": 2147483647},\n"
+			             "\t\t{\"from\": \"A\", \"to\": \"C\", "
+			             "\"weight\": 7},\n"
+			             "\t\t{\"from\": \"B\", \"to\": \"A\", "
+			             "\"weight\": -12}\n"
+			             "\t]\n}\n");
+
+	std::ostringstream quoted, escaped, spaced;
+	Graph labels;
+
+	labels.Connect("say \"hi\"", "back\\slash\ttab", 1);
+
+	assert(Writer(quoted).Write(labels, Writer::Format::DOT) &&
+		   quoted.str() == "digraph {\n"
+			               "\t\"back\\\\slash\ttab\";\n"
+			               "\t\"say \\\"hi\\\"\" -> "
+			               "\"back\\\\slash\ttab\" [label=1];\n"
+			               "}\n");
+
+	assert(Writer(escaped).Write(labels, Writer::Format::JSON) &&
+		   escaped.str().find("\"from\": \"say \\\"hi\\\"\", "
+			                  "\"to\": \"back\\\\slash\\u0009tab\"") !=
+		   std::string::npos);
+
+	assert(!Writer(spaced).Write(labels, Writer::Format::EDGES) &&
+		   spaced.str().empty());
+
+	Graph empty;
+	std::ostringstream none;
+
+	assert(Writer(none).Write(empty, Writer::Format::JSON) &&
+		   none.str() == "{\n\t\"vertices\": [],\n\t\"edges\": []\n}\n");
+
+	assert(!Writer::Save(g, "missing/writer.txt", Writer::Format::EDGES));
+}
+
+/*
+* Helper for shortest path unit tests, adds pseudo-random Edges between
+* Vertices labelled "0" to "59"
+* @param g The Graph to add Edges to
+* @param weights Pointer to store the weight of every Edge added
+* @param maxWeight The largest Edge weight
+*/
+void randomGraph(Graph* g, std::map<Graph::PrevLabel, Graph::Weight>* weights,
+				 Graph::Weight maxWeight) {
+
+	unsigned seed(static_cast<unsigned>(maxWeight));
+
+	for (int i(0); i < 300; ++i) {
+
+		seed = seed * 1103515245 + 12345;
+
+		Graph::Label from = std::to_string(seed % 60);
+		Graph::Label to = std::to_string(seed / 60 % 60);
+		Graph::Weight w = static_cast<Graph::Weight>(seed / 3600 %
+													 (maxWeight + 1));
+
+		if (g->Connect(from, to, w)) {
+
+			weights->emplace(Graph::PrevLabel(from, to), w);
+		}
+	}
+}
+
+/*
+* Helper for shortest path unit tests, checks a path follows Edges of the
+* Graph between its ends and adds up to its cost
+* @param from The label of the origin Vertex
+* @param to The label of the destination Vertex
+* @param cost The cost of the path
+* @param path The labels on the path
+* @param weights The weight of every Edge in the Graph
+*/
+void checkPath(const Graph::Label& from, const Graph::Label& to,
+			   Graph::Weight cost, const std::vector<Graph::Label>& path,
+			   const std::map<Graph::PrevLabel, Graph::Weight>& weights) {
+
+	assert(!path.empty() && path.front() == from && path.back() == to);
+
+	Graph::Weight sum(0);
+
+	for (std::size_t i(1); i < path.size(); ++i) {
+
+		sum += weights.at(Graph::PrevLabel(path[i - 1], path[i]));
+	}
+
+	assert(sum == cost);
+}
+
+/*
+* Helper for shortest path unit tests, checks costs match the expected
+* costs and that the previous Vertices form a valid shortest path tree
+* @param origin The label of the origin Vertex
+* @param wMap The WeightMap to check
+* @param pMap The PrevMap to check
+* @param expectedW The expected WeightMap
+* @param expectedP The expected PrevMap, only its keys are compared
+* @param weights The weight of every Edge in the Graph
+*/
+void checkPaths(const Graph::Label& origin, Graph::WeightMap wMap,
+				const Graph::PrevMap& pMap, const Graph::WeightMap& expectedW,
+				const Graph::PrevMap& expectedP,
+				const std::map<Graph::PrevLabel, Graph::Weight>& weights) {
+
+	assert(wMap == expectedW && pMap.size() == expectedP.size());
+
+	for (const Graph::PrevMap::value_type& pair : pMap) {
+
+		Graph::Weight prevCost = (pair.second == origin) ? 0 :
+								 wMap[pair.second];
+
+		assert(expectedP.count(pair.first) && prevCost +
+			   weights.at(Graph::PrevLabel(pair.second, pair.first))
+			   == wMap[pair.first]);
+	}
+}
+
+/*
+* Helper for Dijkstra queues unit test, checks every queue and
+* DeltaStepping agree with the binary heap
+* @param g The Graph to search on, labelled "0" to "59"
+* @param weights The weight of every Edge in g
+*/
+void queuesGraph(const Graph& g,
+				 const std::map<Graph::PrevLabel, Graph::Weight>& weights) {
+
+	const FrozenGraph::Queue queues[4] {
+		FrozenGraph::Queue::AUTO, FrozenGraph::Queue::BUCKETS,
+		FrozenGraph::Queue::RADIX_HEAP, FrozenGraph::Queue::ZERO_ONE };
+
+	const Graph::Weight deltas[3] { 0, 1, 50 };
+
+	FrozenGraph f(g);
+	ThreadPool serial(1), parallel(3);
+
+	for (int i(0); i < 60; ++i) {
+
+		Graph::Label origin = std::to_string(i);
+		Graph::WeightMap expectedW;
+		Graph::PrevMap expectedP;
+
+		f.Dijkstra(origin, expectedW, expectedP,
+				   FrozenGraph::Queue::BINARY_HEAP);
+
+		for (const FrozenGraph::Queue& queue : queues) {
+
+			Graph::WeightMap wMap;
+			Graph::PrevMap pMap;
+
+			f.Dijkstra(origin, wMap, pMap, queue);
+
+			checkPaths(origin, wMap, pMap, expectedW, expectedP, weights);
+		}
+
+		for (const Graph::Weight& delta : deltas) {
+
+			Graph::WeightMap wMap1, wMap3;
+			Graph::PrevMap pMap1, pMap3;
+
+			f.DeltaStepping(origin, wMap1, pMap1, serial, delta);
+			f.DeltaStepping(origin, wMap3, pMap3, parallel, delta);
+
+			checkPaths(origin, wMap1, pMap1, expectedW, expectedP, weights);
+			checkPaths(origin, wMap3, pMap3, expectedW, expectedP, weights);
+		}
+	}
+}
+
+/*
+* Unit test for FrozenGraph Dijkstra queues
+*/
+void queues() {
+
+	const Graph::Weight maxWeights[4] { 1, 9, 1000, 100000 };
+
+	for (const Graph::Weight& maxWeight : maxWeights) {
+
+		Graph g;
+		std::map<Graph::PrevLabel, Graph::Weight> weights;
+
+		randomGraph(&g, &weights, maxWeight);
+
+		queuesGraph(g, weights);
+	}
+
+	Graph heavy;
+	Graph::WeightMap wMap;
+	Graph::PrevMap pMap;
+	ThreadPool pool(2);
+
+	assert(heavy.Connect("A", "B", INT_MAX / 4) &&
+		   heavy.Connect("B", "C", 1) && heavy.Connect("A", "C", INT_MAX / 2));
+
+	FrozenGraph(heavy).DeltaStepping("A", wMap, pMap, pool, 1);
+	assert(wMap["B"] == INT_MAX / 4 && wMap["C"] == INT_MAX / 4 + 1 &&
+		   pMap["B"] == "A" && pMap["C"] == "B");
+}
+
+/*
+* Helper for BFS tree unit tests, checks depths against a plain BFS over the
+* Edges of the Graph and that every parent is one level up
+* @param f The FrozenGraph that was searched
+* @param origin The label of the origin Vertex
+* @param depth The depths found
+* @param parent The parents found
+* @param weights The weight of every Edge in the Graph
+*/
+void checkTree(const FrozenGraph& f, const Graph::Label& origin,
+			   const FrozenGraph::DepthList& depth,
+			   const FrozenGraph::IdArray& parent,
+			   const std::map<Graph::PrevLabel, Graph::Weight>& weights) {
+
+	std::map<Graph::Label, int> expected { { origin, 0 } };
+	std::queue<Graph::Label> q;
+
+	q.push(origin);
+
+	while (!q.empty()) {
+
+		for (const std::pair<const Graph::PrevLabel, Graph::Weight>& edge :
+			 weights) {
+
+			if (edge.first.first == q.front() &&
+				expected.emplace(edge.first.second,
+								 expected[q.front()] + 1).second) {
+
+				q.push(edge.first.second);
+			}
+		}
+
+		q.pop();
+	}
+
+	assert(static_cast<int>(depth.size()) == f.NumberOfVertices() &&
+		   parent.size() == depth.size());
+
+	for (FrozenGraph::Id id(0); id < depth.size(); ++id) {
+
+		const Graph::Label& lbl = f.GetLabel(id);
+
+		assert(f.GetId(lbl) == id);
+
+		if (!expected.count(lbl)) {
+
+			assert(depth[id] == FrozenGraph::NO_DEPTH &&
+				   parent[id] == FrozenGraph::NO_ID);
+
+		} else if (lbl == origin) {
+
+			assert(depth[id] == 0 && parent[id] == id);
+
+		} else {
+
+			assert(depth[id] == expected[lbl] &&
+				   depth[parent[id]] == depth[id] - 1 &&
+				   weights.count(Graph::PrevLabel(f.GetLabel(parent[id]), lbl)));
+		}
+	}
+}
+
+/*
+* Unit test for FrozenGraph direction-optimizing BFS
+*/
+void bfsTree() {
+
+	FrozenGraph::DepthList depth;
+	FrozenGraph::IdArray parent;
+
+	for (int edges : { 300, 2000 }) {
+
+		Graph g;
+		std::map<Graph::PrevLabel, Graph::Weight> weights;
+
+		for (int i(0); i < edges; ++i) {
+
+			Graph::Label from = std::to_string(i * 7919 % 60),
+						 to = std::to_string(i * 104729 / 60 % 60);
+
+			if (g.Connect(from, to, 1)) {
+
+				weights.emplace(Graph::PrevLabel(from, to), 1);
+			}
+		}
+
+		FrozenGraph f(g);
+
+		for (int i(0); i < 60; ++i) {
+
+			f.BFS(std::to_string(i), depth, parent);
+			checkTree(f, std::to_string(i), depth, parent, weights);
+		}
+	}
+
+	Graph chain;
+	std::map<Graph::PrevLabel, Graph::Weight> weights;
+
+	for (int i(0); i < 99; ++i) {
+
+		chain.Connect(std::to_string(i), std::to_string(i + 1), 1);
+		weights.emplace(Graph::PrevLabel(std::to_string(i),
+										 std::to_string(i + 1)), 1);
+	}
+
+	FrozenGraph f(chain);
+
+	f.BFS("0", depth, parent);
+	checkTree(f, "0", depth, parent, weights);
+	assert(depth[f.GetId("99")] == 99);
+
+	f.BFS("50", depth, parent);
+	checkTree(f, "50", depth, parent, weights);
+
+	f.BFS("?", depth, parent);
+	assert(depth == FrozenGraph::DepthList(100, FrozenGraph::NO_DEPTH) &&
+		   f.GetId("?") == FrozenGraph::NO_ID);
+}
+
+/*
+* Unit test for FrozenGraph Closeness, Eccentricity and Diameter against
+* one BFS per source
+*/
+void multiSourceBFS() {
+
+	FrozenGraph::DepthList depth, eccentricity;
+	FrozenGraph::IdArray parent;
+	FrozenGraph::ScoreList closeness;
+
+	for (int edges : { 200, 600 }) {
+
+		Graph g;
+		FrozenGraph::Path sources;
+
+		for (int i(0); i < edges; ++i) {
+
+			g.Connect(std::to_string(i * 7919 % 150),
+					  std::to_string(i * 104729 / 150 % 150), 1);
+		}
+
+		for (int i(0); i < 150; ++i) {
+
+			sources.push_back(std::to_string(i * 37 % 150));
+		}
+
+		sources.insert(sources.begin() + 70, { "?", sources[3], "0" });
+
+		FrozenGraph f(g);
+		int diameter(0);
+
+		f.Closeness(sources, closeness);
+		f.Eccentricity(sources, eccentricity);
+		assert(closeness.size() == sources.size() &&
+			   eccentricity.size() == sources.size());
+
+		for (std::size_t i(0); i < sources.size(); ++i) {
+
+			f.BFS(sources[i], depth, parent);
+
+			int reached(0), sum(0), deepest(FrozenGraph::NO_DEPTH);
+
+			for (int d : depth) {
+
+				reached += d != FrozenGraph::NO_DEPTH;
+				sum += std::max(d, 0);
+				deepest = std::max(deepest, d);
+			}
+
+			double expected = (sum == 0) ? 0.0 :
+				              (reached - 1.0) / (f.NumberOfVertices() - 1.0) *
+				              (reached - 1.0) / sum;
+
+			assert(std::abs(closeness[i] - expected) < 1e-12);
+			assert(eccentricity[i] == deepest);
+
+			diameter = std::max(diameter, deepest);
+		}
+
+		assert(f.Diameter() == diameter);
+	}
+
+	Graph chain;
+
+	for (int i(0); i < 99; ++i) {
+
+		chain.Connect(std::to_string(i), std::to_string(i + 1), 1);
+	}
+
+	FrozenGraph f(chain);
+
+	f.Eccentricity({ "0", "50", "99" }, eccentricity);
+	assert((eccentricity == FrozenGraph::DepthList{ 99, 49, 0 }));
+
+	f.Closeness({ "0", "99" }, closeness);
+	assert(std::abs(closeness[0] - 99.0 / 4950) < 1e-12 && closeness[1] == 0);
+	assert(f.Diameter() == 99);
+
+	assert(FrozenGraph(Graph()).Diameter() == 0);
+}
+
+/*
+* Unit test for FrozenGraph ShortestPath
+*/
+void shortestPath() {
+
+	const Graph::Weight maxWeights[3] { 1, 9, 1000 };
+
+	for (const Graph::Weight& maxWeight : maxWeights) {
+
+		Graph g;
+		std::map<Graph::PrevLabel, Graph::Weight> weights;
+
+		randomGraph(&g, &weights, maxWeight);
+
+		FrozenGraph f(g);
+
+		for (int i(0); i < 60; ++i) {
+
+			Graph::Label from = std::to_string(i);
+			Graph::WeightMap wMap;
+			Graph::PrevMap pMap;
+
+			f.Dijkstra(from, wMap, pMap);
+
+			for (int j(0); j < 60; ++j) {
+
+				Graph::Label to = std::to_string(j);
+				FrozenGraph::Path path;
+
+				Graph::Weight cost = f.ShortestPath(from, to, path);
+
+				if (from == to) {
+
+					assert(cost == 0 && path.size() == 1);
+
+				} else if (!pMap.count(to)) {
+
+					assert(cost == INT_MAX && path.empty());
+
+				} else {
+
+					assert(cost == wMap[to]);
+
+					checkPath(from, to, cost, path, weights);
+				}
+			}
+		}
+	}
+
+	Graph g;
+	FrozenGraph::Path path;
+
+	assert(g.ReadFile("graph2.txt"));
+	assert(FrozenGraph(g).ShortestPath("T", "U", path) == 17 &&
+		   path == FrozenGraph::Path({ "T", "O", "Q", "R", "S", "U" }));
+	assert(FrozenGraph(g).ShortestPath("U", "T", path) == INT_MAX &&
+		   path.empty());
+	assert(FrozenGraph(g).ShortestPath("T", "?", path) == INT_MAX);
+}
+
+/*
+* Heuristic for AStar that always estimates 0, whatever the Vertex to
+* estimate from and the destination Vertex
+* @return 0
+*/
+Graph::Weight noEstimate(const Graph::Label&, const Graph::Label&) {
+
+	return 0;
+}
+
+/*
+* Unit test for FrozenGraph AStar
+*/
+void aStar() {
+
+	const Graph::Weight maxWeights[3] { 1, 9, 1000 };
+
+	for (const Graph::Weight& maxWeight : maxWeights) {
+
+		Graph g;
+		std::map<Graph::PrevLabel, Graph::Weight> weights;
+
+		randomGraph(&g, &weights, maxWeight);
+
+		FrozenGraph f(g);
+		Landmarks none(f, 0), some(f, 4), all(f, 100);
+
+		assert(none.Size() == 0 && some.Size() == 4 &&
+			   all.Size() == f.NumberOfVertices());
+
+		for (int i(0); i < 60; ++i) {
+
+			for (int j(0); j < 60; ++j) {
+
+				Graph::Label from = std::to_string(i), to = std::to_string(j);
+				FrozenGraph::Path expected, path;
+
+				Graph::Weight cost = f.ShortestPath(from, to, expected);
+
+				const Landmarks* landmarks[4] { nullptr, &none, &some, &all };
+
+				for (const Landmarks* l : landmarks) {
+
+					assert(((l == nullptr) ? f.AStar(from, to, noEstimate, path) :
+											 f.AStar(from, to, *l, path)) == cost);
+
+					if (cost != INT_MAX) {
+
+						checkPath(from, to, cost, path, weights);
+
+					} else {
+
+						assert(path.empty());
+					}
+				}
+			}
+		}
+	}
+
+	Graph g;
+	int side(8);
+
+	for (int i(0); i < side * side; ++i) {
+
+		if (i % side + 1 < side) {
+
+			g.Connect(std::to_string(i), std::to_string(i + 1), 1 + i % 3);
+			g.Connect(std::to_string(i + 1), std::to_string(i), 1 + i % 5);
+		}
+
+		if (i + side < side * side) {
+
+			g.Connect(std::to_string(i), std::to_string(i + side), 1 + i % 4);
+			g.Connect(std::to_string(i + side), std::to_string(i), 1 + i % 2);
+		}
+	}
+
+	FrozenGraph f(g);
+	FrozenGraph::Path expected, path;
+
+	FrozenGraph::Heuristic manhattan = [side](const Graph::Label& from,
+											  const Graph::Label& to) {
+		int a = std::stoi(from), b = std::stoi(to);
+
+		return std::abs(a / side - b / side) + std::abs(a % side - b % side);
+	};
+
+	for (int i(0); i < side * side; i += 7) {
+
+		for (int j(0); j < side * side; j += 3) {
+
+			Graph::Label from = std::to_string(i), to = std::to_string(j);
+
+			assert(f.AStar(from, to, manhattan, path) ==
+				   f.ShortestPath(from, to, expected));
+		}
+	}
+
+	assert(f.AStar("0", "?", manhattan, path) == INT_MAX && path.empty());
+}
+
+/*
+* Unit test for FrozenGraph Kruskal and Boruvka
+*/
+void spanningForest() {
+
+	const Graph::Weight maxWeights[3] { 1, 9, 1000 };
+
+	for (const Graph::Weight& maxWeight : maxWeights) {
+
+		Graph g;
+		std::map<Graph::PrevLabel, Graph::Weight> weights;
+
+		randomGraph(&g, &weights, maxWeight);
+		g.AddVertex("lonely");
+
+		FrozenGraph f(g);
+		FrozenGraph::EdgeList kruskal, boruvka1, boruvka3;
+		ThreadPool pool1(1), pool3(3);
+
+		Graph::Weight sum = f.Kruskal(kruskal);
+
+		assert(f.Boruvka(boruvka1, pool1) == sum && boruvka1 == kruskal);
+		assert(f.Boruvka(boruvka3, pool3) == sum && boruvka3 == kruskal);
+
+		/* Prim's algorithm on the cheapest undirected Edge between each pair */
+		std::map<Graph::Label, std::map<Graph::Label, Graph::Weight>> cheapest;
+
+		for (const std::pair<const Graph::PrevLabel, Graph::Weight>& edge :
+			 weights) {
+
+			const Graph::Label& a = edge.first.first, & b = edge.first.second;
+
+			if (!cheapest[a].count(b) || edge.second < cheapest[a][b]) {
+
+				cheapest[a][b] = cheapest[b][a] = edge.second;
+			}
+		}
+
+		std::set<Graph::Label> visited { "lonely" };
+		Graph::Weight expected(0);
+		int components(1);
+
+		for (int i(0); i < 60; ++i) {
+
+			if (visited.insert(std::to_string(i)).second) {
+
+				std::set<std::pair<Graph::Weight, Graph::Label>> heap;
+
+				++components;
+
+				for (const auto& next : cheapest[std::to_string(i)]) {
+
+					heap.emplace(next.second, next.first);
+				}
+
+				while (!heap.empty()) {
+
+					std::pair<Graph::Weight, Graph::Label> top = *heap.begin();
+
+					heap.erase(heap.begin());
+
+					if (visited.insert(top.second).second) {
+
+						expected += top.first;
+
+						for (const auto& next : cheapest[top.second]) {
+
+							heap.emplace(next.second, next.first);
+						}
+					}
+				}
+			}
+		}
+
+		assert(sum == expected &&
+			   static_cast<int>(kruskal.size()) ==
+			   f.NumberOfVertices() - components);
+
+		for (const FrozenGraph::Edge& edge : kruskal) {
+
+			assert(weights.at(Graph::PrevLabel(std::get<0>(edge),
+				                               std::get<1>(edge))) ==
+				   std::get<2>(edge));
+		}
+	}
+
+	Graph g;
+	FrozenGraph::EdgeList forest;
+	ThreadPool pool(2);
+
+	assert(FrozenGraph(g).Kruskal(forest) == 0 && forest.empty());
+	assert(FrozenGraph(g).Boruvka(forest, pool) == 0 && forest.empty());
+
+	assert(g.ReadFile("graph1.txt"));
+	assert(FrozenGraph(g).Kruskal(forest) ==
+		   FrozenGraph(g).Boruvka(forest, pool));
+}
+
+/*
+* Unit test for ContractionHierarchy
+*/
+void contractionHierarchy() {
+
+	const Graph::Weight maxWeights[3] { 1, 9, 1000 };
+
+	for (const Graph::Weight& maxWeight : maxWeights) {
+
+		Graph g;
+		std::map<Graph::PrevLabel, Graph::Weight> weights;
+
+		randomGraph(&g, &weights, maxWeight);
+
+		FrozenGraph f(g);
+		ContractionHierarchy ch(f);
+
+		assert(ch.NumberOfShortcuts() >= 0 && ch.MemoryUsage() > 0);
+
+		for (int i(0); i < 60; ++i) {
+
+			for (int j(0); j < 60; ++j) {
+
+				Graph::Label from = std::to_string(i), to = std::to_string(j);
+				FrozenGraph::Path expected, path;
+
+				Graph::Weight cost = f.ShortestPath(from, to, expected);
+
+				assert(ch.ShortestPath(from, to, path) == cost);
+
+				if (cost != INT_MAX) {
+
+					checkPath(from, to, cost, path, weights);
+
+				} else {
+
+					assert(path.empty());
+				}
+			}
+		}
+	}
+
+	Graph g;
+	FrozenGraph::Path path;
+
+	assert(g.ReadFile("graph2.txt"));
+
+	ContractionHierarchy ch((FrozenGraph(g)));
+
+	assert(ch.ShortestPath("T", "U", path) == 17 &&
+		   path == FrozenGraph::Path({ "T", "O", "Q", "R", "S", "U" }));
+	assert(ch.ShortestPath("U", "T", path) == INT_MAX && path.empty());
+	assert(ch.ShortestPath("T", "T", path) == 0 &&
+		   path == FrozenGraph::Path({ "T" }));
+	assert(ch.ShortestPath("T", "?", path) == INT_MAX && path.empty());
 }
 
 /*
@@ -560,12 +2753,32 @@ void runTests() {
 	disconnect();
 	numOfEdges();
 	getEdges();
+	copy();
+	move();
+	copyOnWrite();
+	memoryUsage();
+	threadPool();
 	readFile();
 	DFS();
 	BFS();
+	visitors();
+	ranges();
 	Dijkstra();
+	shortestPathWorkspace();
+	batchedDijkstra();
 	sumOfEdges();
 	MinSpanTree();
+	constTraversals();
+	frozen();
+	snapshot();
+	writer();
+	queues();
+	bfsTree();
+	multiSourceBFS();
+	shortestPath();
+	aStar();
+	spanningForest();
+	contractionHierarchy();
 }
 
 /*
@@ -0,0 +1,885 @@
+/*
+* benchmark.cpp
+*
+* Benchmarks for Graph and FrozenGraph queries on generated graphs
+* Build with optimizations, e.g.
+* g++ -std=c++17 -O2 -pthread benchmark.cpp graph.cpp frozengraph.cpp
+*     landmarks.cpp threadpool.cpp contractionhierarchy.cpp snapshot.cpp \
+*     filereader.cpp writer.cpp -o benchmark
+* Add -DGRAPH_ZLIB -lz to also time reading a gzip file
+* Run as "benchmark [side] [file format]" to also read a DIMACS, SNAP,
+* Matrix Market or METIS file, format is one of dimacs, snap, mtx, metis
+*
+* @author Juan Arias
+*
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include "contractionhierarchy.h"
+#include "graph.h"
+#include "frozengraph.h"
+#include "landmarks.h"
+#include "snapshot.h"
+#include "threadpool.h"
+#include "writer.h"
+
+#ifdef GRAPH_ZLIB
+#include <zlib.h>
+#endif
+
+/* Clock used for all timings */
+using Clock = std::chrono::steady_clock;
+
+/*
+* Gets the milliseconds elapsed since start
+* @param start The time to measure from
+* @return milliseconds elapsed since start
+*/
+double elapsed(const Clock::time_point& start) {
+
+	return std::chrono::duration<double, std::milli>(Clock::now() - start)
+		.count();
+}
+
+/*
+* Gets the rate of reading a number of bytes in some milliseconds
+* @param bytes The number of bytes read
+* @param ms The milliseconds taken
+* @return gigabytes per second
+*/
+double throughput(std::size_t bytes, double ms) {
+
+	return static_cast<double>(bytes) / ms / 1e6;
+}
+
+/*
+* Builds a road-like grid, every cell connects both ways to its right and
+* lower neighbours with a pseudo-random weight in [1, maxWeight]
+* @param g The Graph to add Vertices and Edges to
+* @param side The number of cells on each side of the grid
+* @param maxWeight The largest Edge weight
+*/
+void grid(Graph* g, int side, Graph::Weight maxWeight) {
+
+	unsigned seed(side);
+
+	for (int row(0); row < side; ++row) {
+
+		for (int col(0); col < side; ++col) {
+
+			Graph::Label cell = std::to_string(row * side + col);
+
+			if (col + 1 < side) {
+
+				Graph::Label right = std::to_string(row * side + col + 1);
+
+				seed = seed * 1103515245 + 12345;
+				g->Connect(cell, right, 1 + seed / 65536 % maxWeight);
+				g->Connect(right, cell, 1 + seed / 65536 % maxWeight);
+			}
+
+			if (row + 1 < side) {
+
+				Graph::Label down = std::to_string((row + 1) * side + col);
+
+				seed = seed * 1103515245 + 12345;
+				g->Connect(cell, down, 1 + seed / 65536 % maxWeight);
+				g->Connect(down, cell, 1 + seed / 65536 % maxWeight);
+			}
+		}
+	}
+}
+
+/*
+* Builds a low-diameter graph like a social network, every Vertex connects
+* to degree pseudo-random Vertices, biased towards low labels
+* @param g The Graph to add Vertices and Edges to
+* @param vertices The number of Vertices
+* @param degree The number of Edges from each Vertex
+*/
+void social(Graph* g, int vertices, int degree) {
+
+	unsigned seed(vertices);
+
+	for (int v(0); v < vertices; ++v) {
+
+		for (int d(0); d < degree; ++d) {
+
+			seed = seed * 1103515245 + 12345;
+
+			unsigned a = seed / 65536 % vertices;
+
+			seed = seed * 1103515245 + 12345;
+
+			unsigned b = seed / 65536 % vertices;
+
+			g->Connect(std::to_string(v), std::to_string(std::min(a, b)), 1);
+		}
+	}
+}
+
+/*
+* Visit function that does nothing, to time traversals alone
+*/
+void ignore(const Graph::Label&) {
+}
+
+/*
+* Benchmark for BFS with a Visit function against direction-optimizing BFS
+* @param f The FrozenGraph to search on
+* @param name The name of the graph to print
+*/
+void breadthFirst(const FrozenGraph& f, const std::string& name) {
+
+	Clock::time_point start = Clock::now();
+
+	f.BFS("0", ignore);
+
+	std::cout << name << " BFS: " << elapsed(start) << " ms" << std::endl;
+
+	FrozenGraph::DepthList depth;
+	FrozenGraph::IdArray parent;
+
+	start = Clock::now();
+
+	f.BFS("0", depth, parent);
+
+	std::cout << name << " direction-optimizing BFS: " << elapsed(start)
+		<< " ms" << std::endl;
+}
+
+/*
+* Benchmark for Closeness and Eccentricity from many sources against
+* running Graph::BFS once per source
+* @param g The Graph to search on
+* @param f The FrozenGraph of g
+* @param count The number of pseudo-random sources
+* @param name The name of the Graph
+*/
+void multiSource(const Graph& g, const FrozenGraph& f, int count,
+	             const std::string& name) {
+
+	FrozenGraph::Path sources;
+	unsigned seed(count);
+
+	for (int i(0); i < count; ++i) {
+
+		seed = seed * 1103515245 + 12345;
+		sources.push_back(std::to_string(seed % g.NumberOfVertices()));
+	}
+
+	Clock::time_point start = Clock::now();
+
+	for (const Graph::Label& source : sources) {
+
+		g.BFS(source, ignore);
+	}
+
+	std::cout << name << " Graph::BFS from " << count << " sources: "
+		<< elapsed(start) << " ms" << std::endl;
+
+	FrozenGraph::ScoreList closeness;
+	FrozenGraph::DepthList eccentricity;
+
+	start = Clock::now();
+
+	f.Closeness(sources, closeness);
+
+	std::cout << name << " Closeness (MS-BFS): " << elapsed(start) << " ms"
+		<< std::endl;
+
+	start = Clock::now();
+
+	f.Eccentricity(sources, eccentricity);
+
+	std::cout << name << " Eccentricity (MS-BFS): " << elapsed(start)
+		<< " ms" << std::endl;
+}
+
+/*
+* Benchmark for ReadFile, writes the Edges of a Graph to an edge list file
+* and reads it back on growing ThreadPools, against the extractFile loop
+* ReadFile replaced, which reads each Edge with operator>> and adds it with
+* Connect, so both build the same Graph from the same file
+* @param f The FrozenGraph to write
+* @param fileName The name of the file to write
+*/
+void readFile(const FrozenGraph& f, const std::string& fileName) {
+
+	{
+		std::ofstream file(fileName);
+
+		file << f.NumberOfEdges() << "\n";
+
+		for (int id(0); id < f.NumberOfVertices(); ++id) {
+
+			const Graph::Label& from = f.GetLabel(id);
+			std::string edges = f.GetEdges(from);
+			std::size_t start(0);
+
+			while (start < edges.size()) {
+
+				std::size_t open = edges.find('(', start),
+					        close = edges.find(')', open);
+
+				file << from << " " << edges.substr(start, open - start) << " "
+					<< edges.substr(open + 1, close - open - 1) << "\n";
+
+				start = close + 2;
+			}
+		}
+	}
+
+	std::size_t bytes = static_cast<std::size_t>(
+		std::ifstream(fileName, std::ios::binary | std::ios::ate).tellg());
+
+	Clock::time_point start = Clock::now();
+
+	{
+		std::ifstream file(fileName);
+		Graph g;
+		Graph::Label from, to;
+		Graph::Weight weight;
+		int edges;
+
+		file >> edges;
+
+		for (int i(0); i < edges && file >> from >> to >> weight; ++i) {
+
+			g.Connect(from, to, weight);
+		}
+
+		double ms = elapsed(start);
+
+		std::cout << "extractFile " << g.NumberOfEdges() << " edges, "
+			<< bytes / 1024 << " KiB: " << ms << " ms, "
+			<< throughput(bytes, ms) << " GB/s" << std::endl;
+	}
+
+	int hardware = static_cast<int>(std::thread::hardware_concurrency());
+
+	for (int threads(1); threads <= std::max(hardware, 1); threads *= 2) {
+
+		ThreadPool pool(threads);
+		Graph g;
+		std::string error;
+
+		start = Clock::now();
+
+		g.ReadFile(fileName, error, pool);
+
+		double ms = elapsed(start);
+
+		std::cout << "ReadFile " << g.NumberOfEdges() << " edges, "
+			<< threads << " threads: " << ms << " ms, "
+			<< throughput(bytes, ms) << " GB/s" << std::endl;
+	}
+
+#ifdef GRAPH_ZLIB
+	{
+		std::ifstream plain(fileName, std::ios::binary);
+		std::string text((std::istreambuf_iterator<char>(plain)),
+			             std::istreambuf_iterator<char>());
+		gzFile gz = gzopen((fileName + ".gz").c_str(), "wb");
+
+		gzwrite(gz, text.data(), static_cast<unsigned>(text.size()));
+		gzclose(gz);
+	}
+
+	for (int threads(1); threads <= std::max(hardware, 1); threads *= 2) {
+
+		ThreadPool pool(threads);
+		Graph g;
+		std::string error;
+
+		start = Clock::now();
+
+		g.ReadFile(fileName + ".gz", error, pool);
+
+		std::cout << "ReadFile gzip " << g.NumberOfEdges() << " edges, "
+			<< threads << " threads: " << elapsed(start) << " ms" << std::endl;
+	}
+
+	std::remove((fileName + ".gz").c_str());
+#endif
+
+	std::remove(fileName.c_str());
+}
+
+/*
+* Benchmark for saving and loading a binary Snapshot, compare with ReadFile
+* @param g The Graph to save
+* @param fileName The name of the file to write
+*/
+void snapshot(const Graph& g, const std::string& fileName) {
+
+	Clock::time_point start = Clock::now();
+
+	g.Save(fileName);
+
+	std::cout << "Save: " << elapsed(start) << " ms" << std::endl;
+
+	Graph loaded;
+
+	start = Clock::now();
+
+	loaded.Load(fileName);
+
+	std::cout << "Load " << loaded.NumberOfEdges() << " edges: "
+		<< elapsed(start) << " ms" << std::endl;
+
+	for (bool verify : { true, false }) {
+
+		Snapshot snapshot;
+
+		start = Clock::now();
+
+		snapshot.Open(fileName, verify);
+
+		std::cout << "Snapshot open" << (verify ? " verified " : " ")
+			<< snapshot.NumberOfEdges() << " edges: " << elapsed(start) << " ms"
+			<< std::endl;
+	}
+
+	std::remove(fileName.c_str());
+}
+
+/*
+* Benchmark for passing a Graph between stages, as a deep copy, a
+* copy-on-write copy that then changes a few Vertices, and a move
+* @param g The Graph to copy
+*/
+void copies(const Graph& g) {
+
+	Clock::time_point start = Clock::now();
+
+	Graph deep(g);
+
+	std::cout << "Copy: " << elapsed(start) << " ms, "
+		<< deep.MemoryUsage() / 1024 << " KiB" << std::endl;
+
+	deep.SetCopyOnWrite(true);
+	start = Clock::now();
+
+	Graph shared(deep);
+
+	std::cout << "Copy-on-write copy: " << elapsed(start) << " ms, "
+		<< shared.MemoryUsage() / 1024 << " KiB" << std::endl;
+
+	start = Clock::now();
+
+	for (int i(0); i < 1000; ++i) {
+
+		shared.Connect(std::to_string(i * 37), std::to_string(i * 91), i);
+	}
+
+	std::cout << "Copy-on-write 1000 Connects: " << elapsed(start) << " ms, "
+		<< shared.MemoryUsage() / 1024 << " KiB" << std::endl;
+
+	start = Clock::now();
+
+	Graph moved(std::move(shared));
+
+	std::cout << "Move " << moved.NumberOfEdges() << " edges: "
+		<< elapsed(start) << " ms" << std::endl;
+}
+
+/*
+* Benchmark for exporting a Graph with a Writer in every format, against
+* printing a line per Vertex from GetEdges with std::endl
+* @param g The Graph to write
+* @param f The FrozenGraph of g, for the labels of its Vertices
+* @param fileName The name of the file to write
+*/
+void write(const Graph& g, const FrozenGraph& f, const std::string& fileName) {
+
+	Clock::time_point start = Clock::now();
+
+	{
+		std::ofstream file(fileName);
+
+		for (int id(0); id < f.NumberOfVertices(); ++id) {
+
+			const Graph::Label& lbl = f.GetLabel(id);
+
+			file << lbl << ": " << g.GetEdges(lbl) << std::endl;
+		}
+	}
+
+	std::cout << "GetEdges with std::endl: " << elapsed(start) << " ms"
+		<< std::endl;
+
+	const std::pair<Writer::Format, const char*> formats[] = {
+		{ Writer::Format::ADJACENCY, "adjacency" },
+		{ Writer::Format::EDGES, "edge list" },
+		{ Writer::Format::DOT, "DOT" },
+		{ Writer::Format::JSON, "JSON" }
+	};
+
+	for (const std::pair<Writer::Format, const char*>& format : formats) {
+
+		start = Clock::now();
+
+		Writer::Save(g, fileName, format.first);
+
+		double ms = elapsed(start);
+		std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+		double megabytes = static_cast<double>(file.tellg()) / (1 << 20);
+
+		std::cout << "Writer " << format.second << " " << megabytes << " MB: "
+			<< ms << " ms, " << megabytes * 1000 / ms << " MB/s" << std::endl;
+	}
+
+	std::remove(fileName.c_str());
+}
+
+/*
+* Benchmark for ReadBatch against parsing and applying one record at a time
+* with Connect and Disconnect, on records skewed towards a few Vertices
+* @param records The number of records, one in four disconnects
+*/
+void stream(int records) {
+
+	std::ostringstream text;
+	unsigned seed(records);
+
+	for (int i(0); i < records; ++i) {
+
+		seed = seed * 1103515245 + 12345;
+
+		int from = (seed >> 8) % 1000,
+			to = (seed >> 4) % 50000;
+
+		from = (i % 2) ? from % 20 : from;
+		if (seed % 4 == 0) {
+
+			text << "- " << from << " " << to << "\n";
+
+		} else {
+
+			text << from << " " << to << " " << seed % 100 << "\n";
+		}
+	}
+
+	std::istringstream in(text.str());
+	Graph::Label first, from, to;
+	Graph::Weight weight;
+	Graph g;
+
+	Clock::time_point start = Clock::now();
+
+	while (in >> first) {
+
+		if (first == "-") {
+
+			in >> from >> to;
+			g.Disconnect(from, to);
+
+		} else {
+
+			in >> to >> weight;
+			g.Connect(first, to, weight);
+		}
+	}
+
+	std::cout << "Connect " << g.NumberOfEdges() << " edges: "
+		<< elapsed(start) << " ms" << std::endl;
+
+	for (std::size_t batch : { 256, 4096, 65536 }) {
+
+		std::istringstream batches(text.str());
+		Graph::EdgeStream edges(batches, "benchmark");
+		Graph b;
+
+		start = Clock::now();
+
+		while (b.ReadBatch(edges, batch) > 0) {}
+
+		std::cout << "ReadBatch " << b.NumberOfEdges() << " edges, batches of "
+			<< batch << ": " << elapsed(start) << " ms" << std::endl;
+	}
+}
+
+/*
+* Benchmark for DeltaStepping against sequential Dijkstra
+* @param f The FrozenGraph to search on
+* @param origin The label of the origin Vertex
+*/
+void deltaStepping(const FrozenGraph& f, const Graph::Label& origin) {
+
+	Graph::WeightMap wMap;
+	Graph::PrevMap pMap;
+
+	Clock::time_point start = Clock::now();
+
+	f.Dijkstra(origin, wMap, pMap, FrozenGraph::Queue::BINARY_HEAP);
+
+	double sequential = elapsed(start);
+
+	std::cout << "Dijkstra (binary heap): " << sequential << " ms" << std::endl;
+
+	int hardware = static_cast<int>(std::thread::hardware_concurrency());
+
+	for (int threads(1); threads <= std::max(hardware, 1); threads *= 2) {
+
+		ThreadPool pool(threads);
+
+		wMap.clear();
+		pMap.clear();
+
+		start = Clock::now();
+
+		f.DeltaStepping(origin, wMap, pMap, pool);
+
+		double parallel = elapsed(start);
+
+		std::cout << "DeltaStepping, " << threads << " threads: " << parallel
+			<< " ms, speedup " << sequential / parallel << std::endl;
+	}
+}
+
+/*
+* Benchmark for Graph Dijkstra into maps against a reused
+* ShortestPathWorkspace
+* @param g The Graph to search on
+* @param queries The number of pseudo-random origins to search from
+*/
+void workspace(const Graph& g, int queries) {
+
+	std::vector<Graph::Label> from;
+	unsigned seed(queries);
+
+	for (int i(0); i < queries; ++i) {
+
+		seed = seed * 1103515245 + 12345;
+		from.push_back(std::to_string(seed % g.NumberOfVertices()));
+	}
+
+	Clock::time_point start = Clock::now();
+
+	for (int i(0); i < queries; ++i) {
+
+		Graph::WeightMap wMap;
+		Graph::PrevMap pMap;
+
+		g.Dijkstra(from[i], wMap, pMap);
+	}
+
+	std::cout << "Graph Dijkstra into maps: " << elapsed(start) / queries
+		<< " ms/query" << std::endl;
+
+	Graph::ShortestPathWorkspace workspace;
+
+	start = Clock::now();
+
+	for (int i(0); i < queries; ++i) {
+
+		g.Dijkstra(from[i], workspace);
+	}
+
+	std::cout << "Graph Dijkstra into workspace: " << elapsed(start) / queries
+		<< " ms/query" << std::endl;
+}
+
+/*
+* Benchmark for distance tables, a serial loop of Dijkstra into maps
+* against DistanceTable on growing ThreadPools
+* @param g The Graph to search on
+* @param sources The number of pseudo-random sources
+*/
+void distanceTable(const Graph& g, int sources) {
+
+	Graph::LabelList from, to;
+	unsigned seed(sources);
+
+	for (int i(0); i < sources; ++i) {
+
+		seed = seed * 1103515245 + 12345;
+		from.push_back(std::to_string(seed % g.NumberOfVertices()));
+
+		seed = seed * 1103515245 + 12345;
+		to.push_back(std::to_string(seed % g.NumberOfVertices()));
+	}
+
+	Clock::time_point start = Clock::now();
+
+	for (int i(0); i < sources; ++i) {
+
+		Graph::WeightMap wMap;
+		Graph::PrevMap pMap;
+
+		g.Dijkstra(from[i], wMap, pMap);
+	}
+
+	double serial = elapsed(start);
+
+	std::cout << "Distance table " << sources << "x" << sources
+		<< ", serial Dijkstra into maps: " << serial << " ms" << std::endl;
+
+	int hardware = static_cast<int>(std::thread::hardware_concurrency());
+
+	for (int threads(1); threads <= std::max(hardware, 1); threads *= 2) {
+
+		ThreadPool pool(threads);
+		Graph::WeightTable table;
+
+		start = Clock::now();
+
+		g.DistanceTable(from, to, table, pool);
+
+		double parallel = elapsed(start);
+
+		std::cout << "DistanceTable, " << threads << " threads: " << parallel
+			<< " ms, speedup " << serial / parallel << std::endl;
+	}
+}
+
+/*
+* Benchmark for point-to-point queries, full Dijkstra against
+* bidirectional ShortestPath, AStar with Landmarks and ContractionHierarchy
+* @param f The FrozenGraph to search on
+* @param queries The number of pseudo-random pairs to query
+*/
+void pointToPoint(const FrozenGraph& f, int queries) {
+
+	std::vector<Graph::Label> from, to;
+	unsigned seed(queries);
+
+	for (int i(0); i < queries; ++i) {
+
+		seed = seed * 1103515245 + 12345;
+		from.push_back(std::to_string(seed % f.NumberOfVertices()));
+
+		seed = seed * 1103515245 + 12345;
+		to.push_back(std::to_string(seed % f.NumberOfVertices()));
+	}
+
+	Clock::time_point start = Clock::now();
+
+	for (int i(0); i < queries; ++i) {
+
+		Graph::WeightMap wMap;
+		Graph::PrevMap pMap;
+
+		f.Dijkstra(from[i], wMap, pMap);
+	}
+
+	std::cout << "Dijkstra to all: " << elapsed(start) / queries
+		<< " ms/query" << std::endl;
+
+	FrozenGraph::Path path;
+
+	start = Clock::now();
+
+	for (int i(0); i < queries; ++i) {
+
+		f.ShortestPath(from[i], to[i], path);
+	}
+
+	std::cout << "ShortestPath: " << elapsed(start) / queries
+		<< " ms/query" << std::endl;
+
+	start = Clock::now();
+
+	Landmarks landmarks(f, 8);
+
+	std::cout << "Landmarks(8): " << elapsed(start) << " ms" << std::endl;
+
+	start = Clock::now();
+
+	for (int i(0); i < queries; ++i) {
+
+		f.AStar(from[i], to[i], landmarks, path);
+	}
+
+	std::cout << "AStar with Landmarks: " << elapsed(start) / queries
+		<< " ms/query" << std::endl;
+
+	start = Clock::now();
+
+	ContractionHierarchy ch(f);
+
+	std::cout << "ContractionHierarchy: " << elapsed(start) << " ms, "
+		<< ch.NumberOfShortcuts() << " shortcuts, "
+		<< ch.MemoryUsage() / 1024 << " KiB" << std::endl;
+
+	start = Clock::now();
+
+	for (int i(0); i < queries; ++i) {
+
+		ch.ShortestPath(from[i], to[i], path);
+	}
+
+	std::cout << "ContractionHierarchy ShortestPath: "
+		<< elapsed(start) / queries << " ms/query" << std::endl;
+}
+
+/*
+* Benchmark for minimum spanning trees, Prim's algorithm on Graph and
+* FrozenGraph against Kruskal and Boruvka
+* @param g The Graph to search on
+* @param f The FrozenGraph of g
+*/
+void spanningForest(Graph* g, const FrozenGraph& f) {
+
+	Clock::time_point start = Clock::now();
+
+	Graph mst = g->MinSpanningTree("0");
+
+	std::cout << "Graph MinSpanningTree: " << elapsed(start) << " ms"
+		<< std::endl;
+
+	start = Clock::now();
+
+	mst = f.MinSpanningTree("0");
+
+	std::cout << "FrozenGraph MinSpanningTree: " << elapsed(start) << " ms"
+		<< std::endl;
+
+	FrozenGraph::EdgeList forest;
+
+	start = Clock::now();
+
+	f.Kruskal(forest);
+
+	std::cout << "Kruskal: " << elapsed(start) << " ms" << std::endl;
+
+	int hardware = static_cast<int>(std::thread::hardware_concurrency());
+
+	for (int threads(1); threads <= std::max(hardware, 1); threads *= 2) {
+
+		ThreadPool pool(threads);
+
+		start = Clock::now();
+
+		f.Boruvka(forest, pool);
+
+		std::cout << "Boruvka, " << threads << " threads: " << elapsed(start)
+			<< " ms" << std::endl;
+	}
+}
+
+/*
+* Benchmark for reading a public graph file and searching it
+* @param fileName The name of the file
+* @param name The name of the format, one of dimacs, snap, mtx, metis
+*/
+void publicGraph(const std::string& fileName, const std::string& name) {
+
+	Graph::Format format = (name == "dimacs") ? Graph::Format::DIMACS :
+		                   (name == "snap") ? Graph::Format::SNAP :
+		                   (name == "mtx") ? Graph::Format::MATRIX_MARKET :
+		                                     Graph::Format::METIS;
+	int hardware = static_cast<int>(std::thread::hardware_concurrency());
+	Graph g;
+
+	for (int threads(1); threads <= std::max(hardware, 1); threads *= 2) {
+
+		ThreadPool pool(threads);
+		std::string error;
+
+		Clock::time_point start = Clock::now();
+
+		if (!g.ReadFile(fileName, format, error, pool)) {
+
+			std::cout << error << std::endl;
+
+			return;
+		}
+
+		std::cout << "ReadFile " << name << " " << g.NumberOfVertices()
+			<< " vertices, " << g.NumberOfEdges() << " edges, " << threads
+			<< " threads: " << elapsed(start) << " ms" << std::endl;
+	}
+
+	if (g.NumberOfVertices() == 0) {
+
+		return;
+	}
+
+	FrozenGraph f(g);
+
+	Clock::time_point start = Clock::now();
+
+	f.BFS(f.GetLabel(0), ignore);
+
+	std::cout << name << " BFS: " << elapsed(start) << " ms" << std::endl;
+
+	deltaStepping(f, f.GetLabel(0));
+}
+
+/*
+* Runs all benchmarks
+* @param argc The number of arguments
+* @param argv The arguments, optionally the side of the generated grid
+* @return 0 on success
+*/
+int main(int argc, char* argv[]) {
+
+	int side = (argc > 1) ? std::stoi(argv[1]) : 300;
+
+	Graph g;
+
+	Clock::time_point start = Clock::now();
+
+	grid(&g, side, 100);
+
+	std::cout << "Grid " << side << "x" << side << ": "
+		<< g.NumberOfVertices() << " vertices, " << g.NumberOfEdges()
+		<< " edges, built in " << elapsed(start) << " ms" << std::endl;
+
+	std::cout << "Grid adjacency lists: " << g.MemoryUsage() / 1024 << " KiB"
+		<< std::endl;
+
+	start = Clock::now();
+
+	FrozenGraph f(g);
+
+	std::cout << "Freeze: " << elapsed(start) << " ms" << std::endl;
+
+	readFile(f, "benchmark.txt");
+	snapshot(g, "benchmark.bin");
+	write(g, f, "benchmark.out");
+	copies(g);
+	stream(side * side);
+
+	breadthFirst(f, "Grid");
+	multiSource(g, f, 256, "Grid");
+	deltaStepping(f, "0");
+	workspace(g, 20);
+	distanceTable(g, 32);
+	pointToPoint(f, 100);
+	spanningForest(&g, f);
+
+	Graph s;
+
+	start = Clock::now();
+
+	social(&s, side * side, 10);
+
+	std::cout << "Social: " << s.NumberOfVertices() << " vertices, "
+		<< s.NumberOfEdges() << " edges, built in " << elapsed(start) << " ms"
+		<< std::endl;
+
+	std::cout << "Social adjacency lists: " << s.MemoryUsage() / 1024 << " KiB"
+		<< std::endl;
+
+	FrozenGraph social(s);
+
+	breadthFirst(social, "Social");
+	multiSource(s, social, 256, "Social");
+
+	if (argc > 3) {
+
+		publicGraph(argv[2], argv[3]);
+	}
+
+	return 0;
+}
@@ -0,0 +1,582 @@
+/*
+* contractionhierarchy.cpp
+*
+* Implementations for ContractionHierarchy class
+*
+* @author Juan Arias
+*
+*/
+
+#include <algorithm>
+#include <functional>
+#include "contractionhierarchy.h"
+
+/* Constant definition */
+const int ContractionHierarchy::WITNESS_LIMIT(100);
+
+/*
+* Contracts every Vertex of a FrozenGraph
+* Vertices are ordered by edge difference (shortcuts added minus Edges
+* removed) plus the number of neighbours already contracted, priorities are
+* recomputed lazily when a Vertex reaches the top of the heap
+* A contracted Vertex is detached from its neighbours, so the Arcs it keeps
+* are exactly its Edges to and from more important Vertices
+* @param graph The FrozenGraph to preprocess
+*/
+ContractionHierarchy::ContractionHierarchy(const FrozenGraph& graph)
+
+	:labels(graph.labels), rank(graph.labels.size(), Graph::EMPTY),
+	shortcuts(Graph::EMPTY) {
+
+	using Entry = std::pair<long long, Id>;
+
+	std::size_t vertices = this->labels.size();
+
+	std::vector<ArcList> out(vertices), in(vertices);
+	std::vector<bool> contracted(vertices, false);
+	std::vector<long long> priority(vertices);
+	std::vector<int> removed(vertices, Graph::EMPTY);
+	WeightList dist(vertices);
+	IdList stamp(vertices, Graph::EMPTY);
+	Id search(Graph::EMPTY);
+
+	for (Id id(0); id < vertices; ++id) {
+
+		for (Id e(graph.offsets[id]); e < graph.offsets[id + 1]; ++e) {
+
+			out[id].push_back({ graph.targets[e], graph.weights[e],
+				                FrozenGraph::NO_ID });
+			in[graph.targets[e]].push_back({ id, graph.weights[e],
+				                             FrozenGraph::NO_ID });
+		}
+	}
+
+	std::function<long long(const Id&)> importance = [&](const Id& id) {
+
+		long long degree = out[id].size() + in[id].size();
+
+		return this->contract(id, &out, &in, contracted, &dist, &stamp,
+			                  &search, true) - degree + removed[id];
+	};
+
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+	for (Id id(0); id < vertices; ++id) {
+
+		priority[id] = importance(id);
+
+		heap.emplace(priority[id], id);
+	}
+
+	Id order(0);
+
+	while (!heap.empty()) {
+
+		Id id = heap.top().second;
+		long long key = heap.top().first;
+
+		heap.pop();
+
+		if (contracted[id] || key != priority[id]) {
+
+			continue;
+		}
+
+		priority[id] = importance(id);
+
+		if (!heap.empty() && priority[id] > heap.top().first) {
+
+			heap.emplace(priority[id], id);
+
+			continue;
+		}
+
+		this->contract(id, &out, &in, contracted, &dist, &stamp, &search,
+			           false);
+
+		contracted[id] = true;
+		this->rank[id] = order++;
+
+		for (const Arc& arc : out[id]) {
+
+			++removed[arc.end];
+			this->detach(id, &in[arc.end]);
+		}
+
+		for (const Arc& arc : in[id]) {
+
+			++removed[arc.end];
+			this->detach(id, &out[arc.end]);
+		}
+	}
+
+	std::size_t arcs(0);
+
+	for (Id id(0); id < vertices; ++id) {
+
+		arcs += out[id].size();
+	}
+
+	this->upOffsets.assign(Graph::COUNT, 0);
+	this->downOffsets.assign(Graph::COUNT, 0);
+	this->upOffsets.reserve(vertices + Graph::COUNT);
+	this->downOffsets.reserve(vertices + Graph::COUNT);
+	this->upTargets.reserve(arcs);
+	this->upWeights.reserve(arcs);
+	this->upMiddles.reserve(arcs);
+	this->downSources.reserve(arcs);
+	this->downWeights.reserve(arcs);
+	this->downMiddles.reserve(arcs);
+
+	for (Id id(0); id < vertices; ++id) {
+
+		for (const Arc& arc : out[id]) {
+
+			this->upTargets.push_back(arc.end);
+			this->upWeights.push_back(arc.weight);
+			this->upMiddles.push_back(arc.middle);
+			this->shortcuts += (arc.middle != FrozenGraph::NO_ID);
+		}
+
+		for (const Arc& arc : in[id]) {
+
+			this->downSources.push_back(arc.end);
+			this->downWeights.push_back(arc.weight);
+			this->downMiddles.push_back(arc.middle);
+		}
+
+		this->upOffsets.push_back(static_cast<Id>(this->upTargets.size()));
+		this->downOffsets.push_back(static_cast<Id>(this->downSources.size()));
+	}
+}
+
+/*
+* Shortest path between two Vertices
+* Both searches only follow Edges to more important Vertices, each one stops
+* once its closest unsettled Vertex costs at least the best path found
+* @param from The label of the origin Vertex
+* @param to The label of the destination Vertex
+* @param path The Path to fill with labels from origin to destination,
+* empty if there is no path
+* @return cost of the shortest path, INT_MAX if there is no path
+*/
+ContractionHierarchy::Weight ContractionHierarchy::ShortestPath(
+	const Label& from, const Label& to, Path& path) const {
+
+	using Entry = std::pair<Weight, Id>;
+	using Heap  = std::priority_queue<Entry, std::vector<Entry>,
+		                              std::greater<Entry>>;
+
+	Id origin = this->find(from),
+	   destination = this->find(to);
+
+	path.clear();
+
+	if (origin == FrozenGraph::NO_ID || destination == FrozenGraph::NO_ID) {
+
+		return INT_MAX;
+	}
+
+	WeightList distF(this->labels.size(), INT_MAX),
+		       distB(this->labels.size(), INT_MAX);
+	IdList prevF(this->labels.size(), FrozenGraph::NO_ID),
+		   nextB(this->labels.size(), FrozenGraph::NO_ID);
+	Heap heapF, heapB;
+
+	long long best = INT_MAX;
+	Id meet = FrozenGraph::NO_ID;
+
+	distF[origin] = Graph::NO_WEIGHT;
+	distB[destination] = Graph::NO_WEIGHT;
+	heapF.emplace(Graph::NO_WEIGHT, origin);
+	heapB.emplace(Graph::NO_WEIGHT, destination);
+
+	while (!heapF.empty() || !heapB.empty()) {
+
+		bool forward = !heapF.empty() &&
+			           (heapB.empty() || heapF.top().first <= heapB.top().first);
+
+		Heap& heap = (forward) ? heapF : heapB;
+		WeightList& dist = (forward) ? distF : distB;
+		WeightList& other = (forward) ? distB : distF;
+		IdList& links = (forward) ? prevF : nextB;
+		const IdList& offsets = (forward) ? this->upOffsets : this->downOffsets;
+		const IdList& ends = (forward) ? this->upTargets : this->downSources;
+		const WeightList& weights = (forward) ? this->upWeights :
+			                                    this->downWeights;
+
+		if (heap.top().first >= best) {
+
+			heap = Heap();
+
+			continue;
+		}
+
+		Id curr = heap.top().second;
+		Weight d = heap.top().first;
+
+		heap.pop();
+
+		if (d != dist[curr]) {
+
+			continue;
+		}
+
+		if (other[curr] != INT_MAX &&
+			static_cast<long long>(d) + other[curr] < best) {
+
+			best = static_cast<long long>(d) + other[curr];
+			meet = curr;
+		}
+
+		for (Id e(offsets[curr]); e < offsets[curr + 1]; ++e) {
+
+			Id end = ends[e];
+			Weight weight = d + weights[e];
+
+			if (weight < dist[end]) {
+
+				dist[end] = weight;
+				links[end] = curr;
+
+				heap.emplace(weight, end);
+			}
+		}
+	}
+
+	if (meet != FrozenGraph::NO_ID) {
+
+		IdList ids;
+
+		for (Id id(meet); id != FrozenGraph::NO_ID; id = prevF[id]) {
+
+			ids.push_back(id);
+		}
+
+		std::reverse(ids.begin(), ids.end());
+
+		for (Id id(nextB[meet]); id != FrozenGraph::NO_ID; id = nextB[id]) {
+
+			ids.push_back(id);
+		}
+
+		path.push_back(this->labels[origin]);
+
+		for (std::size_t i(1); i < ids.size(); ++i) {
+
+			this->unpack(ids[i - 1], ids[i], &path);
+		}
+	}
+
+	return (best < INT_MAX) ? static_cast<Weight>(best) : INT_MAX;
+}
+
+/*
+* Get the number of shortcut Edges added by contraction
+* @return number of shortcut Edges
+*/
+int ContractionHierarchy::NumberOfShortcuts() const {
+
+	return this->shortcuts;
+}
+
+/*
+* Get the memory used by the hierarchy arrays
+* @return number of bytes used
+*/
+std::size_t ContractionHierarchy::MemoryUsage() const {
+
+	std::size_t bytes = this->labels.capacity() * sizeof(Label);
+
+	for (const Label& label : this->labels) {
+
+		bytes += (label.capacity() > sizeof(Label)) ? label.capacity() : 0;
+	}
+
+	for (const IdList* ids : { &this->rank, &this->upOffsets, &this->upTargets,
+		                       &this->upMiddles, &this->downOffsets,
+		                       &this->downSources, &this->downMiddles }) {
+
+		bytes += ids->capacity() * sizeof(Id);
+	}
+
+	return bytes + (this->upWeights.capacity() +
+		            this->downWeights.capacity()) * sizeof(Weight);
+}
+
+/*
+* Helper for constructor, contracts a Vertex or counts its shortcuts
+* A shortcut from u to x is needed for every remaining Edge u to id and
+* id to x unless a witness search from u finds a path to x that avoids id
+* and costs no more
+* @param id The id of the Vertex to contract
+* @param out The outgoing Arcs of every Vertex
+* @param in The incoming Arcs of every Vertex
+* @param contracted The contracted marks indexed by id
+* @param dist The witness search distances
+* @param stamp The witness search each distance belongs to
+* @param search Pointer to the number of the last witness search
+* @param simulate True to only count the shortcuts
+* @return number of shortcuts needed
+*/
+int ContractionHierarchy::contract(const Id& id, std::vector<ArcList>* out,
+	                               std::vector<ArcList>* in,
+	                               const std::vector<bool>& contracted,
+	                               WeightList* dist, IdList* stamp,
+	                               Id* search, bool simulate) {
+
+	ArcList sources, targets;
+
+	for (const Arc& arc : (*in)[id]) {
+
+		if (!contracted[arc.end]) {
+
+			sources.push_back(arc);
+		}
+	}
+
+	for (const Arc& arc : (*out)[id]) {
+
+		if (!contracted[arc.end]) {
+
+			targets.push_back(arc);
+		}
+	}
+
+	if (sources.empty() || targets.empty()) {
+
+		return Graph::EMPTY;
+	}
+
+	Weight longest = Graph::NO_WEIGHT;
+
+	for (const Arc& arc : targets) {
+
+		longest = std::max(longest, arc.weight);
+	}
+
+	int count(Graph::EMPTY);
+
+	for (const Arc& source : sources) {
+
+		this->witness(source.end, id, source.weight + longest, *out,
+			          contracted, dist, stamp, ++*search);
+
+		for (const Arc& target : targets) {
+
+			Weight weight = source.weight + target.weight;
+
+			if (target.end != source.end &&
+				((*stamp)[target.end] != *search ||
+				 (*dist)[target.end] > weight)) {
+
+				++count;
+
+				if (!simulate) {
+
+					this->addArc(source.end, target.end, weight, id, out, in);
+				}
+			}
+		}
+	}
+
+	return count;
+}
+
+/*
+* Helper for contract, Dijkstra search that ignores one Vertex and all
+* contracted Vertices, stops past a cost or after WITNESS_LIMIT Vertices
+* @param from The id of the origin Vertex
+* @param skip The id of the Vertex to ignore
+* @param limit The largest cost of interest
+* @param out The outgoing Arcs of every Vertex
+* @param contracted The contracted marks indexed by id
+* @param dist The distances indexed by id, only valid where stamp matches
+* @param stamp The search each distance belongs to
+* @param search The number of this search
+*/
+void ContractionHierarchy::witness(const Id& from, const Id& skip,
+	                               const Weight& limit,
+	                               const std::vector<ArcList>& out,
+	                               const std::vector<bool>& contracted,
+	                               WeightList* dist, IdList* stamp,
+	                               const Id& search) const {
+
+	using Entry = std::pair<Weight, Id>;
+
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+	(*dist)[from] = Graph::NO_WEIGHT;
+	(*stamp)[from] = search;
+
+	heap.emplace(Graph::NO_WEIGHT, from);
+
+	int settled(Graph::EMPTY);
+
+	while (!heap.empty() && settled < ContractionHierarchy::WITNESS_LIMIT) {
+
+		Id curr = heap.top().second;
+		Weight d = heap.top().first;
+
+		heap.pop();
+
+		if (d != (*dist)[curr]) {
+
+			continue;
+		}
+
+		if (d > limit) {
+
+			break;
+		}
+
+		++settled;
+
+		for (const Arc& arc : out[curr]) {
+
+			if (arc.end == skip || contracted[arc.end]) {
+
+				continue;
+			}
+
+			Weight weight = d + arc.weight;
+
+			if ((*stamp)[arc.end] != search || weight < (*dist)[arc.end]) {
+
+				(*dist)[arc.end] = weight;
+				(*stamp)[arc.end] = search;
+
+				heap.emplace(weight, arc.end);
+			}
+		}
+	}
+}
+
+/*
+* Helper for contract, adds an Arc or lowers the weight of an existing one
+* @param from The id of the starting Vertex
+* @param to The id of the ending Vertex
+* @param weight The weight of the Arc
+* @param middle The id of the Vertex the Arc skips
+* @param out The outgoing Arcs of every Vertex
+* @param in The incoming Arcs of every Vertex
+*/
+void ContractionHierarchy::addArc(const Id& from, const Id& to,
+	                              const Weight& weight, const Id& middle,
+	                              std::vector<ArcList>* out,
+	                              std::vector<ArcList>* in) {
+
+	ArcList::iterator it = std::find_if((*out)[from].begin(),
+		(*out)[from].end(), [&to](const Arc& arc) { return arc.end == to; });
+
+	if (it == (*out)[from].end()) {
+
+		(*out)[from].push_back({ to, weight, middle });
+		(*in)[to].push_back({ from, weight, middle });
+
+	} else if (weight < it->weight) {
+
+		it->weight = weight;
+		it->middle = middle;
+
+		for (Arc& arc : (*in)[to]) {
+
+			if (arc.end == from) {
+
+				arc.weight = weight;
+				arc.middle = middle;
+			}
+		}
+	}
+}
+
+/*
+* Helper for constructor, removes the Arcs to a contracted Vertex
+* @param id The id of the contracted Vertex
+* @param arcs The Arcs of one of its neighbours
+*/
+void ContractionHierarchy::detach(const Id& id, ArcList* arcs) {
+
+	arcs->erase(std::remove_if(arcs->begin(), arcs->end(),
+		[&id](const Arc& arc) { return arc.end == id; }), arcs->end());
+}
+
+/*
+* Helper for ShortestPath, gets the Vertex a shortcut skips
+* @param from The id of the starting Vertex of the Edge
+* @param to The id of the ending Vertex of the Edge
+* @return id of the skipped Vertex, or NO_ID for an original Edge
+*/
+ContractionHierarchy::Id ContractionHierarchy::middle(const Id& from,
+	                                                  const Id& to) const {
+
+	if (this->rank[from] < this->rank[to]) {
+
+		for (Id e(this->upOffsets[from]); e < this->upOffsets[from + 1]; ++e) {
+
+			if (this->upTargets[e] == to) {
+
+				return this->upMiddles[e];
+			}
+		}
+
+	} else {
+
+		for (Id e(this->downOffsets[to]); e < this->downOffsets[to + 1]; ++e) {
+
+			if (this->downSources[e] == from) {
+
+				return this->downMiddles[e];
+			}
+		}
+	}
+
+	return FrozenGraph::NO_ID;
+}
+
+/*
+* Helper for ShortestPath, appends the original Vertices of an Edge
+* Shortcuts are split into their two halves until only original Edges
+* remain, the first half is always expanded first
+* @param from The id of the starting Vertex of the Edge
+* @param to The id of the ending Vertex of the Edge
+* @param path The Path to append every Vertex after from to
+*/
+void ContractionHierarchy::unpack(const Id& from, const Id& to,
+	                              Path* path) const {
+
+	std::vector<std::pair<Id, Id>> stack(Graph::COUNT,
+		                                 std::make_pair(from, to));
+
+	while (!stack.empty()) {
+
+		std::pair<Id, Id> edge = stack.back();
+
+		stack.pop_back();
+
+		Id skipped = this->middle(edge.first, edge.second);
+
+		if (skipped == FrozenGraph::NO_ID) {
+
+			path->push_back(this->labels[edge.second]);
+
+		} else {
+
+			stack.emplace_back(skipped, edge.second);
+			stack.emplace_back(edge.first, skipped);
+		}
+	}
+}
+
+/*
+* Gets the id of the Vertex with given label
+* @param label The label of the Vertex
+* @return id of the Vertex, or NO_ID if not found
+*/
+ContractionHierarchy::Id ContractionHierarchy::find(const Label& label) const {
+
+	auto it = std::lower_bound(this->labels.begin(), this->labels.end(), label);
+
+	return (it != this->labels.end() && *it == label) ?
+		   static_cast<Id>(it - this->labels.begin()) : FrozenGraph::NO_ID;
+}
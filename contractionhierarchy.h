@@ -0,0 +1,192 @@
+/*
+* contractionhierarchy.h
+*
+* Interface/specifications for ContractionHierarchy class
+*
+* @author Juan Arias
+*
+*/
+
+#ifndef CONTRACTIONHIERARCHY_H
+#define CONTRACTIONHIERARCHY_H
+
+#include <vector>
+#include "frozengraph.h"
+
+/*
+* A ContractionHierarchy preprocesses a FrozenGraph to answer repeated
+* shortest path queries quickly.
+* Vertices are contracted one at a time, least important first. Contracting
+* a Vertex adds a shortcut Edge between its remaining neighbours whenever
+* the path through it is the only shortest path between them. A query then
+* only has to search Edges leading to more important Vertices, forward from
+* the origin and backward from the destination.
+* Edge weights must not be negative.
+*/
+class ContractionHierarchy {
+
+public:
+
+	/* Type definitions */
+	using Label  = FrozenGraph::Label;
+	using Weight = FrozenGraph::Weight;
+	using Id     = FrozenGraph::Id;
+	using Path   = FrozenGraph::Path;
+
+	/* Constant for reuse with meaning */
+	static const int WITNESS_LIMIT;
+
+	/*
+	* Contracts every Vertex of a FrozenGraph
+	* @param graph The FrozenGraph to preprocess
+	*/
+	explicit ContractionHierarchy(const FrozenGraph& graph);
+
+	/*
+	* Shortest path between two Vertices
+	* @param from The label of the origin Vertex
+	* @param to The label of the destination Vertex
+	* @param path The Path to fill with labels from origin to destination,
+	* empty if there is no path
+	* @return cost of the shortest path, INT_MAX if there is no path
+	*/
+	Weight ShortestPath(const Label& from, const Label& to, Path& path) const;
+
+	/*
+	* Get the number of shortcut Edges added by contraction
+	* @return number of shortcut Edges
+	*/
+	int NumberOfShortcuts() const;
+
+	/*
+	* Get the memory used by the hierarchy arrays
+	* @return number of bytes used
+	*/
+	std::size_t MemoryUsage() const;
+
+private:
+
+	/* Type definitions */
+	using IdList     = std::vector<Id>;
+	using WeightList = std::vector<Weight>;
+
+	/*
+	* Edge of the graph being contracted
+	*/
+	struct Arc {
+
+		/* Id of the Vertex at the other end */
+		Id end;
+
+		/* Edge weight */
+		Weight weight;
+
+		/* Id of the contracted Vertex a shortcut skips, or NO_ID */
+		Id middle;
+	};
+
+	/* Type definitions */
+	using ArcList = std::vector<Arc>;
+
+	/* Vertex labels indexed by id, sorted */
+	std::vector<Label> labels;
+
+	/* Contraction order of each Vertex, higher is more important */
+	IdList rank;
+
+	/* Upward Edges from Vertex id are in [upOffsets[id], upOffsets[id + 1]) */
+	IdList upOffsets;
+
+	/* Ending Vertex id, weight and skipped Vertex id of each upward Edge */
+	IdList upTargets;
+	WeightList upWeights;
+	IdList upMiddles;
+
+	/* Upward Edges into Vertex id, from more important Vertices */
+	IdList downOffsets;
+
+	/* Starting Vertex id, weight and skipped Vertex id of each of them */
+	IdList downSources;
+	WeightList downWeights;
+	IdList downMiddles;
+
+	/* Number of shortcut Edges */
+	int shortcuts;
+
+	/*
+	* Helper for constructor, contracts a Vertex or counts its shortcuts
+	* @param id The id of the Vertex to contract
+	* @param out The outgoing Arcs of every Vertex
+	* @param in The incoming Arcs of every Vertex
+	* @param contracted The contracted marks indexed by id
+	* @param dist The witness search distances
+	* @param stamp The witness search each distance belongs to
+	* @param search Pointer to the number of the last witness search
+	* @param simulate True to only count the shortcuts
+	* @return number of shortcuts needed
+	*/
+	int contract(const Id& id, std::vector<ArcList>* out,
+		         std::vector<ArcList>* in, const std::vector<bool>& contracted,
+		         WeightList* dist, IdList* stamp, Id* search, bool simulate);
+
+	/*
+	* Helper for contract, Dijkstra search that ignores one Vertex and all
+	* contracted Vertices, stops past a cost or after WITNESS_LIMIT Vertices
+	* @param from The id of the origin Vertex
+	* @param skip The id of the Vertex to ignore
+	* @param limit The largest cost of interest
+	* @param out The outgoing Arcs of every Vertex
+	* @param contracted The contracted marks indexed by id
+	* @param dist The distances indexed by id, only valid where stamp matches
+	* @param stamp The search each distance belongs to
+	* @param search The number of this search
+	*/
+	void witness(const Id& from, const Id& skip, const Weight& limit,
+		         const std::vector<ArcList>& out,
+		         const std::vector<bool>& contracted, WeightList* dist,
+		         IdList* stamp, const Id& search) const;
+
+	/*
+	* Helper for contract, adds an Arc or lowers the weight of an existing one
+	* @param from The id of the starting Vertex
+	* @param to The id of the ending Vertex
+	* @param weight The weight of the Arc
+	* @param middle The id of the Vertex the Arc skips
+	* @param out The outgoing Arcs of every Vertex
+	* @param in The incoming Arcs of every Vertex
+	*/
+	void addArc(const Id& from, const Id& to, const Weight& weight,
+		        const Id& middle, std::vector<ArcList>* out,
+		        std::vector<ArcList>* in);
+
+	/*
+	* Helper for constructor, removes the Arcs to a contracted Vertex
+	* @param id The id of the contracted Vertex
+	* @param arcs The Arcs of one of its neighbours
+	*/
+	void detach(const Id& id, ArcList* arcs);
+
+	/*
+	* Helper for ShortestPath, gets the Vertex a shortcut skips
+	* @param from The id of the starting Vertex of the Edge
+	* @param to The id of the ending Vertex of the Edge
+	* @return id of the skipped Vertex, or NO_ID for an original Edge
+	*/
+	Id middle(const Id& from, const Id& to) const;
+
+	/*
+	* Helper for ShortestPath, appends the original Vertices of an Edge
+	* @param from The id of the starting Vertex of the Edge
+	* @param to The id of the ending Vertex of the Edge
+	* @param path The Path to append every Vertex after from to
+	*/
+	void unpack(const Id& from, const Id& to, Path* path) const;
+
+	/*
+	* Gets the id of the Vertex with given label
+	* @param label The label of the Vertex
+	* @return id of the Vertex, or NO_ID if not found
+	*/
+	Id find(const Label& label) const;
+};
+#endif  // CONTRACTIONHIERARCHY_H
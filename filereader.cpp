@@ -0,0 +1,453 @@
+/*
+* filereader.cpp
+*
+* Implementations for FileReader class
+*
+* @author Juan Arias
+*
+*/
+
+#include <cstring>
+#include "filereader.h"
+
+#ifdef GRAPH_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef GRAPH_ZSTD
+#include <zstd.h>
+#endif
+
+/* Constant definitions */
+const std::size_t FileReader::BLOCK_SIZE(1 << 22);
+const std::size_t FileReader::QUEUE_SIZE(4);
+
+/* Number of bytes read from the file or decompressed at a time */
+static const std::size_t READ_SIZE(1 << 18);
+
+/* Magic bytes at the start of compressed files */
+static const unsigned char GZIP_MAGIC[2] = { 0x1f, 0x8b };
+static const unsigned char ZSTD_MAGIC[4] = { 0x28, 0xb5, 0x2f, 0xfd };
+
+/*
+* Constructs closed FileReader
+*/
+FileReader::FileReader()
+
+	:compression(Compression::NONE), returned(false), done(true),
+	stopping(false) {}
+
+/*
+* Stops decompressing and closes the file
+*/
+FileReader::~FileReader() {
+
+	this->Close();
+}
+
+/*
+* Opens a file and detects its compression, closing any file open before
+* Compressed files start decompressing right away
+* @param fileName The name of the file
+* @return true if file can be read, else false
+*/
+bool FileReader::Open(const std::string& fileName) {
+
+	this->Close();
+
+	this->file.open(fileName, std::ios::binary);
+
+	if (!this->file.is_open()) {
+
+		this->error = "cannot read file";
+
+		return false;
+	}
+
+	unsigned char magic[sizeof(ZSTD_MAGIC)] = {};
+
+	this->file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+
+	std::streamsize count = this->file.gcount();
+
+	this->file.clear();
+	this->file.seekg(0);
+
+	if (count >= static_cast<std::streamsize>(sizeof(GZIP_MAGIC)) &&
+		std::memcmp(magic, GZIP_MAGIC, sizeof(GZIP_MAGIC)) == 0) {
+
+		this->compression = Compression::GZIP;
+
+	} else if (count == static_cast<std::streamsize>(sizeof(ZSTD_MAGIC)) &&
+		       std::memcmp(magic, ZSTD_MAGIC, sizeof(ZSTD_MAGIC)) == 0) {
+
+		this->compression = Compression::ZSTD;
+	}
+
+#ifndef GRAPH_ZLIB
+	if (this->compression == Compression::GZIP) {
+
+		this->Close();
+		this->error = "gzip compressed, build with GRAPH_ZLIB to read it";
+
+		return false;
+	}
+#endif
+
+#ifndef GRAPH_ZSTD
+	if (this->compression == Compression::ZSTD) {
+
+		this->Close();
+		this->error = "zstd compressed, build with GRAPH_ZSTD to read it";
+
+		return false;
+	}
+#endif
+
+	if (this->compression != Compression::NONE) {
+
+		this->done = false;
+		this->thread = std::thread(&FileReader::decompress, this);
+	}
+
+	return true;
+}
+
+/*
+* Gets the compression of the open file
+* @return compression of the open file
+*/
+FileReader::Compression FileReader::GetCompression() const {
+
+	return this->compression;
+}
+
+/*
+* Gets the next block of text, waiting for it to be decompressed
+* Every block but the last ends with a newline
+* @param block The string to set to the block
+* @return true if a block was read, false at the end of the file or after
+* an error
+*/
+bool FileReader::Next(std::string& block) {
+
+	if (this->compression == Compression::NONE) {
+
+		if (this->returned || !this->file.is_open()) {
+
+			return false;
+		}
+
+		this->returned = true;
+		this->file.seekg(0, std::ios::end);
+
+		std::streamoff size = this->file.tellg();
+
+		this->file.seekg(0);
+
+		if (size < 0) {
+
+			this->error = "cannot read file";
+
+			return false;
+		}
+
+		block.resize(static_cast<std::size_t>(size));
+
+		if (size > 0 && !this->file.read(&block[0], size)) {
+
+			this->error = "cannot read file";
+
+			return false;
+		}
+
+		return true;
+	}
+
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	this->ready.wait(lock, [this]() {
+
+		return !this->blocks.empty() || this->done;
+	});
+
+	if (this->blocks.empty()) {
+
+		return false;
+	}
+
+	block = std::move(this->blocks.front());
+	this->blocks.pop_front();
+
+	lock.unlock();
+	this->taken.notify_one();
+
+	return true;
+}
+
+/*
+* Gets the reason the file could not be read
+* @return the error, empty if none
+*/
+std::string FileReader::Error() const {
+
+	std::lock_guard<std::mutex> lock(this->mutex);
+
+	return this->error;
+}
+
+/*
+* Stops decompressing and closes the file
+*/
+void FileReader::Close() {
+
+	if (this->thread.joinable()) {
+
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+
+			this->stopping = true;
+		}
+
+		this->taken.notify_all();
+		this->thread.join();
+	}
+
+	this->file.close();
+	this->file.clear();
+	this->compression = Compression::NONE;
+	this->returned = false;
+	this->blocks.clear();
+	this->done = true;
+	this->stopping = false;
+	this->error.clear();
+}
+
+/*
+* Body of the decompressing thread, splits the decompressed text into
+* blocks of whole lines
+* Output is decompressed straight into the end of the block, the partial
+* last line of a full block moves to the start of the next one. gzip files
+* may hold several members and zstd files several frames, one after the
+* other
+*/
+void FileReader::decompress() {
+
+	std::string input, block;
+	bool complete(true);
+
+	block.reserve(FileReader::BLOCK_SIZE + READ_SIZE);
+
+#ifdef GRAPH_ZLIB
+	if (this->compression == Compression::GZIP) {
+
+		z_stream stream;
+		int status(Z_OK);
+
+		std::memset(&stream, 0, sizeof(stream));
+
+		if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+
+			this->fail("cannot start gzip decompression");
+
+			return;
+		}
+
+		while (this->readCompressed(&input)) {
+
+			stream.next_in = reinterpret_cast<Bytef*>(&input[0]);
+			stream.avail_in = static_cast<uInt>(input.size());
+
+			do {
+
+				if (status == Z_STREAM_END && stream.avail_in > 0) {
+
+					inflateReset(&stream);
+				}
+
+				std::size_t size = block.size();
+
+				block.resize(size + READ_SIZE);
+				stream.next_out = reinterpret_cast<Bytef*>(&block[size]);
+				stream.avail_out = static_cast<uInt>(READ_SIZE);
+
+				status = inflate(&stream, Z_NO_FLUSH);
+
+				block.resize(size + READ_SIZE - stream.avail_out);
+
+				if (status == Z_BUF_ERROR) {
+
+					break;
+				}
+
+				if (status != Z_OK && status != Z_STREAM_END) {
+
+					inflateEnd(&stream);
+					this->fail("corrupt gzip data");
+
+					return;
+				}
+
+				if (block.size() >= FileReader::BLOCK_SIZE &&
+					!this->push(&block, false)) {
+
+					inflateEnd(&stream);
+
+					return;
+				}
+
+			} while (stream.avail_in > 0 ||
+				     (stream.avail_out == 0 && status != Z_STREAM_END));
+		}
+
+		inflateEnd(&stream);
+		complete = (status == Z_STREAM_END);
+	}
+#endif
+
+#ifdef GRAPH_ZSTD
+	if (this->compression == Compression::ZSTD) {
+
+		ZSTD_DStream* stream = ZSTD_createDStream();
+		std::size_t status(0);
+
+		ZSTD_initDStream(stream);
+
+		while (this->readCompressed(&input)) {
+
+			ZSTD_inBuffer in = { input.data(), input.size(), 0 };
+			ZSTD_outBuffer out;
+
+			do {
+
+				std::size_t size = block.size();
+
+				block.resize(size + READ_SIZE);
+				out = { &block[size], READ_SIZE, 0 };
+
+				status = ZSTD_decompressStream(stream, &out, &in);
+
+				block.resize(size + out.pos);
+
+				if (ZSTD_isError(status)) {
+
+					ZSTD_freeDStream(stream);
+					this->fail("corrupt zstd data");
+
+					return;
+				}
+
+				if (block.size() >= FileReader::BLOCK_SIZE &&
+					!this->push(&block, false)) {
+
+					ZSTD_freeDStream(stream);
+
+					return;
+				}
+
+			} while (in.pos < in.size || out.pos == out.size);
+		}
+
+		ZSTD_freeDStream(stream);
+		complete = (status == 0);
+	}
+#endif
+
+	if (!complete) {
+
+		const char* name = (this->compression == Compression::GZIP) ? "gzip" :
+			                                                          "zstd";
+
+		this->fail(std::string("truncated ") + name + " data");
+
+		return;
+	}
+
+	this->push(&block, true);
+}
+
+/*
+* Helper for decompress, gets the next compressed bytes of the file
+* @param buffer The string to fill
+* @return true if bytes were read, false at the end of the file
+*/
+bool FileReader::readCompressed(std::string* buffer) {
+
+	buffer->resize(READ_SIZE);
+
+	this->file.read(&(*buffer)[0], static_cast<std::streamsize>(READ_SIZE));
+
+	buffer->resize(static_cast<std::size_t>(this->file.gcount()));
+
+	return !buffer->empty();
+}
+
+/*
+* Helper for decompress, hands the whole lines of a block to Next and
+* keeps the partial last line in the block
+* Waits while QUEUE_SIZE blocks are waiting, so a slow caller bounds the
+* memory decompressed ahead of it
+* @param block The decompressed text
+* @param last True if no text follows the block
+* @return false if the reader is stopping, else true
+*/
+bool FileReader::push(std::string* block, bool last) {
+
+	std::string rest;
+
+	if (!last) {
+
+		std::size_t eol = block->rfind('\n');
+
+		if (eol == std::string::npos) {
+
+			return true;
+		}
+
+		rest.reserve(FileReader::BLOCK_SIZE + READ_SIZE);
+		rest.assign(*block, eol + 1, std::string::npos);
+		block->resize(eol + 1);
+	}
+
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	this->taken.wait(lock, [this]() {
+
+		return this->blocks.size() < FileReader::QUEUE_SIZE || this->stopping;
+	});
+
+	if (this->stopping) {
+
+		return false;
+	}
+
+	if (!block->empty()) {
+
+		this->blocks.push_back(std::move(*block));
+	}
+
+	this->done = last;
+
+	lock.unlock();
+	this->ready.notify_one();
+
+	*block = std::move(rest);
+
+	return true;
+}
+
+/*
+* Helper for decompress, ends decompressing with an error
+* @param message The reason the file could not be read
+*/
+void FileReader::fail(const std::string& message) {
+
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->error = message;
+		this->done = true;
+	}
+
+	this->ready.notify_all();
+}
@@ -0,0 +1,153 @@
+/*
+* filereader.h
+*
+* Interface/specifications for FileReader class
+*
+* @author Juan Arias
+*
+*/
+
+#ifndef FILEREADER_H
+#define FILEREADER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/*
+* A FileReader reads a text file in blocks of whole lines.
+* Plain files are read with a single read into one block. Files starting
+* with the magic bytes of gzip or zstd are decompressed on a thread of the
+* reader while the caller parses the blocks already returned, so reading
+* overlaps with parsing and no decompressed copy touches the disk.
+* gzip needs zlib and zstd needs libzstd, build with -DGRAPH_ZLIB -lz and
+* -DGRAPH_ZSTD -lzstd to enable them.
+*/
+class FileReader {
+
+public:
+
+	/* Compression of a file, detected by its magic bytes */
+	enum class Compression { NONE, GZIP, ZSTD };
+
+	/* Size blocks of decompressed text grow to before they are returned */
+	static const std::size_t BLOCK_SIZE;
+
+	/*
+	* Constructs closed FileReader
+	*/
+	FileReader();
+
+	/*
+	* Stops decompressing and closes the file
+	*/
+	virtual ~FileReader();
+
+	FileReader(const FileReader& other)            = delete;
+	FileReader& operator=(const FileReader& other) = delete;
+
+	/*
+	* Opens a file and detects its compression, closing any file open
+	* before
+	* @param fileName The name of the file
+	* @return true if file can be read, else false
+	*/
+	bool Open(const std::string& fileName);
+
+	/*
+	* Gets the compression of the open file
+	* @return compression of the open file
+	*/
+	Compression GetCompression() const;
+
+	/*
+	* Gets the next block of text, waiting for it to be decompressed
+	* Every block but the last ends with a newline
+	* @param block The string to set to the block
+	* @return true if a block was read, false at the end of the file or
+	* after an error
+	*/
+	bool Next(std::string& block);
+
+	/*
+	* Gets the reason the file could not be read
+	* @return the error, empty if none
+	*/
+	std::string Error() const;
+
+	/*
+	* Stops decompressing and closes the file
+	*/
+	void Close();
+
+private:
+
+	/* Largest number of decompressed blocks waiting for Next */
+	static const std::size_t QUEUE_SIZE;
+
+	/* The open file */
+	std::ifstream file;
+
+	/* Compression of the open file */
+	Compression compression;
+
+	/* True once the single block of a plain file was returned */
+	bool returned;
+
+	/* Thread decompressing the file into blocks */
+	std::thread thread;
+
+	/* Guards all members below */
+	mutable std::mutex mutex;
+
+	/* Signals Next that a block is ready or decompression ended */
+	std::condition_variable ready;
+
+	/* Signals the decompressing thread that a block was taken */
+	std::condition_variable taken;
+
+	/* Decompressed blocks waiting for Next */
+	std::deque<std::string> blocks;
+
+	/* True once the decompressing thread finished */
+	bool done;
+
+	/* True to stop the decompressing thread early */
+	bool stopping;
+
+	/* Reason the file could not be read, empty if none */
+	std::string error;
+
+	/*
+	* Body of the decompressing thread, splits the decompressed text into
+	* blocks of whole lines
+	*/
+	void decompress();
+
+	/*
+	* Helper for decompress, gets the next compressed bytes of the file
+	* @param buffer The string to fill
+	* @return true if bytes were read, false at the end of the file
+	*/
+	bool readCompressed(std::string* buffer);
+
+	/*
+	* Helper for decompress, hands the whole lines of a block to Next and
+	* keeps the partial last line in the block
+	* @param block The decompressed text
+	* @param last True if no text follows the block
+	* @return false if the reader is stopping, else true
+	*/
+	bool push(std::string* block, bool last);
+
+	/*
+	* Helper for decompress, ends decompressing with an error
+	* @param message The reason the file could not be read
+	*/
+	void fail(const std::string& message);
+};
+#endif  // FILEREADER_H
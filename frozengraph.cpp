@@ -0,0 +1,1886 @@
+/*
+* frozengraph.cpp
+*
+* Implementations for FrozenGraph class
+*
+* @author Juan Arias
+*
+*/
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <tuple>
+#include "frozengraph.h"
+#include "landmarks.h"
+#include "threadpool.h"
+
+/* Constant definition */
+const FrozenGraph::Id     FrozenGraph::NO_ID(UINT32_MAX);
+const FrozenGraph::Weight FrozenGraph::MAX_BUCKET_WEIGHT(256);
+const int                 FrozenGraph::NO_DEPTH(-1);
+const int                 FrozenGraph::BOTTOM_UP_ALPHA(14);
+const int                 FrozenGraph::TOP_DOWN_BETA(24);
+const int                 FrozenGraph::BFS_BATCH(64);
+
+/*
+* Constructs snapshot of a Graph
+* @param graph The Graph to snapshot
+*/
+FrozenGraph::FrozenGraph(const Graph& graph)
+
+	:minWeight(Graph::NO_WEIGHT), maxWeight(Graph::NO_WEIGHT) {
+
+	this->labels.reserve(graph.vertices.size());
+	this->offsets.reserve(graph.vertices.size() + Graph::COUNT);
+	this->targets.reserve(graph.edges);
+	this->weights.reserve(graph.edges);
+
+	Graph::IdList remap(graph.vertices.size());
+
+	for (const Graph::LabelId& pair : graph.map) {
+
+		remap[pair.second] = static_cast<Id>(this->labels.size());
+
+		this->labels.push_back(pair.first);
+	}
+
+	this->offsets.push_back(Graph::EMPTY);
+
+	for (const Graph::LabelId& pair : graph.map) {
+
+		const Graph::Edge* curr = graph.vertices[pair.second].getNext();
+
+		while (curr != nullptr) {
+
+			this->targets.push_back(remap[curr->getId()]);
+			this->weights.push_back(curr->getWeight());
+
+			curr = curr->getNext();
+		}
+
+		this->offsets.push_back(static_cast<Id>(this->targets.size()));
+	}
+
+	this->reverseOffsets.assign(this->labels.size() + Graph::COUNT, 0);
+	this->sources.resize(this->targets.size());
+	this->reverseWeights.resize(this->targets.size());
+
+	for (const Id& target : this->targets) {
+
+		++this->reverseOffsets[target + 1];
+	}
+
+	for (std::size_t id(0); id < this->labels.size(); ++id) {
+
+		this->reverseOffsets[id + 1] += this->reverseOffsets[id];
+	}
+
+	IdList fill(this->reverseOffsets.begin(), this->reverseOffsets.end() - 1);
+
+	for (Id id(0); id < this->labels.size(); ++id) {
+
+		for (Id e(this->offsets[id]); e < this->offsets[id + 1]; ++e) {
+
+			Id r = fill[this->targets[e]]++;
+
+			this->sources[r] = id;
+			this->reverseWeights[r] = this->weights[e];
+		}
+	}
+
+	if (!this->weights.empty()) {
+
+		this->minWeight = *std::min_element(this->weights.begin(),
+			                                this->weights.end());
+		this->maxWeight = *std::max_element(this->weights.begin(),
+			                                this->weights.end());
+	}
+}
+
+/*
+* Get the total number of Vertices in FrozenGraph
+* @return total number of Vertices in FrozenGraph
+*/
+int FrozenGraph::NumberOfVertices() const {
+
+	return static_cast<int>(this->labels.size());
+}
+
+/*
+* Get the total number of Edges in FrozenGraph
+* @return total number of Edges in FrozenGraph
+*/
+int FrozenGraph::NumberOfEdges() const {
+
+	return static_cast<int>(this->targets.size());
+}
+
+/*
+* Get the number of Edges connected to a given Vertex
+* @param label The label of the Vertex
+* @return number of edges from Vertex, -1 if Vertex not found
+*/
+int FrozenGraph::NumberOfEdges(const Label& label) const {
+
+	int edges(Graph::EMPTY - Graph::COUNT);
+
+	Id id = this->find(label);
+
+	if (id != FrozenGraph::NO_ID) {
+
+		edges = static_cast<int>(this->offsets[id + 1] - this->offsets[id]);
+	}
+
+	return edges;
+}
+
+/*
+* Check is Vertex exists in FrozenGraph
+* @param label The label of the vertex to find
+* @return true if Vertex in FrozenGraph, else false
+*/
+bool FrozenGraph::HasVertex(const Label& label) const {
+
+	return this->find(label) != FrozenGraph::NO_ID;
+}
+
+/*
+* Gets the id of a Vertex, ids are positions in label order
+* @param label The label of the Vertex
+* @return id of the Vertex, NO_ID if Vertex not found
+*/
+FrozenGraph::Id FrozenGraph::GetId(const Label& label) const {
+
+	return this->find(label);
+}
+
+/*
+* Gets the label of a Vertex
+* @param id The id of the Vertex, less than NumberOfVertices()
+* @return label of the Vertex
+*/
+const FrozenGraph::Label& FrozenGraph::GetLabel(const Id& id) const {
+
+	return this->labels[id];
+}
+
+/*
+* String representation of Edges from a given Vertex
+* @param label The label of the Vertex to get Edges from
+* @return string representing Edges and weights, "" if Vertex not found
+*/
+std::string FrozenGraph::GetEdges(const Label& label) const {
+
+	std::string edges;
+
+	Id id = this->find(label);
+
+	if (id != FrozenGraph::NO_ID) {
+
+		for (Id e(this->offsets[id]); e < this->offsets[id + 1]; ++e) {
+
+			if (e != this->offsets[id]) {
+
+				edges += Graph::COMMA;
+			}
+
+			Graph::appendEdge(&edges, this->labels[this->targets[e]],
+				              this->weights[e]);
+		}
+	}
+
+	return edges;
+}
+
+/*
+* Depth-first traversal originating from Vertex with given label
+* Each stack entry holds a Vertex id and its next Edge to explore
+* @param label The origin Vertex label
+* @param func The function to call on each Vertex label
+*/
+void FrozenGraph::DFS(const Label& label, Visit func) const {
+
+	Id id = this->find(label);
+
+	if (id != FrozenGraph::NO_ID) {
+
+		std::vector<bool> visited(this->labels.size(), false);
+		std::vector<std::pair<Id, Id>> stack;
+
+		visited[id] = true;
+		func(this->labels[id]);
+		stack.emplace_back(id, this->offsets[id]);
+
+		while (!stack.empty()) {
+
+			std::pair<Id, Id>& top = stack.back();
+
+			while (top.second < this->offsets[top.first + 1] &&
+				   visited[this->targets[top.second]]) {
+
+				++top.second;
+			}
+
+			if (top.second < this->offsets[top.first + 1]) {
+
+				Id next = this->targets[top.second++];
+
+				visited[next] = true;
+				func(this->labels[next]);
+				stack.emplace_back(next, this->offsets[next]);
+
+			} else {
+
+				stack.pop_back();
+			}
+		}
+	}
+}
+
+/*
+* Breadth-first traversal originating from Vertex with given label
+* The visit order itself is used as the queue
+* @param label The origin Vertex label
+* @param func The function to call on each Vertex label
+*/
+void FrozenGraph::BFS(const Label& label, Visit func) const {
+
+	Id id = this->find(label);
+
+	if (id != FrozenGraph::NO_ID) {
+
+		std::vector<bool> visited(this->labels.size(), false);
+		std::vector<Id> q;
+
+		q.reserve(this->labels.size());
+		q.push_back(id);
+		visited[id] = true;
+
+		for (std::size_t front(0); front < q.size(); ++front) {
+
+			Id curr = q[front];
+
+			func(this->labels[curr]);
+
+			for (Id e(this->offsets[curr]); e < this->offsets[curr + 1]; ++e) {
+
+				if (!visited[this->targets[e]]) {
+
+					visited[this->targets[e]] = true;
+					q.push_back(this->targets[e]);
+				}
+			}
+		}
+	}
+}
+
+/*
+* Direction-optimizing breadth-first search from Vertex with given label
+* Frontier and visited sets are Bitmaps with one bit per id. A level goes
+* bottom-up once the Edges out of the frontier exceed 1 / BOTTOM_UP_ALPHA
+* of the Edges into unvisited Vertices, and back top-down once the frontier
+* holds fewer than 1 / TOP_DOWN_BETA of the Vertices
+* @param label The origin Vertex label
+* @param depth The DepthList to fill with the number of Edges from the
+* origin to each Vertex by id, NO_DEPTH if not reached
+* @param parent The IdArray to fill with the previous Vertex of each
+* Vertex by id, the origin is its own parent, NO_ID if not reached
+*/
+void FrozenGraph::BFS(const Label& label, DepthList& depth,
+	                  IdArray& parent) const {
+
+	std::size_t vertices = this->labels.size(),
+		        words = (vertices + 63) / 64;
+
+	depth.assign(vertices, FrozenGraph::NO_DEPTH);
+	parent.assign(vertices, FrozenGraph::NO_ID);
+
+	Id origin = this->find(label);
+
+	if (origin == FrozenGraph::NO_ID) {
+
+		return;
+	}
+
+	Frontier frontier { Bitmap(words, 0), IdList(Graph::COUNT, origin) },
+		     next { Bitmap(words, 0), IdList() };
+	Bitmap visited(words, 0);
+
+	frontier.bits[origin / 64] |= std::uint64_t(1) << origin % 64;
+	visited[origin / 64] |= std::uint64_t(1) << origin % 64;
+	depth[origin] = Graph::EMPTY;
+	parent[origin] = origin;
+
+	long long edges = this->offsets[origin + 1] - this->offsets[origin],
+		      unvisited = static_cast<long long>(this->targets.size()) -
+		                  (this->reverseOffsets[origin + 1] -
+		                   this->reverseOffsets[origin]);
+	bool bottomUp(false);
+
+	for (int level(1); !frontier.ids.empty(); ++level) {
+
+		if (!bottomUp) {
+
+			bottomUp = edges > unvisited / FrozenGraph::BOTTOM_UP_ALPHA;
+
+		} else {
+
+			bottomUp = frontier.ids.size() >=
+				       vertices / FrozenGraph::TOP_DOWN_BETA;
+		}
+
+		if (bottomUp) {
+
+			this->bottomUp(frontier, &next, &visited, level, &depth, &parent,
+				           &edges, &unvisited);
+
+		} else {
+
+			this->topDown(frontier, &next, &visited, level, &depth, &parent,
+				          &edges, &unvisited);
+		}
+
+		for (const Id& id : frontier.ids) {
+
+			frontier.bits[id / 64] = 0;
+		}
+
+		frontier.ids.clear();
+
+		std::swap(frontier, next);
+	}
+}
+
+/*
+* Closeness centrality of Vertices along outgoing Edges, ignoring weights
+* Depths are summed as multiSourceBFS reports them, without storing them
+* @param sources The labels of the Vertices
+* @param closeness The ScoreList to fill with the closeness of each
+* source by position, 0 if it reaches no other Vertex or is not found
+*/
+void FrozenGraph::Closeness(const Path& sources, ScoreList& closeness) const {
+
+	IdList origins, reached(sources.size(), Graph::EMPTY);
+	std::vector<long long> sum(sources.size(), Graph::EMPTY);
+
+	for (const Label& label : sources) {
+
+		origins.push_back(this->find(label));
+	}
+
+	this->multiSourceBFS(origins, [&reached, &sum](std::size_t first,
+		                                           const Id&,
+		                                           std::uint64_t bits,
+		                                           int level) {
+
+		for (; bits != 0; bits &= bits - 1) {
+
+			std::size_t source = first + FrozenGraph::lowestBit(bits);
+
+			++reached[source];
+			sum[source] += level;
+		}
+	});
+
+	double others = static_cast<double>(this->labels.size()) - Graph::COUNT;
+
+	closeness.assign(sources.size(), 0.0);
+
+	for (std::size_t source(0); source < sources.size(); ++source) {
+
+		if (sum[source] > 0) {
+
+			double r = static_cast<double>(reached[source]) - Graph::COUNT;
+
+			closeness[source] = r / others * r / sum[source];
+		}
+	}
+}
+
+/*
+* Eccentricity of Vertices along outgoing Edges, ignoring weights
+* Levels are reported in order, so the last level a source reaches is its
+* eccentricity
+* @param sources The labels of the Vertices
+* @param eccentricity The DepthList to fill with the largest depth of a
+* Vertex reached from each source by position, NO_DEPTH if not found
+*/
+void FrozenGraph::Eccentricity(const Path& sources,
+	                           DepthList& eccentricity) const {
+
+	IdList origins;
+
+	for (const Label& label : sources) {
+
+		origins.push_back(this->find(label));
+	}
+
+	eccentricity.assign(sources.size(), FrozenGraph::NO_DEPTH);
+
+	this->multiSourceBFS(origins, [&eccentricity](std::size_t first,
+		                                          const Id&,
+		                                          std::uint64_t bits,
+		                                          int level) {
+
+		for (; bits != 0; bits &= bits - 1) {
+
+			eccentricity[first + FrozenGraph::lowestBit(bits)] = level;
+		}
+	});
+}
+
+/*
+* Diameter of FrozenGraph along outgoing Edges, ignoring weights
+* Searches from every Vertex, the deepest level any search reaches is the
+* diameter
+* @return largest eccentricity of any Vertex, 0 if there are no Edges
+*/
+int FrozenGraph::Diameter() const {
+
+	IdList origins(this->labels.size());
+	int diameter(Graph::EMPTY);
+
+	for (Id id(0); id < origins.size(); ++id) {
+
+		origins[id] = id;
+	}
+
+	this->multiSourceBFS(origins, [&diameter](std::size_t, const Id&,
+		                                      std::uint64_t, int level) {
+
+		diameter = std::max(diameter, level);
+	});
+
+	return diameter;
+}
+
+/*
+* Dijkstra's algorithm to find shortest distance to all other Vertices
+* and the path to all other Vertices, see Graph::Dijkstra
+* Falls back to BINARY_HEAP if the Edge weights do not fit the queue
+* When several shortest paths exist the recorded previous Vertex may
+* depend on the queue
+* @param label The label of the origin Vertex
+* @param wMap The map to record shortest path
+* @param pMap The map to record previous Vertex
+* @param queue The priority queue to use, defaults to AUTO
+*/
+void FrozenGraph::Dijkstra(const Label& label, WeightMap& wMap, PrevMap& pMap,
+	                       Queue queue) const {
+
+	Id origin = this->find(label);
+
+	if (origin != FrozenGraph::NO_ID) {
+
+		WeightList dist(this->labels.size(), INT_MAX);
+		IdList prev(this->labels.size(), FrozenGraph::NO_ID);
+
+		dist[origin] = Graph::NO_WEIGHT;
+
+		switch (this->select(queue)) {
+
+		case Queue::BUCKETS:
+
+			this->buckets(origin, &dist, &prev);
+			break;
+
+		case Queue::RADIX_HEAP:
+
+			this->radixHeap(origin, &dist, &prev);
+			break;
+
+		case Queue::ZERO_ONE:
+
+			this->zeroOne(origin, &dist, &prev);
+			break;
+
+		default:
+
+			this->binaryHeap(origin, &dist, &prev);
+			break;
+		}
+
+		this->record(origin, dist, prev, &wMap, &pMap);
+	}
+}
+
+/*
+* Parallel delta-stepping alternative to Dijkstra with the same results
+* Falls back to Dijkstra with BINARY_HEAP for negative weights
+* @param label The label of the origin Vertex
+* @param wMap The map to record shortest path
+* @param pMap The map to record previous Vertex
+* @param pool The ThreadPool to relax Edges on
+* @param delta The bucket width, picked from the Edge weights if <= 0,
+* raised to at least the largest weight over the number of Vertices so
+* the buckets stay within one per Vertex
+*/
+void FrozenGraph::DeltaStepping(const Label& label, WeightMap& wMap,
+	                            PrevMap& pMap, ThreadPool& pool,
+	                            Weight delta) const {
+
+	Id origin = this->find(label);
+
+	if (origin != FrozenGraph::NO_ID) {
+
+		WeightList dist(this->labels.size(), INT_MAX);
+		IdList prev(this->labels.size(), FrozenGraph::NO_ID);
+
+		dist[origin] = Graph::NO_WEIGHT;
+
+		if (this->minWeight < Graph::NO_WEIGHT) {
+
+			this->binaryHeap(origin, &dist, &prev);
+
+		} else {
+
+			if (delta <= Graph::NO_WEIGHT) {
+
+				long long degree = std::max<long long>(
+					Graph::COUNT, this->targets.size() / this->labels.size());
+
+				delta = static_cast<Weight>(std::max<long long>(
+					Graph::COUNT, this->maxWeight / degree));
+			}
+
+			long long vertices = static_cast<long long>(this->labels.size());
+
+			delta = static_cast<Weight>(std::max<long long>(
+				delta, (this->maxWeight + vertices - 1) / vertices));
+
+			this->deltaStepping(origin, delta, pool, &dist, &prev);
+		}
+
+		this->record(origin, dist, prev, &wMap, &pMap);
+	}
+}
+
+/*
+* Shortest path between two Vertices using bidirectional Dijkstra
+* Falls back to a single forward search for negative weights
+* @param from The label of the origin Vertex
+* @param to The label of the destination Vertex
+* @param path The Path to fill with labels from origin to destination,
+* empty if there is no path
+* @return cost of the shortest path, INT_MAX if there is no path
+*/
+FrozenGraph::Weight FrozenGraph::ShortestPath(const Label& from,
+	                                          const Label& to,
+	                                          Path& path) const {
+
+	Id origin = this->find(from),
+	   destination = this->find(to);
+
+	Weight cost = INT_MAX;
+
+	path.clear();
+
+	if (origin != FrozenGraph::NO_ID && destination != FrozenGraph::NO_ID) {
+
+		IdList prev(this->labels.size(), FrozenGraph::NO_ID),
+			   next(this->labels.size(), FrozenGraph::NO_ID);
+
+		std::pair<Id, Id> meet(destination, destination);
+
+		if (this->minWeight < Graph::NO_WEIGHT) {
+
+			WeightList dist(this->labels.size(), INT_MAX);
+
+			dist[origin] = Graph::NO_WEIGHT;
+
+			this->binaryHeap(origin, &dist, &prev);
+
+			cost = dist[destination];
+
+		} else {
+
+			cost = this->bidirectional(origin, destination, &prev, &next,
+				                       &meet);
+		}
+
+		if (cost != INT_MAX) {
+
+			this->trace(meet, prev, next, &path);
+		}
+	}
+
+	return cost;
+}
+
+/*
+* Shortest path between two Vertices using A* search
+* @param from The label of the origin Vertex
+* @param to The label of the destination Vertex
+* @param heuristic Estimates the cost from a Vertex (first label) to the
+* destination (second label)
+* @param path The Path to fill with labels from origin to destination,
+* empty if there is no path
+* @return cost of the shortest path, INT_MAX if there is no path
+*/
+FrozenGraph::Weight FrozenGraph::AStar(const Label& from, const Label& to,
+	                                   const Heuristic& heuristic,
+	                                   Path& path) const {
+
+	Id origin = this->find(from),
+	   destination = this->find(to);
+
+	path.clear();
+
+	if (origin == FrozenGraph::NO_ID || destination == FrozenGraph::NO_ID) {
+
+		return INT_MAX;
+	}
+
+	return this->aStar(origin, destination, [&](const Id& id) {
+
+		return heuristic(this->labels[id], to);
+
+	}, &path);
+}
+
+/*
+* Shortest path between two Vertices using A* search with heuristics
+* derived from Landmarks by the triangle inequality (ALT)
+* @param from The label of the origin Vertex
+* @param to The label of the destination Vertex
+* @param landmarks The Landmarks preprocessed on this FrozenGraph
+* @param path The Path to fill with labels from origin to destination,
+* empty if there is no path
+* @return cost of the shortest path, INT_MAX if there is no path
+*/
+FrozenGraph::Weight FrozenGraph::AStar(const Label& from, const Label& to,
+	                                   const Landmarks& landmarks,
+	                                   Path& path) const {
+
+	Id origin = this->find(from),
+	   destination = this->find(to);
+
+	path.clear();
+
+	if (origin == FrozenGraph::NO_ID || destination == FrozenGraph::NO_ID) {
+
+		return INT_MAX;
+	}
+
+	return this->aStar(origin, destination, [&](const Id& id) {
+
+		return landmarks.estimate(id, destination);
+
+	}, &path);
+}
+
+/*
+* Creates a MinSpanningTree using Prim's algorithm
+* Candidate Edges are kept in a heap ordered by weight, then by starting and
+* ending label, which picks the same Edges as Graph::MinSpanningTree
+* @param label The label of the origin Vertex
+* @return a Graph of the MinSpanningTree
+*/
+Graph FrozenGraph::MinSpanningTree(const Label& label) const {
+
+	using Entry = std::tuple<Weight, Id, Id>;
+
+	Graph mst;
+
+	Id origin = this->find(label);
+
+	if (origin == FrozenGraph::NO_ID) {
+
+		return mst;
+	}
+
+	std::vector<bool> visited(this->labels.size(), false);
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+	mst.AddVertex(label);
+
+	Id curr = origin;
+
+	while (curr != FrozenGraph::NO_ID) {
+
+		visited[curr] = true;
+
+		for (Id e(this->offsets[curr]); e < this->offsets[curr + 1]; ++e) {
+
+			if (!visited[this->targets[e]]) {
+
+				heap.emplace(this->weights[e], curr, this->targets[e]);
+			}
+		}
+
+		curr = FrozenGraph::NO_ID;
+
+		while (!heap.empty() && curr == FrozenGraph::NO_ID) {
+
+			Entry edge = heap.top();
+
+			heap.pop();
+
+			if (!visited[std::get<2>(edge)]) {
+
+				curr = std::get<2>(edge);
+
+				mst.Connect(this->labels[std::get<1>(edge)],
+					        this->labels[curr], std::get<0>(edge));
+			}
+		}
+	}
+
+	return mst;
+}
+
+/*
+* Minimum spanning forest using Kruskal's algorithm
+* Edges are sorted once by weight, starting and ending Vertex and added
+* unless both ends are already in the same tree
+* @param forest The EdgeList to fill with the Edges of the forest, each
+* as starting label, ending label and weight, in order of weight
+* @return total weight of the forest
+*/
+FrozenGraph::Weight FrozenGraph::Kruskal(EdgeList& forest) const {
+
+	EdgeKeyList edges, chosen;
+
+	edges.reserve(this->targets.size());
+
+	for (Id id(0); id < this->labels.size(); ++id) {
+
+		for (Id e(this->offsets[id]); e < this->offsets[id + 1]; ++e) {
+
+			edges.emplace_back(this->weights[e], id, this->targets[e]);
+		}
+	}
+
+	std::sort(edges.begin(), edges.end());
+
+	DisjointSets sets(this->labels.size());
+
+	for (const EdgeKey& edge : edges) {
+
+		if (chosen.size() + Graph::COUNT >= this->labels.size()) {
+
+			break;
+		}
+
+		if (sets.unite(std::get<1>(edge), std::get<2>(edge))) {
+
+			chosen.push_back(edge);
+		}
+	}
+
+	return this->labelEdges(chosen, &forest);
+}
+
+/*
+* Minimum spanning forest using Boruvka's algorithm
+* Every round the workers of pool find the cheapest Edge from each Vertex to
+* another component, over outgoing and reversed Edges, then each component
+* adds its cheapest one, which at least halves the number of components
+* @param forest The EdgeList to fill with the Edges of the forest, each
+* as starting label, ending label and weight, in order of weight
+* @param pool The ThreadPool to scan Edges on
+* @return total weight of the forest
+*/
+FrozenGraph::Weight FrozenGraph::Boruvka(EdgeList& forest,
+	                                     ThreadPool& pool) const {
+
+	const EdgeKey none(INT_MAX, FrozenGraph::NO_ID, FrozenGraph::NO_ID);
+
+	std::size_t vertices = this->labels.size();
+
+	DisjointSets sets(vertices);
+	IdList component(vertices);
+	EdgeKeyList cheapest(vertices), best(vertices), chosen;
+
+	for (Id id(0); id < vertices; ++id) {
+
+		component[id] = id;
+	}
+
+	bool merged(vertices > 1);
+
+	while (merged) {
+
+		pool.Run([&](int worker) {
+
+			std::size_t begin, end;
+
+			pool.Split(vertices, worker, &begin, &end);
+
+			for (Id id(static_cast<Id>(begin)); id < end; ++id) {
+
+				EdgeKey edge = none;
+
+				for (Id e(this->offsets[id]); e < this->offsets[id + 1]; ++e) {
+
+					if (component[this->targets[e]] != component[id]) {
+
+						edge = std::min(edge, EdgeKey(this->weights[e], id,
+							                          this->targets[e]));
+					}
+				}
+
+				for (Id r(this->reverseOffsets[id]);
+					 r < this->reverseOffsets[id + 1]; ++r) {
+
+					if (component[this->sources[r]] != component[id]) {
+
+						edge = std::min(edge, EdgeKey(this->reverseWeights[r],
+							                          this->sources[r], id));
+					}
+				}
+
+				cheapest[id] = edge;
+			}
+		});
+
+		best.assign(vertices, none);
+
+		for (Id id(0); id < vertices; ++id) {
+
+			best[component[id]] = std::min(best[component[id]], cheapest[id]);
+		}
+
+		merged = false;
+
+		for (const EdgeKey& edge : best) {
+
+			if (std::get<1>(edge) != FrozenGraph::NO_ID &&
+				sets.unite(std::get<1>(edge), std::get<2>(edge))) {
+
+				chosen.push_back(edge);
+
+				merged = true;
+			}
+		}
+
+		for (Id id(0); id < vertices; ++id) {
+
+			component[id] = sets.find(id);
+		}
+	}
+
+	std::sort(chosen.begin(), chosen.end());
+
+	return this->labelEdges(chosen, &forest);
+}
+
+/*
+* Gets the sum cost of all Edges in FrozenGraph
+* @return sum cost of all Edges in FrozenGraph
+*/
+FrozenGraph::Weight FrozenGraph::SumOfEdges() const {
+
+	Weight sum = Graph::NO_WEIGHT;
+
+	for (const Weight& weight : this->weights) {
+
+		sum += weight;
+	}
+
+	return sum;
+}
+
+/*
+* Gets the id of the Vertex with given label
+* @param label The label of the Vertex
+* @return id of the Vertex, or NO_ID if not found
+*/
+FrozenGraph::Id FrozenGraph::find(const Label& label) const {
+
+	auto it = std::lower_bound(this->labels.begin(), this->labels.end(), label);
+
+	return (it != this->labels.end() && *it == label) ?
+		   static_cast<Id>(it - this->labels.begin()) : FrozenGraph::NO_ID;
+}
+
+/*
+* Helper for BFS, visits the next level along outgoing Edges of the
+* frontier, used while the frontier has fewer than 1 / BOTTOM_UP_ALPHA
+* of the Edges into unvisited Vertices
+* @param frontier The Vertices of the current level
+* @param next The Frontier to add Vertices of the next level to
+* @param visited The Vertices visited so far
+* @param level The depth of the next level
+* @param depth The depths indexed by id
+* @param parent The parents indexed by id
+* @param edges Pointer to store the Edges out of the next level
+* @param unvisited Pointer to the Edges into unvisited Vertices
+*/
+void FrozenGraph::topDown(const Frontier& frontier, Frontier* next,
+	                      Bitmap* visited, const int& level, DepthList* depth,
+	                      IdArray* parent, long long* edges,
+	                      long long* unvisited) const {
+
+	*edges = 0;
+
+	for (const Id& curr : frontier.ids) {
+
+		for (Id e(this->offsets[curr]); e < this->offsets[curr + 1]; ++e) {
+
+			Id end = this->targets[e];
+			std::uint64_t mask = std::uint64_t(1) << end % 64;
+
+			if (!((*visited)[end / 64] & mask)) {
+
+				(*visited)[end / 64] |= mask;
+				next->bits[end / 64] |= mask;
+				next->ids.push_back(end);
+				(*depth)[end] = level;
+				(*parent)[end] = curr;
+
+				*edges += this->offsets[end + 1] - this->offsets[end];
+				*unvisited -= this->reverseOffsets[end + 1] -
+					          this->reverseOffsets[end];
+			}
+		}
+	}
+}
+
+/*
+* Helper for BFS, visits the next level along incoming Edges of
+* unvisited Vertices, used until the frontier drops below
+* 1 / TOP_DOWN_BETA of the Vertices
+* Each unvisited Vertex stops at the first parent found in the frontier,
+* which skips most of the Edges checked top-down when the frontier is large
+* @param frontier The Vertices of the current level
+* @param next The Frontier to add Vertices of the next level to
+* @param visited The Vertices visited so far
+* @param level The depth of the next level
+* @param depth The depths indexed by id
+* @param parent The parents indexed by id
+* @param edges Pointer to store the Edges out of the next level
+* @param unvisited Pointer to the Edges into unvisited Vertices
+*/
+void FrozenGraph::bottomUp(const Frontier& frontier, Frontier* next,
+	                       Bitmap* visited, const int& level, DepthList* depth,
+	                       IdArray* parent, long long* edges,
+	                       long long* unvisited) const {
+
+	*edges = 0;
+
+	for (std::size_t word(0); word < visited->size(); ++word) {
+
+		for (std::uint64_t bits(~(*visited)[word]), bit(0); bits != 0;
+			 bits >>= 1, ++bit) {
+
+			Id curr = static_cast<Id>(word * 64 + bit);
+
+			if (!(bits & 1) || curr >= this->labels.size()) {
+
+				continue;
+			}
+
+			for (Id r(this->reverseOffsets[curr]);
+				 r < this->reverseOffsets[curr + 1]; ++r) {
+
+				Id source = this->sources[r];
+
+				if (frontier.bits[source / 64] &
+					std::uint64_t(1) << source % 64) {
+
+					(*visited)[word] |= std::uint64_t(1) << bit;
+					next->bits[word] |= std::uint64_t(1) << bit;
+					next->ids.push_back(curr);
+					(*depth)[curr] = level;
+					(*parent)[curr] = source;
+
+					*edges += this->offsets[curr + 1] - this->offsets[curr];
+					*unvisited -= this->reverseOffsets[curr + 1] -
+						          this->reverseOffsets[curr];
+
+					break;
+				}
+			}
+		}
+	}
+}
+
+/*
+* Helper for Closeness, Eccentricity and Diameter, breadth-first search
+* from BFS_BATCH origins at a time (MS-BFS)
+* seen holds the origins that reached each Vertex, visit the origins whose
+* search is on the Vertex in this level and next the ones arriving in the
+* next level. Only the Vertices of the current level are scanned and only
+* the Vertices reached by the batch are cleared for the next one
+* @param origins The ids of the origin Vertices, NO_ID ones are skipped
+* @param reached The callable to call with the position of the first
+* origin of the batch, a Vertex id, the bits of the origins that reach
+* it on this level and the level, levels are reported in order
+*/
+template <typename Reached>
+void FrozenGraph::multiSourceBFS(const IdList& origins,
+	                             Reached reached) const {
+
+	std::size_t vertices = this->labels.size();
+
+	Bitmap seen(vertices, 0), visit(vertices, 0), next(vertices, 0);
+	IdList frontier, following, touched;
+
+	for (std::size_t first(0); first < origins.size();
+		 first += FrozenGraph::BFS_BATCH) {
+
+		std::size_t last = std::min(origins.size(),
+			                        first + FrozenGraph::BFS_BATCH);
+
+		for (std::size_t source(first); source < last; ++source) {
+
+			Id id = origins[source];
+
+			if (id == FrozenGraph::NO_ID) {
+
+				continue;
+			}
+
+			if (seen[id] == 0) {
+
+				frontier.push_back(id);
+				touched.push_back(id);
+			}
+
+			seen[id] |= std::uint64_t(1) << (source - first);
+			visit[id] |= std::uint64_t(1) << (source - first);
+		}
+
+		for (const Id& id : frontier) {
+
+			reached(first, id, visit[id], Graph::EMPTY);
+		}
+
+		for (int level(1); !frontier.empty(); ++level) {
+
+			for (const Id& curr : frontier) {
+
+				for (Id e(this->offsets[curr]); e < this->offsets[curr + 1];
+					 ++e) {
+
+					Id end = this->targets[e];
+					std::uint64_t bits = visit[curr] & ~seen[end];
+
+					if (bits != 0) {
+
+						if (seen[end] == 0) {
+
+							touched.push_back(end);
+						}
+
+						if (next[end] == 0) {
+
+							following.push_back(end);
+						}
+
+						next[end] |= bits;
+						seen[end] |= bits;
+					}
+				}
+
+				visit[curr] = 0;
+			}
+
+			for (const Id& id : following) {
+
+				reached(first, id, next[id], level);
+
+				visit[id] = next[id];
+				next[id] = 0;
+			}
+
+			frontier.swap(following);
+			following.clear();
+		}
+
+		for (const Id& id : touched) {
+
+			seen[id] = 0;
+		}
+
+		touched.clear();
+	}
+}
+
+/*
+* Helper for multiSourceBFS, gets the position of the lowest set bit
+* Isolating the bit and multiplying by a de Bruijn sequence puts a unique
+* pattern in the top 6 bits
+* @param bits The bits, not 0
+* @return position of the lowest set bit
+*/
+int FrozenGraph::lowestBit(const std::uint64_t& bits) {
+
+	static const int POSITIONS[64] = {
+		 0,  1, 48,  2, 57, 49, 28,  3, 61, 58, 50, 42, 38, 29, 17,  4,
+		62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12,  5,
+		63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+		46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19,  9, 13,  8,  7,  6
+	};
+
+	return POSITIONS[((bits & (~bits + 1)) * 0x03f79d71b4cb0a89ULL) >> 58];
+}
+
+/*
+* Helper for Dijkstra, resolves AUTO and queues that do not fit the Edge
+* weights to the queue that will be used
+* @param queue The priority queue asked for
+* @return the priority queue to use
+*/
+FrozenGraph::Queue FrozenGraph::select(Queue queue) const {
+
+	bool bounded = this->maxWeight <= FrozenGraph::MAX_BUCKET_WEIGHT,
+		 zeroOne = this->maxWeight <= Graph::COUNT;
+
+	if (queue == Queue::AUTO) {
+
+		queue = (zeroOne) ? Queue::ZERO_ONE :
+			    (bounded) ? Queue::BUCKETS  : Queue::RADIX_HEAP;
+	}
+
+	if (this->minWeight < Graph::NO_WEIGHT ||
+		(queue == Queue::BUCKETS && !bounded) ||
+		(queue == Queue::ZERO_ONE && !zeroOne)) {
+
+		queue = Queue::BINARY_HEAP;
+	}
+
+	return queue;
+}
+
+/*
+* Helper for Dijkstra, shortest paths using a binary heap
+* Ties are settled in label order
+* @param origin The id of the origin Vertex
+* @param dist The distances indexed by id, INT_MAX if not reached
+* @param prev The previous Vertex ids indexed by id
+* @param reverse True to search over reversed Edges, defaults to false
+*/
+void FrozenGraph::binaryHeap(const Id& origin, WeightList* dist, IdList* prev,
+	                         bool reverse) const {
+
+	using Entry = std::pair<Weight, Id>;
+
+	const std::vector<Id>& offsets = (reverse) ? this->reverseOffsets :
+		                                         this->offsets;
+	const std::vector<Id>& ends = (reverse) ? this->sources : this->targets;
+	const std::vector<Weight>& weights = (reverse) ? this->reverseWeights :
+		                                             this->weights;
+
+	VisitedList settled(this->labels.size(), false);
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+	heap.emplace(Graph::NO_WEIGHT, origin);
+
+	while (!heap.empty()) {
+
+		Id curr = heap.top().second;
+
+		heap.pop();
+
+		if (settled[curr]) {
+
+			continue;
+		}
+
+		settled[curr] = true;
+
+		for (Id e(offsets[curr]); e < offsets[curr + 1]; ++e) {
+
+			Id next = ends[e];
+			Weight weight = (*dist)[curr] + weights[e];
+
+			if (!settled[next] && weight < (*dist)[next]) {
+
+				(*dist)[next] = weight;
+				(*prev)[next] = curr;
+
+				heap.emplace(weight, next);
+			}
+		}
+	}
+}
+
+/*
+* Helper for Dijkstra, shortest paths using Dial's circular buckets
+* Tentative distances always lie within maxWeight of the current distance,
+* so bucket d % (maxWeight + 1) only holds entries for distance d
+* @param origin The id of the origin Vertex
+* @param dist The distances indexed by id, INT_MAX if not reached
+* @param prev The previous Vertex ids indexed by id
+*/
+void FrozenGraph::buckets(const Id& origin, WeightList* dist,
+	                      IdList* prev) const {
+
+	VisitedList settled(this->labels.size(), false);
+	std::vector<IdList> buckets(this->maxWeight + 1);
+
+	buckets[0].push_back(origin);
+
+	std::size_t pending(Graph::COUNT);
+
+	for (Weight d(Graph::NO_WEIGHT); pending > 0; ++d) {
+
+		IdList& bucket = buckets[d % buckets.size()];
+
+		while (!bucket.empty()) {
+
+			Id curr = bucket.back();
+
+			bucket.pop_back();
+			--pending;
+
+			if (settled[curr] || (*dist)[curr] != d) {
+
+				continue;
+			}
+
+			settled[curr] = true;
+
+			for (Id e(this->offsets[curr]); e < this->offsets[curr + 1]; ++e) {
+
+				Id next = this->targets[e];
+				Weight weight = d + this->weights[e];
+
+				if (!settled[next] && weight < (*dist)[next]) {
+
+					(*dist)[next] = weight;
+					(*prev)[next] = curr;
+
+					buckets[weight % buckets.size()].push_back(next);
+					++pending;
+				}
+			}
+		}
+	}
+}
+
+/*
+* Helper for Dijkstra, shortest paths using a RadixHeap
+* @param origin The id of the origin Vertex
+* @param dist The distances indexed by id, INT_MAX if not reached
+* @param prev The previous Vertex ids indexed by id
+*/
+void FrozenGraph::radixHeap(const Id& origin, WeightList* dist,
+	                        IdList* prev) const {
+
+	VisitedList settled(this->labels.size(), false);
+	RadixHeap heap;
+
+	heap.push(Graph::NO_WEIGHT, origin);
+
+	while (!heap.empty()) {
+
+		Weight d;
+		Id curr = heap.pop(&d);
+
+		if (settled[curr] || (*dist)[curr] != d) {
+
+			continue;
+		}
+
+		settled[curr] = true;
+
+		for (Id e(this->offsets[curr]); e < this->offsets[curr + 1]; ++e) {
+
+			Id next = this->targets[e];
+			Weight weight = d + this->weights[e];
+
+			if (!settled[next] && weight < (*dist)[next]) {
+
+				(*dist)[next] = weight;
+				(*prev)[next] = curr;
+
+				heap.push(weight, next);
+			}
+		}
+	}
+}
+
+/*
+* Helper for Dijkstra, shortest paths using a double ended queue, Edges of
+* weight 0 go to the front and Edges of weight 1 to the back
+* @param origin The id of the origin Vertex
+* @param dist The distances indexed by id, INT_MAX if not reached
+* @param prev The previous Vertex ids indexed by id
+*/
+void FrozenGraph::zeroOne(const Id& origin, WeightList* dist,
+	                      IdList* prev) const {
+
+	VisitedList settled(this->labels.size(), false);
+	std::deque<Id> q;
+
+	q.push_back(origin);
+
+	while (!q.empty()) {
+
+		Id curr = q.front();
+
+		q.pop_front();
+
+		if (settled[curr]) {
+
+			continue;
+		}
+
+		settled[curr] = true;
+
+		for (Id e(this->offsets[curr]); e < this->offsets[curr + 1]; ++e) {
+
+			Id next = this->targets[e];
+			Weight weight = (*dist)[curr] + this->weights[e];
+
+			if (!settled[next] && weight < (*dist)[next]) {
+
+				(*dist)[next] = weight;
+				(*prev)[next] = curr;
+
+				if (this->weights[e] == Graph::NO_WEIGHT) {
+
+					q.push_front(next);
+
+				} else {
+
+					q.push_back(next);
+				}
+			}
+		}
+	}
+}
+
+/*
+* Helper for DeltaStepping, shortest paths using circular buckets of width
+* delta
+* Tentative distances always lie within maxWeight of the current bucket,
+* so bucket i % (maxWeight / delta + 2) only holds entries for bucket i
+* and entries left from earlier distances of the same Vertices
+* Every relaxation runs in two parallel steps: workers scan their share of
+* the Vertices and post requests sorted by owner (target id % workers), then
+* each worker applies the requests it owns, so no two workers write the
+* same distance
+* @param origin The id of the origin Vertex
+* @param delta The bucket width
+* @param pool The ThreadPool to relax Edges on
+* @param dist The distances indexed by id, INT_MAX if not reached
+* @param prev The previous Vertex ids indexed by id
+*/
+void FrozenGraph::deltaStepping(const Id& origin, const Weight& delta,
+	                            ThreadPool& pool, WeightList* dist,
+	                            IdList* prev) const {
+
+	using Request = std::tuple<Weight, Id, Id>;
+
+	const std::size_t workers = static_cast<std::size_t>(pool.Size());
+
+	std::vector<IdList> buckets(this->maxWeight / delta + 2);
+	std::vector<std::vector<Request>> requests(workers * workers);
+	std::vector<IdList> moved(workers);
+	std::vector<std::size_t> seen(this->labels.size(), SIZE_MAX),
+		                     done(this->labels.size(), SIZE_MAX);
+	IdList frontier, settled;
+	std::size_t round(0), pending(Graph::COUNT);
+
+	buckets[0].push_back(origin);
+
+	std::function<void(const IdList&, bool)> relax =
+		[&](const IdList& ids, bool light) {
+
+		pool.Run([&](int worker) {
+
+			std::size_t begin, end;
+
+			pool.Split(ids.size(), worker, &begin, &end);
+
+			for (std::size_t i(0); i < workers; ++i) {
+
+				requests[worker * workers + i].clear();
+			}
+
+			for (std::size_t i(begin); i < end; ++i) {
+
+				Id curr = ids[i];
+
+				for (Id e(this->offsets[curr]); e < this->offsets[curr + 1];
+					 ++e) {
+
+					Id next = this->targets[e];
+					Weight weight = (*dist)[curr] + this->weights[e];
+
+					if ((this->weights[e] <= delta) == light &&
+						weight < (*dist)[next]) {
+
+						requests[worker * workers + next % workers].emplace_back(
+							weight, next, curr);
+					}
+				}
+			}
+		});
+
+		pool.Run([&](int worker) {
+
+			moved[worker].clear();
+
+			for (std::size_t i(0); i < workers; ++i) {
+
+				for (const Request& request : requests[i * workers + worker]) {
+
+					Id next = std::get<1>(request);
+
+					if (std::get<0>(request) < (*dist)[next]) {
+
+						(*dist)[next] = std::get<0>(request);
+						(*prev)[next] = std::get<2>(request);
+
+						moved[worker].push_back(next);
+					}
+				}
+			}
+		});
+
+		for (const IdList& ids : moved) {
+
+			for (const Id& id : ids) {
+
+				std::size_t bucket = (*dist)[id] / delta;
+
+				buckets[bucket % buckets.size()].push_back(id);
+				++pending;
+			}
+		}
+	};
+
+	for (std::size_t i(0); pending > 0; ++i) {
+
+		IdList& bucket = buckets[i % buckets.size()];
+
+		settled.clear();
+
+		while (!bucket.empty()) {
+
+			++round;
+
+			frontier.clear();
+
+			for (const Id& id : bucket) {
+
+				if (static_cast<std::size_t>((*dist)[id] / delta) == i &&
+					seen[id] != round) {
+
+					seen[id] = round;
+
+					frontier.push_back(id);
+
+					if (done[id] != i) {
+
+						done[id] = i;
+
+						settled.push_back(id);
+					}
+				}
+			}
+
+			pending -= bucket.size();
+
+			bucket.clear();
+
+			relax(frontier, true);
+		}
+
+		if (!settled.empty()) {
+
+			relax(settled, false);
+		}
+	}
+}
+
+/*
+* Helper for ShortestPath, bidirectional Dijkstra between two Vertices
+* Each step advances the search whose closest unsettled Vertex is nearer,
+* every scanned Edge reaching a Vertex seen by the other search is a
+* candidate path, and the searches stop once the two closest unsettled
+* Vertices together cost at least the best candidate
+* @param from The id of the origin Vertex
+* @param to The id of the destination Vertex
+* @param prev The previous Vertex ids of the forward search
+* @param next The next Vertex ids of the backward search
+* @param meet Pointer to store the Edge where both searches meet
+* @return cost of the shortest path, INT_MAX if there is no path
+*/
+FrozenGraph::Weight FrozenGraph::bidirectional(const Id& from, const Id& to,
+	                                           IdList* prev, IdList* next,
+	                                           std::pair<Id, Id>* meet) const {
+
+	using Entry = std::pair<Weight, Id>;
+	using Heap  = std::priority_queue<Entry, std::vector<Entry>,
+		                              std::greater<Entry>>;
+
+	WeightList distF(this->labels.size(), INT_MAX),
+		       distB(this->labels.size(), INT_MAX);
+	VisitedList doneF(this->labels.size(), false),
+		        doneB(this->labels.size(), false);
+	Heap heapF, heapB;
+
+	long long best = (from == to) ? Graph::NO_WEIGHT : INT_MAX;
+
+	*meet = std::make_pair(to, to);
+
+	distF[from] = Graph::NO_WEIGHT;
+	distB[to] = Graph::NO_WEIGHT;
+	heapF.emplace(Graph::NO_WEIGHT, from);
+	heapB.emplace(Graph::NO_WEIGHT, to);
+
+	while (!heapF.empty() && !heapB.empty() &&
+		   static_cast<long long>(heapF.top().first) + heapB.top().first < best) {
+
+		bool forward = heapF.top().first <= heapB.top().first;
+
+		Heap& heap = (forward) ? heapF : heapB;
+		WeightList& dist = (forward) ? distF : distB;
+		WeightList& other = (forward) ? distB : distF;
+		VisitedList& done = (forward) ? doneF : doneB;
+		IdList& links = (forward) ? *prev : *next;
+		const std::vector<Id>& offsets = (forward) ? this->offsets :
+			                                         this->reverseOffsets;
+		const std::vector<Id>& ends = (forward) ? this->targets : this->sources;
+		const std::vector<Weight>& weights = (forward) ? this->weights :
+			                                             this->reverseWeights;
+
+		Id curr = heap.top().second;
+
+		heap.pop();
+
+		if (done[curr]) {
+
+			continue;
+		}
+
+		done[curr] = true;
+
+		for (Id e(offsets[curr]); e < offsets[curr + 1]; ++e) {
+
+			Id end = ends[e];
+			Weight weight = dist[curr] + weights[e];
+
+			if (!done[end] && weight < dist[end]) {
+
+				dist[end] = weight;
+				links[end] = curr;
+
+				heap.emplace(weight, end);
+			}
+
+			if (other[end] != INT_MAX &&
+				static_cast<long long>(weight) + other[end] < best) {
+
+				best = static_cast<long long>(weight) + other[end];
+
+				*meet = (forward) ? std::make_pair(curr, end) :
+					                std::make_pair(end, curr);
+			}
+		}
+	}
+
+	return (best < INT_MAX) ? static_cast<Weight>(best) : INT_MAX;
+}
+
+/*
+* Helper for AStar, finds the path once labels are resolved to ids
+* Vertices are ordered by cost so far plus estimate, estimates are computed
+* once per Vertex, and a Vertex is searched again if a cheaper path to it is
+* found later, which keeps inconsistent heuristics correct
+* @param from The id of the origin Vertex
+* @param to The id of the destination Vertex
+* @param estimate Estimates the cost from a Vertex id to the destination
+* @param path The Path to fill
+* @return cost of the shortest path, INT_MAX if there is no path
+*/
+FrozenGraph::Weight FrozenGraph::aStar(const Id& from, const Id& to,
+	                                   const Estimate& estimate,
+	                                   Path* path) const {
+
+	using Entry = std::pair<long long, Id>;
+
+	WeightList dist(this->labels.size(), INT_MAX);
+	IdList prev(this->labels.size(), FrozenGraph::NO_ID);
+
+	dist[from] = Graph::NO_WEIGHT;
+
+	if (this->minWeight < Graph::NO_WEIGHT) {
+
+		this->binaryHeap(from, &dist, &prev);
+
+	} else {
+
+		WeightList guess(this->labels.size(), INT_MIN);
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+		guess[from] = estimate(from);
+		heap.emplace(guess[from], from);
+
+		while (!heap.empty() && heap.top().second != to) {
+
+			Id curr = heap.top().second;
+			long long key = heap.top().first;
+
+			heap.pop();
+
+			if (key != static_cast<long long>(dist[curr]) + guess[curr]) {
+
+				continue;
+			}
+
+			for (Id e(this->offsets[curr]); e < this->offsets[curr + 1]; ++e) {
+
+				Id next = this->targets[e];
+				Weight weight = dist[curr] + this->weights[e];
+
+				if (weight < dist[next]) {
+
+					if (guess[next] == INT_MIN) {
+
+						guess[next] = estimate(next);
+					}
+
+					dist[next] = weight;
+					prev[next] = curr;
+
+					heap.emplace(static_cast<long long>(weight) + guess[next],
+						         next);
+				}
+			}
+		}
+	}
+
+	if (dist[to] != INT_MAX) {
+
+		this->trace(std::make_pair(to, to), prev, prev, path);
+	}
+
+	return dist[to];
+}
+
+/*
+* Helper for ShortestPath, gets labels of the path through an Edge
+* @param meet The Edge on the path, or the last Vertex twice
+* @param prev The previous Vertex ids leading to the Edge
+* @param next The next Vertex ids leading away from the Edge
+* @param path The Path to fill
+*/
+void FrozenGraph::trace(const std::pair<Id, Id>& meet, const IdList& prev,
+	                    const IdList& next, Path* path) const {
+
+	for (Id id(meet.first); id != FrozenGraph::NO_ID; id = prev[id]) {
+
+		path->push_back(this->labels[id]);
+	}
+
+	std::reverse(path->begin(), path->end());
+
+	if (meet.second != meet.first) {
+
+		for (Id id(meet.second); id != FrozenGraph::NO_ID; id = next[id]) {
+
+			path->push_back(this->labels[id]);
+		}
+	}
+}
+
+/*
+* Helper for Kruskal and Boruvka, gets labels of the forest Edges
+* @param edges The Edges of the forest as weight and Vertex ids
+* @param forest The EdgeList to fill
+* @return total weight of the Edges
+*/
+FrozenGraph::Weight FrozenGraph::labelEdges(const EdgeKeyList& edges,
+	                                        EdgeList* forest) const {
+
+	Weight sum = Graph::NO_WEIGHT;
+
+	forest->clear();
+	forest->reserve(edges.size());
+
+	for (const EdgeKey& edge : edges) {
+
+		forest->emplace_back(this->labels[std::get<1>(edge)],
+			                 this->labels[std::get<2>(edge)], std::get<0>(edge));
+
+		sum += std::get<0>(edge);
+	}
+
+	return sum;
+}
+
+/*
+* Helper for Dijkstra, records reached Vertices in WeightMap and PrevMap
+* leaving out the origin and Vertices with a path of cost 0 in the WeightMap
+* @param origin The id of the origin Vertex
+* @param dist The distances indexed by id
+* @param prev The previous Vertex ids indexed by id
+* @param wMap The WeightMap
+* @param pMap The PrevMap
+*/
+void FrozenGraph::record(const Id& origin, const WeightList& dist,
+	                     const IdList& prev, WeightMap* wMap,
+	                     PrevMap* pMap) const {
+
+	for (Id id(0); id < this->labels.size(); ++id) {
+
+		if (id != origin && dist[id] != INT_MAX) {
+
+			if (dist[id] != Graph::NO_WEIGHT) {
+
+				(*wMap)[this->labels[id]] = dist[id];
+			}
+
+			(*pMap)[this->labels[id]] = this->labels[prev[id]];
+		}
+	}
+}
+
+/*
+* Constructs empty RadixHeap
+*/
+FrozenGraph::RadixHeap::RadixHeap() :last(0), size(0) {}
+
+/*
+* Returns true if RadixHeap has no entries, else false
+* @return true if RadixHeap has no entries, else false
+*/
+bool FrozenGraph::RadixHeap::empty() const {
+
+	return this->size == 0;
+}
+
+/*
+* Adds an entry
+* @param key The key of the entry, not smaller than the last popped
+* @param id The Vertex id of the entry
+*/
+void FrozenGraph::RadixHeap::push(const Weight& key, const Id& id) {
+
+	std::uint32_t k = static_cast<std::uint32_t>(key);
+
+	this->buckets[this->bucket(k)].emplace_back(k, id);
+
+	++this->size;
+}
+
+/*
+* Removes an entry with the smallest key
+* When bucket 0 is empty the first non-empty bucket is redistributed around
+* its smallest key, which moves every entry down at least one bucket
+* @param key Pointer to store the key of the entry
+* @return Vertex id of the entry
+*/
+FrozenGraph::Id FrozenGraph::RadixHeap::pop(Weight* key) {
+
+	if (this->buckets[0].empty()) {
+
+		int i(1);
+
+		while (this->buckets[i].empty()) {
+
+			++i;
+		}
+
+		Bucket moved;
+
+		moved.swap(this->buckets[i]);
+
+		this->last = std::min_element(moved.begin(), moved.end())->first;
+
+		for (const Entry& entry : moved) {
+
+			this->buckets[this->bucket(entry.first)].push_back(entry);
+		}
+	}
+
+	Entry entry = this->buckets[0].back();
+
+	this->buckets[0].pop_back();
+
+	--this->size;
+
+	*key = static_cast<Weight>(entry.first);
+
+	return entry.second;
+}
+
+/*
+* Gets the bucket for a key, the number of bits in key ^ last
+* @param key The key of the entry
+* @return index of the bucket
+*/
+int FrozenGraph::RadixHeap::bucket(const std::uint32_t& key) const {
+
+	std::uint32_t bits = key ^ this->last;
+
+	int index(0);
+
+	for (int shift(16); shift > 0; shift /= 2) {
+
+		if (bits >> shift) {
+
+			bits >>= shift;
+			index += shift;
+		}
+	}
+
+	return index + static_cast<int>(bits);
+}
+
+/*
+* Constructs DisjointSets with every Vertex in its own set
+* @param size The number of Vertices
+*/
+FrozenGraph::DisjointSets::DisjointSets(std::size_t size)
+
+	:parent(size), size(size, Graph::COUNT) {
+
+	for (Id id(0); id < size; ++id) {
+
+		this->parent[id] = id;
+	}
+}
+
+/*
+* Gets the representative of the set of a Vertex, every Vertex on the way
+* is pointed at its grandparent
+* @param id The id of the Vertex
+* @return id of the representative
+*/
+FrozenGraph::Id FrozenGraph::DisjointSets::find(Id id) {
+
+	while (this->parent[id] != id) {
+
+		this->parent[id] = this->parent[this->parent[id]];
+
+		id = this->parent[id];
+	}
+
+	return id;
+}
+
+/*
+* Merges the sets of two Vertices, the smaller set goes under the larger
+* @param a The id of a Vertex
+* @param b The id of another Vertex
+* @return true if they were in different sets, else false
+*/
+bool FrozenGraph::DisjointSets::unite(const Id& a, const Id& b) {
+
+	Id rootA = this->find(a),
+	   rootB = this->find(b);
+
+	if (rootA == rootB) {
+
+		return false;
+	}
+
+	if (this->size[rootA] < this->size[rootB]) {
+
+		std::swap(rootA, rootB);
+	}
+
+	this->parent[rootB] = rootA;
+	this->size[rootA] += this->size[rootB];
+
+	return true;
+}
@@ -0,0 +1,605 @@
+/*
+* frozengraph.h
+*
+* Interface/specifications for FrozenGraph class
+*
+* @author Juan Arias
+*
+*/
+
+#ifndef FROZENGRAPH_H
+#define FROZENGRAPH_H
+
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <vector>
+#include "graph.h"
+
+class ThreadPool;
+class Landmarks;
+
+/*
+* A FrozenGraph is an immutable snapshot of a Graph.
+* Vertices are given dense ids in label order and all Edges are packed into
+* compressed-sparse-row arrays, so traversals walk contiguous memory
+* instead of chasing adjacency list pointers.
+* Queries have the same semantics as the matching Graph queries.
+*/
+class FrozenGraph {
+
+public:
+
+	/* Type definitions */
+	using Label     = Graph::Label;
+	using Weight    = Graph::Weight;
+	using Visit     = Graph::Visit;
+	using WeightMap = Graph::WeightMap;
+	using PrevMap   = Graph::PrevMap;
+	using Id        = Graph::Id;
+	using Path      = Graph::Path;
+	using Edge      = std::tuple<Label, Label, Weight>;
+	using EdgeList  = std::vector<Edge>;
+	using DepthList = std::vector<int>;
+	using IdArray   = std::vector<Id>;
+	using ScoreList = std::vector<double>;
+	using Heuristic = std::function<Weight(const Label&, const Label&)>;
+
+	/*
+	* Priority queue used by Dijkstra
+	* BINARY_HEAP works for any weights, BUCKETS (Dial's algorithm) for
+	* weights up to MAX_BUCKET_WEIGHT, RADIX_HEAP for non-negative weights and
+	* ZERO_ONE (0-1 BFS) for weights of only 0 and 1
+	* AUTO picks the cheapest queue that fits the Edge weights
+	*/
+	enum class Queue { AUTO, BINARY_HEAP, BUCKETS, RADIX_HEAP, ZERO_ONE };
+
+	/* Constants for reuse with meaning */
+	static const Id     NO_ID;
+	static const Weight MAX_BUCKET_WEIGHT;
+	static const int    NO_DEPTH;
+
+	/*
+	* Constructs snapshot of a Graph
+	* @param graph The Graph to snapshot
+	*/
+	explicit FrozenGraph(const Graph& graph);
+
+	/*
+	* Get the total number of Vertices in FrozenGraph
+	* @return total number of Vertices in FrozenGraph
+	*/
+	int NumberOfVertices() const;
+
+	/*
+	* Get the total number of Edges in FrozenGraph
+	* @return total number of Edges in FrozenGraph
+	*/
+	int NumberOfEdges() const;
+
+	/*
+	* Get the number of Edges connected to a given Vertex
+	* @param label The label of the Vertex
+	* @return number of edges from Vertex, -1 if Vertex not found
+	*/
+	int NumberOfEdges(const Label& label) const;
+
+	/*
+	* Gets the id of a Vertex, ids are positions in label order
+	* @param label The label of the Vertex
+	* @return id of the Vertex, NO_ID if Vertex not found
+	*/
+	Id GetId(const Label& label) const;
+
+	/*
+	* Gets the label of a Vertex
+	* @param id The id of the Vertex, less than NumberOfVertices()
+	* @return label of the Vertex
+	*/
+	const Label& GetLabel(const Id& id) const;
+
+	/*
+	* Check is Vertex exists in FrozenGraph
+	* @param label The label of the vertex to find
+	* @return true if Vertex in FrozenGraph, else false
+	*/
+	bool HasVertex(const Label& label) const;
+
+	/*
+	* String representation of Edges from a given Vertex
+	* @param label The label of the Vertex to get Edges from
+	* @return string representing Edges and weights, "" if Vertex not found
+	*/
+	std::string GetEdges(const Label& label) const;
+
+	/*
+	* Depth-first traversal originating from Vertex with given label
+	* @param label The origin Vertex label
+	* @param func The function to call on each Vertex label
+	*/
+	void DFS(const Label& label, Visit func) const;
+
+	/*
+	* Breadth-first traversal originating from Vertex with given label
+	* @param label The origin Vertex label
+	* @param func The function to call on each Vertex label
+	*/
+	void BFS(const Label& label, Visit func) const;
+
+	/*
+	* Direction-optimizing breadth-first search from Vertex with given label
+	* Each level either expands the frontier along outgoing Edges (top-down)
+	* or has every unvisited Vertex look for a parent in the frontier along
+	* its incoming Edges (bottom-up), whichever has fewer Edges to check
+	* @param label The origin Vertex label
+	* @param depth The DepthList to fill with the number of Edges from the
+	* origin to each Vertex by id, NO_DEPTH if not reached
+	* @param parent The IdArray to fill with the previous Vertex of each
+	* Vertex by id, the origin is its own parent, NO_ID if not reached
+	*/
+	void BFS(const Label& label, DepthList& depth, IdArray& parent) const;
+
+	/*
+	* Closeness centrality of Vertices along outgoing Edges, ignoring weights
+	* With r Vertices reached out of n, including the Vertex itself, and s
+	* the sum of their depths, closeness is (r - 1) / (n - 1) * (r - 1) / s,
+	* which scales down Vertices that reach few others (Wasserman and Faust)
+	* @param sources The labels of the Vertices
+	* @param closeness The ScoreList to fill with the closeness of each
+	* source by position, 0 if it reaches no other Vertex or is not found
+	*/
+	void Closeness(const Path& sources, ScoreList& closeness) const;
+
+	/*
+	* Eccentricity of Vertices along outgoing Edges, ignoring weights
+	* @param sources The labels of the Vertices
+	* @param eccentricity The DepthList to fill with the largest depth of a
+	* Vertex reached from each source by position, NO_DEPTH if not found
+	*/
+	void Eccentricity(const Path& sources, DepthList& eccentricity) const;
+
+	/*
+	* Diameter of FrozenGraph along outgoing Edges, ignoring weights
+	* @return largest eccentricity of any Vertex, 0 if there are no Edges
+	*/
+	int Diameter() const;
+
+	/*
+	* Dijkstra's algorithm to find shortest distance to all other Vertices
+	* and the path to all other Vertices, see Graph::Dijkstra
+	* Falls back to BINARY_HEAP if the Edge weights do not fit the queue
+	* When several shortest paths exist the recorded previous Vertex may
+	* depend on the queue
+	* @param label The label of the origin Vertex
+	* @param wMap The map to record shortest path
+	* @param pMap The map to record previous Vertex
+	* @param queue The priority queue to use, defaults to AUTO
+	*/
+	void Dijkstra(const Label& label, WeightMap& wMap, PrevMap& pMap,
+		          Queue queue = Queue::AUTO) const;
+
+	/*
+	* Parallel delta-stepping alternative to Dijkstra with the same results
+	* Distances are grouped in buckets of width delta, each bucket relaxes
+	* its light Edges (weight <= delta) until it empties and then its heavy
+	* Edges once, with relaxations split between the workers of pool
+	* Falls back to Dijkstra with BINARY_HEAP for negative weights
+	* When several shortest paths exist the recorded previous Vertex may
+	* differ from Dijkstra
+	* @param label The label of the origin Vertex
+	* @param wMap The map to record shortest path
+	* @param pMap The map to record previous Vertex
+	* @param pool The ThreadPool to relax Edges on
+	* @param delta The bucket width, picked from the Edge weights if <= 0,
+	* raised to at least the largest weight over the number of Vertices so
+	* the buckets stay within one per Vertex
+	*/
+	void DeltaStepping(const Label& label, WeightMap& wMap, PrevMap& pMap,
+		               ThreadPool& pool, Weight delta = 0) const;
+
+	/*
+	* Shortest path between two Vertices using bidirectional Dijkstra
+	* A forward search from the origin and a backward search over reversed
+	* Edges from the destination stop as soon as no shorter path can exist
+	* Falls back to a single forward search for negative weights
+	* @param from The label of the origin Vertex
+	* @param to The label of the destination Vertex
+	* @param path The Path to fill with labels from origin to destination,
+	* empty if there is no path
+	* @return cost of the shortest path, INT_MAX if there is no path
+	*/
+	Weight ShortestPath(const Label& from, const Label& to, Path& path) const;
+
+	/*
+	* Shortest path between two Vertices using A* search
+	* The heuristic must never overestimate the cost from a Vertex to the
+	* destination, it does not need to be consistent
+	* Falls back to a Dijkstra search for negative weights
+	* @param from The label of the origin Vertex
+	* @param to The label of the destination Vertex
+	* @param heuristic Estimates the cost from a Vertex (first label) to the
+	* destination (second label)
+	* @param path The Path to fill with labels from origin to destination,
+	* empty if there is no path
+	* @return cost of the shortest path, INT_MAX if there is no path
+	*/
+	Weight AStar(const Label& from, const Label& to, const Heuristic& heuristic,
+		         Path& path) const;
+
+	/*
+	* Shortest path between two Vertices using A* search with heuristics
+	* derived from Landmarks by the triangle inequality (ALT)
+	* @param from The label of the origin Vertex
+	* @param to The label of the destination Vertex
+	* @param landmarks The Landmarks preprocessed on this FrozenGraph
+	* @param path The Path to fill with labels from origin to destination,
+	* empty if there is no path
+	* @return cost of the shortest path, INT_MAX if there is no path
+	*/
+	Weight AStar(const Label& from, const Label& to, const Landmarks& landmarks,
+		         Path& path) const;
+
+	/*
+	* Creates a MinSpanningTree using Prim's algorithm
+	* @param label The label of the origin Vertex
+	* @return a Graph of the MinSpanningTree
+	*/
+	Graph MinSpanningTree(const Label& label) const;
+
+	/*
+	* Minimum spanning forest using Kruskal's algorithm
+	* Edges are treated as undirected and ties are broken by starting and
+	* ending Vertex, so the forest is the same as Boruvka's
+	* @param forest The EdgeList to fill with the Edges of the forest, each
+	* as starting label, ending label and weight, in order of weight
+	* @return total weight of the forest
+	*/
+	Weight Kruskal(EdgeList& forest) const;
+
+	/*
+	* Minimum spanning forest using Boruvka's algorithm, see Kruskal
+	* Every round each component picks its cheapest Edge to another
+	* component, the Edges of each Vertex are scanned by the workers of pool
+	* @param forest The EdgeList to fill with the Edges of the forest, each
+	* as starting label, ending label and weight, in order of weight
+	* @param pool The ThreadPool to scan Edges on
+	* @return total weight of the forest
+	*/
+	Weight Boruvka(EdgeList& forest, ThreadPool& pool) const;
+
+	/*
+	* Gets the sum cost of all Edges in FrozenGraph
+	* @return sum cost of all Edges in FrozenGraph
+	*/
+	Weight SumOfEdges() const;
+
+private:
+
+	/* Landmarks runs searches over the packed Edges */
+	friend class Landmarks;
+
+	/* ContractionHierarchy contracts the packed Edges */
+	friend class ContractionHierarchy;
+
+	/* Type definitions */
+	using Estimate    = std::function<Weight(const Id&)>;
+	using IdList      = std::vector<Id>;
+	using WeightList  = std::vector<Weight>;
+	using VisitedList = std::vector<bool>;
+	using EdgeKey     = std::tuple<Weight, Id, Id>;
+	using EdgeKeyList = std::vector<EdgeKey>;
+	using Bitmap      = std::vector<std::uint64_t>;
+
+	/*
+	* Level of a breadth-first search, as a Bitmap for bottom-up steps and
+	* as a list of ids for top-down steps
+	*/
+	struct Frontier {
+
+		/* One bit per Vertex id, set for Vertices on the level */
+		Bitmap bits;
+
+		/* Ids of the Vertices on the level */
+		IdList ids;
+	};
+
+	/* Tuning of BFS, see topDown and bottomUp */
+	static const int BOTTOM_UP_ALPHA;
+	static const int TOP_DOWN_BETA;
+
+	/* Number of sources searched together by multiSourceBFS, one per bit */
+	static const int BFS_BATCH;
+
+	/*
+	* Private RadixHeap class of FrozenGraph
+	* Monotone priority queue of non-negative keys, keys pushed must not be
+	* smaller than the last key popped
+	*/
+	class RadixHeap {
+
+	public:
+
+		/*
+		* Constructs empty RadixHeap
+		*/
+		RadixHeap();
+
+		/*
+		* Returns true if RadixHeap has no entries, else false
+		* @return true if RadixHeap has no entries, else false
+		*/
+		bool empty() const;
+
+		/*
+		* Adds an entry
+		* @param key The key of the entry, not smaller than the last popped
+		* @param id The Vertex id of the entry
+		*/
+		void push(const Weight& key, const Id& id);
+
+		/*
+		* Removes an entry with the smallest key
+		* @param key Pointer to store the key of the entry
+		* @return Vertex id of the entry
+		*/
+		Id pop(Weight* key);
+
+	private:
+
+		/* Type definitions */
+		using Entry  = std::pair<std::uint32_t, Id>;
+		using Bucket = std::vector<Entry>;
+
+		/* Number of buckets, one per bit of a key plus one */
+		static const int BUCKETS = 33;
+
+		/* Bucket i holds keys whose highest bit differing from last is i - 1 */
+		Bucket buckets[BUCKETS];
+
+		/* Last key popped */
+		std::uint32_t last;
+
+		/* Number of entries */
+		std::size_t size;
+
+		/*
+		* Gets the bucket for a key
+		* @param key The key of the entry
+		* @return index of the bucket
+		*/
+		int bucket(const std::uint32_t& key) const;
+	};
+
+	/*
+	* Private DisjointSets class of FrozenGraph
+	* Union-find over Vertex ids with union by size and path halving
+	*/
+	class DisjointSets {
+
+	public:
+
+		/*
+		* Constructs DisjointSets with every Vertex in its own set
+		* @param size The number of Vertices
+		*/
+		explicit DisjointSets(std::size_t size);
+
+		/*
+		* Gets the representative of the set of a Vertex
+		* @param id The id of the Vertex
+		* @return id of the representative
+		*/
+		Id find(Id id);
+
+		/*
+		* Merges the sets of two Vertices
+		* @param a The id of a Vertex
+		* @param b The id of another Vertex
+		* @return true if they were in different sets, else false
+		*/
+		bool unite(const Id& a, const Id& b);
+
+	private:
+
+		/* Parent of each Vertex, representatives are their own parent */
+		IdList parent;
+
+		/* Number of Vertices in the set of each representative */
+		IdList size;
+	};
+
+	/* Vertex labels indexed by id, sorted */
+	std::vector<Label> labels;
+
+	/* Edges of Vertex id are in [offsets[id], offsets[id + 1]) */
+	std::vector<Id> offsets;
+
+	/* Ending Vertex id of each Edge */
+	std::vector<Id> targets;
+
+	/* Weight of each Edge */
+	std::vector<Weight> weights;
+
+	/* Edges into Vertex id are in [reverseOffsets[id], reverseOffsets[id + 1])*/
+	std::vector<Id> reverseOffsets;
+
+	/* Starting Vertex id of each reversed Edge */
+	std::vector<Id> sources;
+
+	/* Weight of each reversed Edge */
+	std::vector<Weight> reverseWeights;
+
+	/* Smallest Edge weight, 0 if there are no Edges */
+	Weight minWeight;
+
+	/* Largest Edge weight, 0 if there are no Edges */
+	Weight maxWeight;
+
+	/*
+	* Gets the id of the Vertex with given label
+	* @param label The label of the Vertex
+	* @return id of the Vertex, or NO_ID if not found
+	*/
+	Id find(const Label& label) const;
+
+	/*
+	* Helper for BFS, visits the next level along outgoing Edges of the
+	* frontier, used while the frontier has fewer than 1 / BOTTOM_UP_ALPHA
+	* of the Edges into unvisited Vertices
+	* @param frontier The Vertices of the current level
+	* @param next The Frontier to add Vertices of the next level to
+	* @param visited The Vertices visited so far
+	* @param level The depth of the next level
+	* @param depth The depths indexed by id
+	* @param parent The parents indexed by id
+	* @param edges Pointer to store the Edges out of the next level
+	* @param unvisited Pointer to the Edges into unvisited Vertices
+	*/
+	void topDown(const Frontier& frontier, Frontier* next, Bitmap* visited,
+		         const int& level, DepthList* depth, IdArray* parent,
+		         long long* edges, long long* unvisited) const;
+
+	/*
+	* Helper for BFS, visits the next level along incoming Edges of
+	* unvisited Vertices, used until the frontier drops below
+	* 1 / TOP_DOWN_BETA of the Vertices
+	* @param frontier The Vertices of the current level
+	* @param next The Frontier to add Vertices of the next level to
+	* @param visited The Vertices visited so far
+	* @param level The depth of the next level
+	* @param depth The depths indexed by id
+	* @param parent The parents indexed by id
+	* @param edges Pointer to store the Edges out of the next level
+	* @param unvisited Pointer to the Edges into unvisited Vertices
+	*/
+	void bottomUp(const Frontier& frontier, Frontier* next, Bitmap* visited,
+		          const int& level, DepthList* depth, IdArray* parent,
+		          long long* edges, long long* unvisited) const;
+
+	/*
+	* Helper for Closeness, Eccentricity and Diameter, breadth-first search
+	* from BFS_BATCH origins at a time, each Vertex keeps one bit per origin
+	* so a single scan of its Edges moves every search that reached it
+	* @param origins The ids of the origin Vertices, NO_ID ones are skipped
+	* @param reached The callable to call with the position of the first
+	* origin of the batch, a Vertex id, the bits of the origins that reach
+	* it on this level and the level, levels are reported in order
+	*/
+	template <typename Reached>
+	void multiSourceBFS(const IdList& origins, Reached reached) const;
+
+	/*
+	* Helper for multiSourceBFS, gets the position of the lowest set bit
+	* @param bits The bits, not 0
+	* @return position of the lowest set bit
+	*/
+	static int lowestBit(const std::uint64_t& bits);
+
+	/*
+	* Helper for Dijkstra, resolves AUTO and queues that do not fit the Edge
+	* weights to the queue that will be used
+	* @param queue The priority queue asked for
+	* @return the priority queue to use
+	*/
+	Queue select(Queue queue) const;
+
+	/*
+	* Helper for Dijkstra, shortest paths using a binary heap
+	* @param origin The id of the origin Vertex
+	* @param dist The distances indexed by id, INT_MAX if not reached
+	* @param prev The previous Vertex ids indexed by id
+	* @param reverse True to search over reversed Edges, defaults to false
+	*/
+	void binaryHeap(const Id& origin, WeightList* dist, IdList* prev,
+		            bool reverse = false) const;
+
+	/*
+	* Helper for Dijkstra, shortest paths using Dial's circular buckets
+	* @param origin The id of the origin Vertex
+	* @param dist The distances indexed by id, INT_MAX if not reached
+	* @param prev The previous Vertex ids indexed by id
+	*/
+	void buckets(const Id& origin, WeightList* dist, IdList* prev) const;
+
+	/*
+	* Helper for Dijkstra, shortest paths using a RadixHeap
+	* @param origin The id of the origin Vertex
+	* @param dist The distances indexed by id, INT_MAX if not reached
+	* @param prev The previous Vertex ids indexed by id
+	*/
+	void radixHeap(const Id& origin, WeightList* dist, IdList* prev) const;
+
+	/*
+	* Helper for Dijkstra, shortest paths using a double ended queue, Edges of
+	* weight 0 go to the front and Edges of weight 1 to the back
+	* @param origin The id of the origin Vertex
+	* @param dist The distances indexed by id, INT_MAX if not reached
+	* @param prev The previous Vertex ids indexed by id
+	*/
+	void zeroOne(const Id& origin, WeightList* dist, IdList* prev) const;
+
+	/*
+	* Helper for DeltaStepping, shortest paths using buckets of width delta
+	* @param origin The id of the origin Vertex
+	* @param delta The bucket width
+	* @param pool The ThreadPool to relax Edges on
+	* @param dist The distances indexed by id, INT_MAX if not reached
+	* @param prev The previous Vertex ids indexed by id
+	*/
+	void deltaStepping(const Id& origin, const Weight& delta, ThreadPool& pool,
+		               WeightList* dist, IdList* prev) const;
+
+	/*
+	* Helper for ShortestPath, bidirectional Dijkstra between two Vertices
+	* @param from The id of the origin Vertex
+	* @param to The id of the destination Vertex
+	* @param prev The previous Vertex ids of the forward search
+	* @param next The next Vertex ids of the backward search
+	* @param meet Pointer to store the Edge where both searches meet
+	* @return cost of the shortest path, INT_MAX if there is no path
+	*/
+	Weight bidirectional(const Id& from, const Id& to, IdList* prev,
+		                 IdList* next, std::pair<Id, Id>* meet) const;
+
+	/*
+	* Helper for AStar, finds the path once labels are resolved to ids
+	* @param from The id of the origin Vertex
+	* @param to The id of the destination Vertex
+	* @param estimate Estimates the cost from a Vertex id to the destination
+	* @param path The Path to fill
+	* @return cost of the shortest path, INT_MAX if there is no path
+	*/
+	Weight aStar(const Id& from, const Id& to, const Estimate& estimate,
+		         Path* path) const;
+
+	/*
+	* Helper for ShortestPath, gets labels of the path through an Edge
+	* @param meet The Edge on the path, or the last Vertex twice
+	* @param prev The previous Vertex ids leading to the Edge
+	* @param next The next Vertex ids leading away from the Edge
+	* @param path The Path to fill
+	*/
+	void trace(const std::pair<Id, Id>& meet, const IdList& prev,
+		       const IdList& next, Path* path) const;
+
+	/*
+	* Helper for Kruskal and Boruvka, gets labels of the forest Edges
+	* @param edges The Edges of the forest as weight and Vertex ids
+	* @param forest The EdgeList to fill
+	* @return total weight of the Edges
+	*/
+	Weight labelEdges(const EdgeKeyList& edges, EdgeList* forest) const;
+
+	/*
+	* Helper for Dijkstra, records reached Vertices in WeightMap and PrevMap
+	* leaving out the origin and Vertices with a path of cost 0 in the WeightMap
+	* @param origin The id of the origin Vertex
+	* @param dist The distances indexed by id
+	* @param prev The previous Vertex ids indexed by id
+	* @param wMap The WeightMap
+	* @param pMap The PrevMap
+	*/
+	void record(const Id& origin, const WeightList& dist, const IdList& prev,
+		        WeightMap* wMap, PrevMap* pMap) const;
+};
+#endif  // FROZENGRAPH_H
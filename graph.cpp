@@ -7,29 +7,44 @@
 *
 */
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <new>
+#include "filereader.h"
 #include "graph.h"
+#include "snapshot.h"
+#include "threadpool.h"
+#include "writer.h"
 
 /* Constant definition*/
 const Graph::Label  Graph::NO_LABEL("");
+const Graph::Id     Graph::NO_ID(UINT32_MAX);
 const Graph::Weight Graph::NO_WEIGHT(0);
 const int           Graph::EMPTY(0);
 const int           Graph::COUNT(1);
 const char          Graph::COMMA(',');
 const char          Graph::LEFT_P('(');
 const char          Graph::RIGHT_P(')');
+const std::size_t   Graph::EdgeArena::SLAB_SIZE(1 << 16);
+const std::size_t   Graph::EdgeArena::FIRST_SIZE(64);
 
 /*
 * Friend function to print Graph to ostream
+* Lines are formatted into the buffer of a Writer, see Writer::ADJACENCY
 * @param out The ostream to print to Graph
 * @param g The Graph to be printed
 * @return out by reference
 */
 std::ostream & operator<<(std::ostream& out, const Graph& g) {
 
-	for (const Graph::LabelVert& pair : g.map) {
-	
-		out << pair.first << ": " << pair.second->getEdges() << std::endl;
-	}
+	Writer writer(out);
+
+	writer.Write(g, Writer::Format::ADJACENCY);
 
 	return out;
 }
@@ -38,17 +53,32 @@ std::ostream & operator<<(std::ostream& out, const Graph& g) {
 /*
 * Constructs empty graph
 */
-Graph::Graph() :edges(Graph::EMPTY) {}
+Graph::Graph()
+
+	:edges(Graph::EMPTY), copyOnWrite(false) {}
 
 /*
-* Copy constructor overload
+* Copy constructor overload, see SetCopyOnWrite
 * @param other The other Graph to copy
 */
-Graph::Graph(const Graph& other) {
+Graph::Graph(const Graph& other)
+
+	:edges(Graph::EMPTY), copyOnWrite(false) {
 	
 	(*this) = other;
 }
 
+/*
+* Move constructor, takes the contents of other and leaves it empty
+* @param other The other Graph to move from
+*/
+Graph::Graph(Graph&& other) noexcept
+
+	:edges(Graph::EMPTY), copyOnWrite(false) {
+
+	this->take(&other);
+}
+
 /*
 * Destroys Graph, all Vertices, all Edges and deallocates dynamic memory
 */
@@ -58,7 +88,7 @@ Graph::~Graph() {
 }
 
 /*
-* Assignment operator overload
+* Assignment operator overload, see SetCopyOnWrite
 * @param other The other Graph to copy
 */
 Graph& Graph::operator=(const Graph& other) {
@@ -66,20 +96,59 @@ Graph& Graph::operator=(const Graph& other) {
 	if (this != &other) {
 		
 		this->clear();
-		this->edges = other.edges;
-		this->clone(&other.map);
+		this->clone(other);
+	}
+
+	return (*this);
+}
+
+/*
+* Move assignment operator, takes the contents of other and leaves it
+* empty
+* @param other The other Graph to move from
+* @return this by reference
+*/
+Graph& Graph::operator=(Graph&& other) noexcept {
+
+	if (this != &other) {
+
+		this->clear();
+		this->take(&other);
 	}
 
 	return (*this);
 }
 
+/*
+* Sets whether copies of Graph share its adjacency lists
+* Copies of a copy-on-write Graph copy the labels and share every
+* adjacency list, a list is copied the first time either Graph changes it
+* and its Edges are reused once no copy holds it. Copies are copy-on-write
+* too. A Graph can be copied on several threads at once, its copies can
+* be read, changed and destroyed on different threads
+* @param enabled True to share adjacency lists, false to copy them
+*/
+void Graph::SetCopyOnWrite(bool enabled) {
+
+	this->copyOnWrite = enabled;
+}
+
+/*
+* Returns true if copies of Graph share its adjacency lists
+* @return true if copy-on-write, else false
+*/
+bool Graph::IsCopyOnWrite() const {
+
+	return this->copyOnWrite;
+}
+
 /*
 * Get the total number of Vertices in Graph
 * @return total number of Vertices in Graph
 */
 int Graph::NumberOfVertices() const {
 	
-	return static_cast<int>(this->map.size());
+	return static_cast<int>(this->vertices.size());
 }
 
 /*
@@ -100,14 +169,30 @@ int Graph::NumberOfEdges(const Label& label) const {
 
 	int edges(Graph::EMPTY - Graph::COUNT);
 
-	if (this->map.count(label)) {
+	Id id = this->find(label);
+
+	if (id != Graph::NO_ID) {
 
-		edges = this->map.at(label)->numOfEdges();
+		edges = this->vertices[id].numOfEdges();
 	}
 		
 	return edges;
 }
 
+/*
+* Get the memory used by the adjacency lists
+* Counts the Vertex headers and the slabs of the EdgeArena, labels, the
+* label dictionary and Edges shared with a Graph copied from are not
+* counted
+* @return number of bytes used
+*/
+std::size_t Graph::MemoryUsage() const {
+
+	std::size_t bytes = this->vertices.capacity() * sizeof(Vertex);
+
+	return (this->arena != nullptr) ? bytes + this->arena->bytes() : bytes;
+}
+
 /*
 * Add a Vertex to Graph, no duplicates allowed
 * @param label The label of the Vertex
@@ -115,16 +200,9 @@ int Graph::NumberOfEdges(const Label& label) const {
 */
 bool Graph::AddVertex(const Label& label) {
 	
-	bool added(false);
+	Id count = static_cast<Id>(this->vertices.size());
 
-	if (!this->map.count(label)) {
-
-		this->map[label] = new Vertex();
-
-		added = true;
-	}
-
-	return added;
+	return this->intern(label) == count;
 }
 
 /*
@@ -134,7 +212,7 @@ bool Graph::AddVertex(const Label& label) {
 */
 bool Graph::HasVertex(const Label& label) const {
 
-	return this->map.count(label);
+	return this->find(label) != Graph::NO_ID;
 }
 
 /*
@@ -146,9 +224,11 @@ std::string Graph::GetEdges(const Label& label) const {
 
 	std::string edges;
 
-	if (this->map.count(label)) {
+	Id id = this->find(label);
+
+	if (id != Graph::NO_ID) {
 	
-		edges = this->map.at(label)->getEdges();
+		this->vertices[id].getEdges(this->labels, &edges);
 	}
 
 	return edges;
@@ -170,12 +250,19 @@ bool Graph::Connect(const Label& label1, const Label& label2,
 
 	if (label1 != label2) {
 
-		this->AddVertex(label1);
-		this->AddVertex(label2);
+		Id id1 = this->intern(label1),
+		   id2 = this->intern(label2);
+
+		const Vertex& vertex = this->vertices[id1];
+
+		if (vertex.getShare() == nullptr ||
+			vertex.getAdjacent(id2) == nullptr) {
 
-		connected = this->map[label1]->connect(label2, weight);
+			connected = this->own(id1).connect(id2, weight, this->labels,
+				                               this->edgeArena());
 
-		this->edges += (connected) ? Graph::COUNT : Graph::EMPTY;
+			this->edges += (connected) ? Graph::COUNT : Graph::EMPTY;
+		}
 	}
 
 	return connected;
@@ -191,12 +278,21 @@ bool Graph::Disconnect(const Label& label1, const Label& label2) {
 	
 	bool disconnected(false);
 
-	if (label1 != label2 && this->map.count(label1) &&
-		                this->map.count(label2)) {
+	Id id1 = this->find(label1),
+	   id2 = this->find(label2);
+
+	if (id1 != id2 && id1 != Graph::NO_ID && id2 != Graph::NO_ID) {
+
+		const Vertex& vertex = this->vertices[id1];
+
+		if (vertex.getShare() == nullptr ||
+			vertex.getAdjacent(id2) != nullptr) {
 
-		disconnected = this->map[label1]->disconnect(label2);
+			disconnected = this->own(id1).disconnect(id2,
+				                                     this->edgeArena());
 
-		this->edges -= (disconnected) ? Graph::COUNT : Graph::EMPTY;
+			this->edges -= (disconnected) ? Graph::COUNT : Graph::EMPTY;
+		}
 	}
 
 	return disconnected;
@@ -206,607 +302,2686 @@ bool Graph::Disconnect(const Label& label1, const Label& label2) {
 * Read Edges from file, first line of file is an integer indicating
 * number of Edges, each line represents an Edge in the form of
 * "string string int", Vertex labels cannot contain spaces
-* Clears previous contents
+* Clears previous contents, unless the file cannot be read
 * @param fileName The name of the file
 * @return true if file successfully read, else false
 */
 bool Graph::ReadFile(const std::string& fileName) {
-	
-	bool fileRead(false);
 
-	std::ifstream file(fileName);
+	std::string error;
 
-	if (file.is_open()) {
-		
-		this->clear();
-		this->extractFile(&file);
+	return this->ReadFile(fileName, error);
+}
 
-		fileRead = true;
-	}
+/*
+* Read Edges from file, see ReadFile
+* @param fileName The name of the file
+* @param error The string to set to the reason the file could not be
+* read, as "file:line: message", empty if it was read
+* @return true if file successfully read, else false
+*/
+bool Graph::ReadFile(const std::string& fileName, std::string& error) {
 
-	return fileRead;
+	ThreadPool pool(Graph::COUNT);
+
+	return this->ReadFile(fileName, error, pool);
 }
 
 /*
-* Depth-first traversal originating from Vertex with given label
-* @param label The origin Vertex label
-* @param func The function to call on each Vertex label
+* Read Edges from file, see ReadFile, parsing on the workers of pool
+* @param fileName The name of the file
+* @param error The string to set to the reason the file could not be
+* read, as "file:line: message", empty if it was read
+* @param pool The ThreadPool to parse on
+* @return true if file successfully read, else false
 */
-void Graph::DFS(const Label& label, Visit func) {
+bool Graph::ReadFile(const std::string& fileName, std::string& error,
+	                 ThreadPool& pool) {
 
-	if (this->map.count(label)) {
+	return this->ReadFile(fileName, Format::EDGES, error, pool);
+}
 
-		LabelStack stack;
+/*
+* Read Edges from file in a given format, see Format
+* Clears previous contents, unless the file cannot be read
+* @param fileName The name of the file
+* @param format The format of the file
+* @param error The string to set to the reason the file could not be
+* read, as "file:line: message", empty if it was read
+* @return true if file successfully read, else false
+*/
+bool Graph::ReadFile(const std::string& fileName, Format format,
+	                 std::string& error) {
 
-		stack.push(label);
+	ThreadPool pool(Graph::COUNT);
 
-		this->dfs(&stack, func);
-		this->unvisitVertices();
-	}
+	return this->ReadFile(fileName, format, error, pool);
 }
 
 /*
-* Breadth-first traversal originating from Vertex with given label
-* @param label The origin Vertex label
-* @param func The function to call on each Vertex label
+* Read Edges from file in a given format, see Format, parsing on the
+* workers of pool
+* The file is read in blocks of whole lines, a plain file in a single
+* block and a compressed file in blocks decompressed while the last one is
+* parsed, see FileReader. Each block is split into one range of whole
+* lines per worker and each worker tokenizes its range in place. Edges are
+* only added once every line before the last Edge needed parsed, so a bad
+* file leaves Graph unchanged
+* @param fileName The name of the file
+* @param format The format of the file
+* @param error The string to set to the reason the file could not be
+* read, as "file:line: message", empty if it was read
+* @param pool The ThreadPool to parse on
+* @return true if file successfully read, else false
 */
-void Graph::BFS(const Label& label, Visit func) {
-	
-	if (this->map.count(label)) {
+bool Graph::ReadFile(const std::string& fileName, Format format,
+	                 std::string& error, ThreadPool& pool) {
 
-		LabelQ q;
+	FileReader reader;
+	TextList blocks(Graph::COUNT);
 
-		q.push(label);
+	error.clear();
 
-		this->map[label]->setVisited();
+	if (!reader.Open(fileName) || (!reader.Next(blocks.front()) &&
+		                           !reader.Error().empty())) {
 
-		this->bfs(&q, func);
+		error = fileName + ": " + reader.Error();
 
-		this->unvisitVertices();
+		return false;
 	}
-}
 
-/**
-* Dijkstra's algorithm to find shortest distance to all other Vertices
-* and the path to all other Vertices
-* Path cost is recorded in the map passed in, e.g. weights["F"] = 10
-* How to get to vertex is recorded in map passed in, prevs["F" = "C"
-* @param label The label of the origin Vertex
-* @param wMap The map to record shortest path
-* @param pMap The map to record previous Vertex
-*/
-void Graph::Dijkstra(const Label& label, WeightMap& wMap, PrevMap& pMap) {
+	const char* pos;
+	const char* end;
+	int line;
+	FileHeader header;
+	std::string more;
 
-	Vertex* curr = this->map[label];
+	for (bool read(true); read; blocks.front() += more) {
 
-	wMap[label] = Graph::NO_WEIGHT;
+		pos = blocks.front().data();
+		end = pos + blocks.front().size();
+		line = Graph::COUNT;
+		header.format = format;
+		header.names.clear();
 
-	this->initMaps(curr->getNext(), label, &wMap, &pMap);
+		if (Graph::parseHeader(&pos, end, &line, &header, &error)) {
 
-	VertexSet set;
+			break;
+		}
 
-	set.insert(curr);
+		read = reader.Next(more);
 
-	dijkstra(&set, &wMap, &pMap);
+		if (!read) {
 
-	this->cleanWeights(&wMap);
-}
+			error = (reader.Error().empty()) ?
+				    fileName + ":" + std::to_string(line) + ": " + error :
+				    fileName + ": " + reader.Error();
 
-/*
-* Creates a MinSpanningTree using Prim's algorithm
-* @param label The label of the origin Vertex
-* @return a Graph of the MinSpanningTree
-*/
-Graph* Graph::MinSpanningTree(const Label& label) {
+			return false;
+		}
+	}
 
-	Graph* mst = new Graph;
+	ChunkList chunks(Graph::COUNT);
+	Chunk& declared = chunks.front();
+	Id vertex(0);
 
-	Vertex* curr = this->map[label],
-		  * next = nullptr;
+	declared.records = Graph::EMPTY;
+	declared.lines = Graph::EMPTY;
+	declared.lastLine = -1;
+	declared.errorLine = -1;
+	declared.vertex = Graph::EMPTY;
 
-	Label currLabel;
+	for (const Label& name : header.names) {
 
-	mst->AddVertex(label);
+		declared.edges.emplace_back(name, std::string_view(), Graph::NO_WEIGHT);
+	}
 
-	curr->setVisited();
+	do {
 
-	bool done(false);
+		Graph::parseBlock(pos, end, header, &vertex, &chunks, &pool);
 
-	while (!done) {
-		
-		Graph::nextMinEdge(curr, next, &currLabel);
+		blocks.emplace_back();
 
-		if (curr != nullptr) {
-			
-			mst->Connect(currLabel, next->getLabel(), next->getWeight());
+		pos = nullptr;
 
-		} else {
-			
-			done = true;
+		if (reader.Next(blocks.back())) {
 
-			this->unvisitVertices();
+			pos = blocks.back().data();
+			end = pos + blocks.back().size();
 		}
-	}
 
-	return mst;
-}
+	} while (pos != nullptr);
 
-/*
-* Gets the sum cost of all Edges in Graph
-* @return sum cost of all Edges in Graph
-*/
-Graph::Weight Graph::SumOfEdges() const {
+	if (!reader.Error().empty()) {
 
-	Weight sum = Graph::NO_WEIGHT;
+		error = fileName + ": " + reader.Error();
 
-	for (const LabelVert& pair : this->map) {
-	
-		Vertex* curr = pair.second->getNext();
+		return false;
+	}
 
-		while (curr != nullptr) {
-			
-			sum += curr->getWeight();
+	std::size_t found(0), count(0);
+	int lastLine(line);
 
-			curr = curr->getNext();
+	for (const Chunk& chunk : chunks) {
+
+		if (format == Format::EDGES &&
+			found + chunk.records >= header.records) {
+
+			count += header.records - found;
+			found = header.records;
+
+			break;
 		}
-	}
 
-	return sum;
-}
+		found += chunk.records;
+		count += chunk.edges.size();
 
-/*
-* Deallocate all dynamic memory
-*/
-void Graph::clear() {
+		if (chunk.errorLine != -1) {
 
-	for (const LabelVert& pair : this->map) {
-		
-		pair.second->clear();
-		
-		delete pair.second;
+			error = fileName + ":" + std::to_string(line + chunk.errorLine) +
+				    ": " + chunk.error;
+
+			return false;
+		}
+
+		lastLine = (chunk.lastLine != -1) ? line + chunk.lastLine : lastLine;
+		line += chunk.lines;
 	}
 
-	this->map.clear();
-	this->edges = Graph::EMPTY;
-}
+	if (format != Format::SNAP && found != header.records) {
 
-/*
-* Helper for copy constructor and assignment operator overload
-* Copies contents of AdjacencyMap in other Graph
-* @param otherMap The map in the other Graph to clone
-*/
-void Graph::clone(const AdjacencyMap* otherMap) {
-	
-	for (const LabelVert& pair : *otherMap) {
+		error = fileName + ":" + std::to_string(lastLine) + ": expected " +
+			    std::to_string(header.records) + " " + header.record +
+			    ", found " + std::to_string(found);
 
-		*this->map[pair.first] = *pair.second;
+		return false;
 	}
+
+	this->clear();
+	this->build(chunks, count, &pool);
+
+	return true;
 }
 
 /*
-* Extracts contents from file to create Vertices & Edges
-* @param file The file to extract contents from
+* Read up to limit records from an EdgeStream and apply them as Connect
+* and Disconnect would, in stream order
+* Records before a line that is not valid are applied, the stream then
+* stops with an error. Queries can run between batches
+* Vertices are added in stream order, then the records of each Edge
+* collapse to the one Change they make together, and the Changes of each
+* Vertex are sorted by label and merged into its adjacent list in one pass
+* @param stream The EdgeStream to read from
+* @param limit The largest number of records to read
+* @return the number of records read, 0 once the stream ended or stopped
 */
-void Graph::extractFile(std::ifstream* file) {
+std::size_t Graph::ReadBatch(EdgeStream& stream, std::size_t limit) {
 
-	int edges;
+	std::size_t count = stream.read(limit);
+	EdgeChangeList& changes = stream.changes;
 
-	(*file) >> edges;
-
-	for (int i(0); i < edges; ++i) {
-		
-		char c1, c2;
-		Weight w;
+	changes.clear();
 
-		(*file) >> c1 >> c2 >> w;
+	for (std::size_t i(0); i < count; ++i) {
 
-		this->Connect(Label(1, c1), Label(1, c2), w);
-	}
-}
+		const EdgeStream::Record& record = stream.records[i];
 
-/*
-* Helper for depthFirstTraversal
-* @param stack The stack to search depth first with
-* @param func The function to call on each Vertex
-*/
-void Graph::dfs(LabelStack* stack, Visit func) {
+		if (record.from == record.to) {
 
-	while (!stack->empty()) {
+			continue;
+		}
 
-		Label next = this->nextLabel(stack->top());
+		if (record.remove) {
 
-		if (next != Graph::NO_LABEL) {
+			Id from = this->find(record.from),
+			   to = this->find(record.to);
 
-			func(next);
+			if (from != Graph::NO_ID && to != Graph::NO_ID) {
 
-			stack->push(next);
+				changes.emplace_back(from, to, Graph::NO_WEIGHT,
+					                 Change::REMOVE);
+			}
 
 		} else {
 
-			stack->pop();
+			Id from = this->intern(record.from),
+			   to = this->intern(record.to);
+
+			changes.emplace_back(from, to, record.weight, Change::ADD);
 		}
 	}
-}
 
-/*
-* Gets the next unvisited Vertex label adjacent to Vertex with given label
-* @param label The label of the Vertex to get next from
-* @return next unvisited Vertex label adjacent to Vertex
-*/
-Graph::Label Graph::nextLabel(const Label& label) {
+	std::stable_sort(changes.begin(), changes.end(),
+		[this](const EdgeChange& a, const EdgeChange& b) {
 
-	Vertex* curr = this->map[label];
+			const Label& labelA = this->labels[std::get<1>(a)];
+			const Label& labelB = this->labels[std::get<1>(b)];
 
-	Label nextLabel = label;
+			return std::get<0>(a) < std::get<0>(b) ||
+				   (std::get<0>(a) == std::get<0>(b) && labelA < labelB);
+		});
 
-	curr = (curr->isVisited()) ? this->nextVertex(curr->getNext(), &nextLabel):
-		                         curr;
+	std::size_t kept(0);
 
-	nextLabel = (curr == nullptr) ? Graph::NO_LABEL : nextLabel;
+	for (std::size_t i(0), j; i < changes.size(); i = j) {
 
-	if (curr != nullptr) {
+		EdgeChange change = changes[i];
 
-		curr->setVisited();
-	}
+		for (j = i + 1; j < changes.size() &&
+			            std::get<0>(changes[j]) == std::get<0>(change) &&
+			            std::get<1>(changes[j]) == std::get<1>(change); ++j) {
 
-	return nextLabel;
-}
+			if (std::get<3>(changes[j]) == Change::REMOVE) {
 
-/*
-* Helper for nextLabel
-* Gets the next unvisited Vertex starting from curr
-* @param curr The current Vertex
-* @param nextLabel Pointer to store label of next unvisited Vertex
-* @return next unvisited Vertexnext unvisited Vertex
-*/
-Graph::Vertex* Graph::nextVertex(Vertex* curr, Label* nextLabel) const {
+				change = changes[j];
 
-	while (curr != nullptr) {
+			} else if (std::get<3>(change) == Change::REMOVE) {
 
-		Vertex* temp = this->map.at(curr->getLabel());
+				change = changes[j];
+				std::get<3>(change) = Change::REPLACE;
+			}
+		}
 
-		if (!temp->isVisited()) {
+		changes[kept++] = change;
+	}
 
-			*nextLabel = curr->getLabel();
+	changes.resize(kept);
 
-			curr = temp;
+	for (std::size_t i(0), j; i < changes.size(); i = j) {
 
-			break;
-		}
+		Id from = std::get<0>(changes[i]);
 
-		curr = curr->getNext();
+		for (j = i + 1; j < changes.size() &&
+			            std::get<0>(changes[j]) == from; ++j) {}
+
+		const Vertex& vertex = this->vertices[from];
+
+		if (vertex.getShare() == nullptr ||
+			vertex.changedBy(changes.data() + i, changes.data() + j,
+				             this->labels)) {
+
+			this->edges += this->own(from).update(changes.data() + i,
+				changes.data() + j, this->labels, this->edgeArena());
+		}
 	}
 
-	return curr;
+	return count;
 }
 
 /*
-* Helper for breadthFirstTraversal
-* @param q The queue to search breadth first with
-* @param func The function to call on each Vertex
+* Save Graph to a binary snapshot file, see Snapshot
+* @param fileName The name of the file
+* @return true if file successfully written, else false
 */
-void Graph::bfs(LabelQ* q, Visit func) {
+bool Graph::Save(const std::string& fileName) const {
 
-	while (!q->empty()) {
+	return Snapshot::Save(*this, fileName);
+}
 
-		Vertex* next = this->map[q->front()];
+/*
+* Load Graph from a binary snapshot file written by Save
+* Clears previous contents, unless the file cannot be read or fails its
+* checksum
+* Vertices keep the ids they had when saved, so searches break ties as
+* in the saved Graph, and the ids sorted by label fill the label
+* dictionary without searching
+* @param fileName The name of the file
+* @return true if file successfully read, else false
+*/
+bool Graph::Load(const std::string& fileName) {
 
-		func(q->front());
+	Snapshot snapshot;
 
-		q->pop();
+	if (!snapshot.Open(fileName)) {
 
-		Graph::addUnvisited(q, next->getNext());
+		return false;
 	}
-}
 
-/*
-* Helper for bfsHelper, adds all unvisited adjacent Vertices to q
-* @param q The queue to search breadth first with
-* @param curr The Vertex to get unvisited adjacent Vertices from
-*/
-void Graph::addUnvisited(LabelQ* q, Vertex* curr) {
+	this->clear();
 
-	while (curr != nullptr) {
-		
-		Vertex* temp = this->map[curr->getLabel()];
+	this->labels.reserve(snapshot.vertices);
+	this->vertices.reserve(snapshot.vertices);
 
-		if (!temp->isVisited()) {
-			
-			temp->setVisited();
+	for (Id id(0); id < snapshot.vertices; ++id) {
 
-			q->push(curr->getLabel());
-		}
+		this->labels.emplace_back(snapshot.label(id));
 
-		curr = curr->getNext();
-	}
-}
+		Edge* head(nullptr);
 
-/*
-* Helper for Dijkstra, initializes WeightMap and PrevMap for all Vertices
-* adjacent to the origin Vertex
-* @param curr The origin Vertex
-* @param label The label of the origin Vertex
-* @param wMap The WeightMap
-* @param pMap The PrevMap
-*/
-void Graph::initMaps(const Vertex* curr, const Label& label, WeightMap* wMap,
-					 PrevMap* pMap) const {
+		for (Id e(snapshot.offsets[id + 1]); e > snapshot.offsets[id]; --e) {
 
-	while (curr != nullptr) {
+			head = this->edgeArena()->allocate(snapshot.targets[e - 1],
+				                               snapshot.weights[e - 1], head);
+		}
 
-		(*wMap)[curr->getLabel()] = curr->getWeight();
-		(*pMap)[curr->getLabel()] = label;
+		int degree = snapshot.offsets[id + 1] - snapshot.offsets[id];
 
-		curr = curr->getNext();
+		this->vertices.emplace_back(head, degree);
 	}
 
-	for (const LabelVert& pair : this->map) {
+	for (Id i(0); i < snapshot.vertices; ++i) {
 
-		if (!wMap->count(pair.first)) {
+		Id id = snapshot.order[i];
 
-			(*wMap)[pair.first] = INT_MAX;
-		}
+		this->map.emplace_hint(this->map.end(), this->labels[id], id);
 	}
+
+	this->edges = snapshot.NumberOfEdges();
+
+	return true;
 }
 
 /*
-* Helper for Dijkstra, iteratively gets the next smallest Vertex from
-* WeightMap and updates any possible shorter paths from the origin
-* @param set The VertexSet of visited Vertices
-* @param wMap The WeightMap
-* @param pMap The PrevMap
+* Lazy depth-first traversal originating from Vertex with given label
+* @param label The origin Vertex label
+* @return a range of the labels of visited Vertices, empty if Vertex
+* not found
 */
-void Graph::dijkstra(VertexSet* set, WeightMap* wMap, PrevMap* pMap) const {
+Graph::Traversal Graph::DFSRange(const Label& label) const {
 
-	Label currLabel;
-
-	Vertex* curr = nextSmallest(set, wMap, &currLabel);
+	return Traversal(this, this->find(label), true);
+}
 
-	while (curr != nullptr) {
+/*
+* Lazy breadth-first traversal originating from Vertex with given label
+* @param label The origin Vertex label
+* @return a range of the labels of visited Vertices, empty if Vertex
+* not found
+*/
+Graph::Traversal Graph::BFSRange(const Label& label) const {
 
-		for (const LabelWeight& pair : *wMap) {
+	return Traversal(this, this->find(label), false);
+}
 
-			if (!set->count(this->map.at(pair.first))) {
+/**
+* Dijkstra's algorithm to find shortest distance to all other Vertices
+* and the path to all other Vertices
+* Path cost is recorded in the map passed in, e.g. weights["F"] = 10
+* How to get to vertex is recorded in map passed in, prevs["F" = "C"
+* @param label The label of the origin Vertex
+* @param wMap The map to record shortest path
+* @param pMap The map to record previous Vertex
+*/
+void Graph::Dijkstra(const Label& label, WeightMap& wMap,
+	                 PrevMap& pMap) const {
 
-				this->update(curr, pair, currLabel, wMap, pMap);
-			}
-		}
+	ShortestPathWorkspace workspace;
 
-		set->insert(curr);
+	this->Dijkstra(label, workspace);
 
-		curr = nextSmallest(set, wMap, &currLabel);
-	}
+	this->cleanWeights(&workspace, &wMap, &pMap);
 }
 
 /*
-* Helper for dijkstra, gets the label for the next smallest Vertex from
-* WeightMap thats not in VertexSet
-* @param set The VertexSet
-* @param wMap The WeightMap
-* @param label The pointer to assign as the label of the next smallest Vertex
-* @return pointer to the next smallest Vertex
+* Dijkstra's algorithm into a reusable workspace, nothing is allocated
+* once the workspace has grown to the size of the Graph
+* @param label The label of the origin Vertex
+* @param workspace The ShortestPathWorkspace to search in
+* @return the ShortestPaths from the origin, empty if Vertex not found
 */
-Graph::Vertex* Graph::nextSmallest(const VertexSet* set, const WeightMap* wMap,
-	                               Label* label) const {
+Graph::ShortestPaths Graph::Dijkstra(const Label& label,
+	                                 ShortestPathWorkspace& workspace) const {
 
-	Vertex* next = nullptr;
+	Id origin = this->find(label);
 
-	Weight smallest = INT_MAX;
+	workspace.reset(this, origin);
 
-	for (const LabelWeight& pair : *wMap) {
+	if (origin != Graph::NO_ID) {
 
-		Vertex* temp = this->map.at(pair.first);
+		workspace.reach(origin, Graph::NO_WEIGHT, Graph::NO_ID);
 
-		if (!set->count(temp) && pair.second < smallest) {
+		this->dijkstra(&workspace);
+	}
 
-			smallest = pair.second;
+	return ShortestPaths(&workspace);
+}
 
-			next = temp;
+/*
+* Dijkstra's algorithm from every source label, the sources are shared
+* between the workers of pool and every worker searches in its own
+* ShortestPathWorkspace
+* @param sources The labels of the origin Vertices
+* @param sink The callable to call with the index of each source and
+* its ShortestPaths
+* @param pool The ThreadPool to search on
+*/
+void Graph::Dijkstra(const LabelList& sources, const PathsSink& sink,
+	                 ThreadPool& pool) const {
 
-			*label = pair.first;
-		}
-	}
+	this->dijkstra(sources, [&sink](std::size_t source,
+		                            const ShortestPathWorkspace& workspace) {
 
-	return next;
+		sink(source, ShortestPaths(&workspace));
+	}, &pool);
 }
 
 /*
-* Helper for dijkstra, updates an entry in the WeightMap if there is a shorter
-* path
-* @param curr The current Vertex
-* @param pair The entry in the WeightMap to update
-* @param label The label of the current Vertex
-* @param wMap The WeightMap
-* @param pMap The PrevMap
+* Shortest distances from every source to every target
+* Target ids are looked up once, each search then fills its row straight
+* from the workspace arrays
+* @param sources The labels of the origin Vertices
+* @param targets The labels of the destination Vertices
+* @param table The WeightTable to fill row by row, the distance from
+* sources[i] to targets[j] is at i * targets.size() + j, INT_MAX if
+* there is no path
+* @param pool The ThreadPool to search on
 */
-void Graph::update(const Vertex* curr, const LabelWeight& pair,
-	               const Label& label, WeightMap* wMap, PrevMap* pMap) const {
+void Graph::DistanceTable(const LabelList& sources, const LabelList& targets,
+	                      WeightTable& table, ThreadPool& pool) const {
 
-	Vertex* adjacent = curr->getAdjacent(pair.first);
+	IdList ids;
 
-	if (adjacent != nullptr && (*wMap)[label] + adjacent->getWeight() <
-		                                                 pair.second) {
-	
-		(*wMap)[pair.first] = (*wMap)[label] + adjacent->getWeight();
-		(*pMap)[pair.first] = label;
+	ids.reserve(targets.size());
+
+	for (const Label& label : targets) {
+
+		ids.push_back(this->find(label));
 	}
-}
 
+	table.assign(sources.size() * targets.size(), INT_MAX);
 
-void Graph::cleanWeights(WeightMap* wMap) {
+	SearchSink fill = [&ids, &table](std::size_t source,
+		                             const ShortestPathWorkspace& workspace) {
 
-	for (const LabelVert& pair : this->map) {
-		
-		if ((*wMap)[pair.first] == INT_MAX ||
-			(*wMap)[pair.first] == Graph::NO_WEIGHT) {
-			
-			wMap->erase(pair.first);
+		Weight* row = table.data() + source * ids.size();
+
+		for (std::size_t target(0); target < ids.size(); ++target) {
+
+			if (ids[target] != Graph::NO_ID &&
+				workspace.isReached(ids[target])) {
+
+				row[target] = workspace.dist[ids[target]];
+			}
 		}
-	}
+	};
+
+	this->dijkstra(sources, fill, &pool);
 }
 
 /*
-* Helper for MinSpanningTree, gets the Vertices connected to the next
-* minimum cost Edge
-* @param curr The starting Vertex on the next minimum cost Edge
-* @param next The ending Vertex on the next minimum cost Edge
-* @param label The label of the starting Vertex on the next minimum cost Edge
+* Creates a MinSpanningTree using Prim's algorithm
+* Candidate Edges are kept in a heap ordered by weight, then by starting and
+* ending label, so the cheapest Edge leaving the tree is found without
+* scanning every Edge again
+* @param label The label of the origin Vertex
+* @return a Graph of the MinSpanningTree
 */
-void Graph::nextMinEdge(Vertex*& curr, Vertex*& next, Label* label) {
-	
-	Weight minWeight = INT_MAX;
-
-	for (const LabelVert& pair : this->map) {
-		
-		Vertex* temp = pair.second,
-			  * tempNext = temp->getNext();
-		
-		while (temp->isVisited() && tempNext != nullptr) {
-			
-			if (tempNext->getWeight() < minWeight &&
-				!this->map[tempNext->getLabel()]->isVisited()) {
-				
-				curr = temp;
+Graph Graph::MinSpanningTree(const Label& label) const {
 
-				next = tempNext;
+	Graph mst;
 
-				minWeight = tempNext->getWeight();
+	Id currId = this->find(label);
 
-				*label = pair.first;
-			}
+	if (currId == Graph::NO_ID) {
 
-			tempNext = tempNext->getNext();
-		}
+		return mst;
 	}
 
-	if (minWeight != INT_MAX) {
+	EdgeQ heap([this](const EdgeId& a, const EdgeId& b) {
 
-		curr->setVisited();
+		return std::tie(std::get<0>(a), this->labels[std::get<1>(a)],
+			            this->labels[std::get<2>(a)]) >
+			   std::tie(std::get<0>(b), this->labels[std::get<1>(b)],
+				        this->labels[std::get<2>(b)]);
+	});
+	VisitedSet visited;
 
-		this->map[next->getLabel()]->setVisited();
-		
-	} else {
+	visited.Reset(this->vertices.size());
 
-		curr = nullptr;
-	}
+	mst.AddVertex(label);
+
+	while (currId != Graph::NO_ID) {
+
+		visited.Visit(currId);
+
+		this->addCandidates(currId, &visited, &heap);
+
+		currId = Graph::NO_ID;
+
+		while (!heap.empty() && currId == Graph::NO_ID) {
+
+			EdgeId edge = heap.top();
+
+			heap.pop();
+
+			if (!visited.IsVisited(std::get<2>(edge))) {
+
+				currId = std::get<2>(edge);
+
+				mst.Connect(this->labels[std::get<1>(edge)],
+					        this->labels[currId], std::get<0>(edge));
+			}
+		}
+	}
+
+	return mst;
+}
+
+/*
+* Gets the sum cost of all Edges in Graph
+* @return sum cost of all Edges in Graph
+*/
+Graph::Weight Graph::SumOfEdges() const {
+
+	Weight sum = Graph::NO_WEIGHT;
+
+	for (const Vertex& vertex : this->vertices) {
+	
+		const Edge* curr = vertex.getNext();
+
+		while (curr != nullptr) {
+			
+			sum += curr->getWeight();
+
+			curr = curr->getNext();
+		}
+	}
+
+	return sum;
+}
+
+/*
+* Deallocate all dynamic memory
+*/
+void Graph::clear() {
+
+	for (Vertex& vertex : this->vertices) {
+
+		if (vertex.getShare() != nullptr) {
+
+			vertex.leave(vertex.getShare()->block->arena != this->arena);
+		}
+	}
+
+	this->map.clear();
+	this->labels.clear();
+	this->vertices.clear();
+	this->arena.reset();
+	this->edges = Graph::EMPTY;
+}
+
+/*
+* Helper for copy constructor and assignment operator overload
+* Copies label dictionary and adjacency lists of other Graph
+* @param other The other Graph to clone
+*/
+void Graph::clone(const Graph& other) {
+	
+	this->map = other.map;
+	this->labels = other.labels;
+	this->edges = other.edges;
+	this->copyOnWrite = other.copyOnWrite;
+
+	if (other.copyOnWrite) {
+
+		int fresh(Graph::EMPTY);
+		ShareBlock* block(nullptr);
+		Share* next(nullptr);
+
+		for (const Vertex& vertex : other.vertices) {
+
+			fresh += (vertex.getNext() != nullptr &&
+				      vertex.getShare() == nullptr);
+		}
+
+		if (fresh != Graph::EMPTY) {
+
+			block = new ShareBlock(fresh, other.arena);
+			next = block->shares.get();
+		}
+
+		for (const Vertex& vertex : other.vertices) {
+
+			vertex.share(&next);
+		}
+
+		this->vertices = other.vertices;
+
+		if (block != nullptr) {
+
+			block->release(static_cast<int>(block->shares.get() + fresh -
+				                            next));
+		}
+
+		return;
+	}
+
+	this->vertices.resize(other.vertices.size());
+
+	for (std::size_t id(0); id < other.vertices.size(); ++id) {
+
+		this->vertices[id].clone(other.vertices[id], this->edgeArena());
+	}
+}
+
+/*
+* Helper for move constructor and move assignment operator, swaps the
+* contents of an empty Graph with other
+* Only swaps, so moving never allocates or throws
+* @param other The other Graph to take from
+*/
+void Graph::take(Graph* other) noexcept {
+
+	this->map.swap(other->map);
+	this->labels.swap(other->labels);
+	this->vertices.swap(other->vertices);
+	this->arena.swap(other->arena);
+	std::swap(this->edges, other->edges);
+	std::swap(this->copyOnWrite, other->copyOnWrite);
+}
+
+/*
+* Gets the adjacency list of a Vertex to change, copying it first if it
+* is shared with another Graph
+* A shared list that no other Graph holds any more is changed in place
+* if its Edges are in the EdgeArena of Graph. Otherwise it is copied
+* before Graph drops its hold, so its Edges are not given back while
+* they are read
+* @param id The id of the Vertex
+* @return the Vertex by reference
+*/
+Graph::Vertex& Graph::own(const Id& id) {
+
+	Vertex& vertex = this->vertices[id];
+	Share* share = vertex.getShare();
+
+	if (share == nullptr) {
+
+		return vertex;
+	}
+
+	if (share->owners.load(std::memory_order_acquire) == Graph::COUNT &&
+		share->block->arena == this->arena) {
+
+		vertex.leave(false);
+
+		return vertex;
+	}
+
+	Vertex copy;
+
+	copy.clone(vertex, this->edgeArena());
+
+	vertex.leave(true);
+	vertex = copy;
+
+	return vertex;
+}
+
+/*
+* Gets the EdgeArena of Graph, creating it if there is none
+* An empty or moved from Graph holds no EdgeArena
+* @return pointer to the EdgeArena
+*/
+Graph::EdgeArena* Graph::edgeArena() {
+
+	if (this->arena == nullptr) {
+
+		this->arena = std::make_shared<EdgeArena>();
+	}
+
+	return this->arena.get();
+}
+
+/*
+* Gets the id of a Vertex, adding the Vertex if it is not in Graph
+* @param label The label of the Vertex
+* @return id of the Vertex
+*/
+Graph::Id Graph::intern(const Label& label) {
+
+	Id id = static_cast<Id>(this->vertices.size());
+
+	std::pair<LabelMap::iterator, bool> result = this->map.emplace(label, id);
+
+	if (result.second) {
+
+		this->labels.push_back(label);
+		this->vertices.emplace_back();
+
+	} else {
+
+		id = result.first->second;
+	}
+
+	return id;
+}
+
+/*
+* Gets the id of a Vertex
+* @param label The label of the Vertex
+* @return id of the Vertex, or NO_ID if not found
+*/
+Graph::Id Graph::find(const Label& label) const {
+
+	LabelMap::const_iterator it = this->map.find(label);
+
+	return (it != this->map.end()) ? it->second : Graph::NO_ID;
+}
+
+/*
+* Helper for ReadFile, parses a block of whole lines on the workers of pool
+* into one Chunk per worker
+* METIS Vertices are numbered by line, so workers first count the Vertex
+* lines of their ranges
+* @param begin The start of the block
+* @param end The end of the block
+* @param header The FileHeader of the file
+* @param vertex Pointer to the index of the next METIS Vertex
+* @param chunks The ChunkList to add the Chunks to
+* @param pool The ThreadPool to parse on
+*/
+void Graph::parseBlock(const char* begin, const char* end,
+	                   const FileHeader& header, Id* vertex,
+	                   ChunkList* chunks, ThreadPool* pool) {
+
+	std::vector<const char*> bounds(Graph::COUNT, begin);
+	std::size_t first = chunks->size();
+
+	for (int worker(1); worker < pool->Size(); ++worker) {
+
+		const char* bound = std::max(bounds.back(), begin + (end - begin) *
+			                                        worker / pool->Size());
+
+		bound = std::find(bound, end, '\n');
+
+		bounds.push_back((bound == end) ? end : bound + 1);
+	}
+
+	bounds.push_back(end);
+	chunks->resize(first + pool->Size());
+
+	if (header.format == Format::METIS) {
+
+		pool->Run([&bounds, chunks, first, &header](int worker) {
+
+			Id count(0);
+
+			for (const char* pos(bounds[worker]); pos != bounds[worker + 1];) {
+
+				const char* eol = std::find(pos, bounds[worker + 1], '\n');
+				int unused(Graph::EMPTY);
+				std::string_view token = Graph::nextToken(&pos, eol, &unused);
+
+				count += (token.empty() || token[0] != header.comment);
+				pos = (eol == bounds[worker + 1]) ? eol : eol + 1;
+			}
+
+			(*chunks)[first + worker].vertex = count;
+		});
+
+		for (std::size_t i(first); i < chunks->size(); ++i) {
+
+			std::swap(*vertex, (*chunks)[i].vertex);
+			*vertex += (*chunks)[i].vertex;
+		}
+	}
+
+	pool->Run([&bounds, chunks, first, &header](int worker) {
+
+		Graph::parseChunk(bounds[worker], bounds[worker + 1], header,
+			              &(*chunks)[first + worker]);
+	});
+}
+
+/*
+* Helper for ReadFile, parses the header of a file
+* Every format but EDGES and SNAP declares its Vertices, they are named
+* here so Edges can point to the names instead of the text
+* @param pos Pointer to the start of the text, moved past the header
+* @param end The end of the text
+* @param line Pointer to the line number of pos
+* @param header The FileHeader to fill, its format already set
+* @param error Pointer to store the reason the header is not valid
+* @return true if the header is valid, else false
+*/
+bool Graph::parseHeader(const char** pos, const char* end, int* line,
+	                    FileHeader* header, std::string* error) {
+
+	int vertices(Graph::EMPTY), records(Graph::EMPTY), unused(Graph::EMPTY);
+
+	header->records = Graph::EMPTY;
+	header->record = "Edges";
+	header->comment = '\0';
+	header->weighted = true;
+	header->real = false;
+	header->symmetric = false;
+	header->skip = Graph::EMPTY;
+
+	if (header->format == Format::EDGES) {
+
+		std::string_view token = Graph::nextToken(pos, end, line);
+
+		if (!Graph::parseInt(token, &records) || records < Graph::EMPTY) {
+
+			*error = "expected number of Edges, found '" + std::string(token) +
+				     "'";
+
+			return false;
+		}
+
+		header->records = records;
+
+		return true;
+	}
+
+	if (header->format == Format::SNAP) {
+
+		header->comment = '#';
+		header->weighted = false;
+
+		return true;
+	}
+
+	std::string_view first, second, third, fourth;
+
+	if (header->format == Format::DIMACS) {
+
+		header->comment = 'c';
+		header->record = "arcs";
+
+		first = Graph::headerToken(pos, end, line, header->comment);
+
+		const char* eol = std::find(*pos, end, '\n');
+
+		second = Graph::nextToken(pos, eol, &unused);
+
+		if (first != "p" || second != "sp") {
+
+			*error = "expected problem line 'p sp', found '" +
+				     std::string(first) + "'";
+
+			return false;
+		}
+
+		first = Graph::nextToken(pos, eol, &unused);
+		second = Graph::nextToken(pos, eol, &unused);
+
+	} else if (header->format == Format::MATRIX_MARKET) {
+
+		const char* eol = std::find(*pos, end, '\n');
+
+		header->comment = '%';
+		header->record = "entries";
+
+		std::string banner[5];
+
+		for (std::string& word : banner) {
+
+			word = std::string(Graph::nextToken(pos, eol, &unused));
+
+			std::transform(word.begin(), word.end(), word.begin(),
+				           [](unsigned char c) { return std::tolower(c); });
+		}
+
+		if (banner[0] != "%%matrixmarket" || banner[1] != "matrix" ||
+			banner[2] != "coordinate") {
+
+			*error = "expected '%%MatrixMarket matrix coordinate' header";
+
+			return false;
+		}
+
+		if (banner[3] != "pattern" && banner[3] != "integer" &&
+			banner[3] != "real") {
+
+			*error = "unsupported field '" + banner[3] + "'";
+
+			return false;
+		}
+
+		if (banner[4] != "general" && banner[4] != "symmetric") {
+
+			*error = "unsupported symmetry '" + banner[4] + "'";
+
+			return false;
+		}
+
+		header->weighted = (banner[3] != "pattern");
+		header->real = (banner[3] == "real");
+		header->symmetric = (banner[4] == "symmetric");
+
+		*pos = eol;
+		first = Graph::headerToken(pos, end, line, header->comment);
+		eol = std::find(*pos, end, '\n');
+		third = Graph::nextToken(pos, eol, &unused);
+		second = Graph::nextToken(pos, eol, &unused);
+
+		int columns;
+
+		if (!Graph::parseInt(third, &columns) ||
+			(Graph::parseInt(first, &vertices) && columns > vertices)) {
+
+			first = third;
+		}
+
+	} else {
+
+		header->comment = '%';
+		header->record = "neighbors";
+
+		first = Graph::headerToken(pos, end, line, header->comment);
+
+		const char* eol = std::find(*pos, end, '\n');
+
+		second = Graph::nextToken(pos, eol, &unused);
+		third = Graph::nextToken(pos, eol, &unused);
+		fourth = Graph::nextToken(pos, eol, &unused);
+
+		std::string flags = std::string(3 - std::min<std::size_t>(
+			third.size(), 3), '0') + std::string(third);
+		int weights(Graph::COUNT);
+
+		if (flags.size() != 3 ||
+			flags.find_first_not_of("01") != std::string::npos) {
+
+			*error = "expected METIS format, found '" + std::string(third) +
+				     "'";
+
+			return false;
+		}
+
+		if (!fourth.empty() && (!Graph::parseInt(fourth, &weights) ||
+			                    weights < Graph::COUNT)) {
+
+			*error = "expected number of Vertex weights, found '" +
+				     std::string(fourth) + "'";
+
+			return false;
+		}
+
+		header->weighted = (flags[2] == '1');
+		header->skip = ((flags[1] == '1') ? weights : Graph::EMPTY) +
+			           ((flags[0] == '1') ? Graph::COUNT : Graph::EMPTY);
+	}
+
+	if (!Graph::parseInt(first, &vertices) || vertices < Graph::EMPTY) {
+
+		*error = "expected number of Vertices, found '" + std::string(first) +
+			     "'";
+
+		return false;
+	}
+
+	if (!Graph::parseInt(second, &records) || records < Graph::EMPTY) {
+
+		*error = "expected number of " + header->record + ", found '" +
+			     std::string(second) + "'";
+
+		return false;
+	}
+
+	header->records = (header->format == Format::METIS) ? 2 * records :
+		                                                  records;
+	header->names.reserve(vertices);
+
+	for (int vertex(1); vertex <= vertices; ++vertex) {
+
+		header->names.push_back(std::to_string(vertex));
+	}
+
+	*pos = std::find(*pos, end, '\n');
+
+	if (*pos != end) {
+
+		++*pos;
+		++*line;
+	}
+
+	return true;
+}
+
+/*
+* Helper for parseHeader, gets the first token of the next line that is
+* not blank or a comment
+* @param pos Pointer to the position to read from, moved past the token
+* @param end The end of the text
+* @param line Pointer to the line number of pos
+* @param comment The first character of comment lines
+* @return the token, empty at the end of the text
+*/
+std::string_view Graph::headerToken(const char** pos, const char* end,
+	                                int* line, char comment) {
+
+	std::string_view token = Graph::nextToken(pos, end, line);
+
+	while (!token.empty() && token[0] == comment) {
+
+		*pos = std::find(*pos, end, '\n');
+		token = Graph::nextToken(pos, end, line);
+	}
+
+	return token;
+}
+
+/*
+* Helper for ReadFile, parses the records of whole lines, stopping at
+* the first line that is not valid
+* @param begin The start of the first line
+* @param end The end of the last line
+* @param header The FileHeader of the file
+* @param chunk The Chunk to fill, its vertex already set for METIS
+*/
+void Graph::parseChunk(const char* begin, const char* end,
+	                   const FileHeader& header, Chunk* chunk) {
+
+	Id vertex = (header.format == Format::METIS) ? chunk->vertex :
+		                                           Graph::NO_ID;
+
+	chunk->records = Graph::EMPTY;
+	chunk->lines = Graph::EMPTY;
+	chunk->lastLine = -1;
+	chunk->errorLine = -1;
+
+	for (const char* pos(begin); pos != end; ++chunk->lines) {
+
+		const char* eol = std::find(pos, end, '\n');
+
+		if ((header.format == Format::EDGES) ?
+			!Graph::parseEdges(pos, eol, chunk) :
+			!Graph::parseLine(pos, eol, header, &vertex, chunk)) {
+
+			chunk->errorLine = chunk->lines;
+
+			return;
+		}
+
+		if (eol == end) {
+
+			break;
+		}
+
+		pos = eol + 1;
+	}
+}
+
+/*
+* Helper for parseChunk, parses a line of "label label weight" Edges
+* @param pos The start of the line
+* @param eol The end of the line
+* @param chunk The Chunk to add Edges to
+* @return true if the line is valid, else false
+*/
+bool Graph::parseEdges(const char* pos, const char* eol, Chunk* chunk) {
+
+	int unused(Graph::EMPTY);
+
+	for (std::string_view from = Graph::nextToken(&pos, eol, &unused);
+		 !from.empty(); from = Graph::nextToken(&pos, eol, &unused)) {
+
+		std::string_view to = Graph::nextToken(&pos, eol, &unused),
+			             token = Graph::nextToken(&pos, eol, &unused);
+		Weight weight;
+
+		chunk->lastLine = chunk->lines;
+
+		if (to.empty() || !Graph::parseInt(token, &weight)) {
+
+			chunk->error = (to.empty()) ? "expected Edge ending label" :
+				           "expected Edge weight, found '" +
+				           std::string(token) + "'";
+
+			return false;
+		}
+
+		chunk->edges.emplace_back(from, to, weight);
+		++chunk->records;
+	}
+
+	return true;
+}
+
+/*
+* Helper for parseChunk, parses a line of a DIMACS, SNAP, Matrix Market
+* or METIS file
+* Comment lines are skipped, every other METIS line is a Vertex even when
+* blank
+* @param pos The start of the line
+* @param eol The end of the line
+* @param header The FileHeader of the file
+* @param vertex Pointer to the index of the next METIS Vertex
+* @param chunk The Chunk to add Edges to
+* @return true if the line is valid, else false
+*/
+bool Graph::parseLine(const char* pos, const char* eol,
+	                  const FileHeader& header, Id* vertex, Chunk* chunk) {
+
+	int unused(Graph::EMPTY);
+	std::string_view token = Graph::nextToken(&pos, eol, &unused);
+
+	if (!token.empty() && token[0] == header.comment) {
+
+		return true;
+	}
+
+	if (header.format == Format::METIS) {
+
+		return Graph::parseNeighbors(token, pos, eol, header, (*vertex)++,
+			                         chunk);
+	}
+
+	if (token.empty()) {
+
+		return true;
+	}
+
+	chunk->lastLine = chunk->lines;
+
+	if (header.format == Format::DIMACS) {
+
+		if (token != "a") {
+
+			chunk->error = "expected arc, found '" + std::string(token) + "'";
+
+			return false;
+		}
+
+		token = Graph::nextToken(&pos, eol, &unused);
+	}
+
+	return Graph::parseRecord(token, pos, eol, header, chunk);
+}
+
+/*
+* Helper for parseLine, parses the rest of a "from to weight" record
+* @param from The starting label
+* @param pos The position after the starting label
+* @param eol The end of the line
+* @param header The FileHeader of the file
+* @param chunk The Chunk to add Edges to
+* @return true if the record is valid, else false
+*/
+bool Graph::parseRecord(std::string_view from, const char* pos,
+	                    const char* eol, const FileHeader& header,
+	                    Chunk* chunk) {
+
+	int unused(Graph::EMPTY);
+	std::string_view to = Graph::nextToken(&pos, eol, &unused),
+		             token = Graph::nextToken(&pos, eol, &unused);
+	Weight weight(Graph::COUNT);
+
+	if (to.empty()) {
+
+		chunk->error = "expected Edge ending label";
+
+		return false;
+	}
+
+	if ((header.weighted || !token.empty()) &&
+		!Graph::parseWeight(token, header.real, &weight)) {
+
+		chunk->error = "expected Edge weight, found '" + std::string(token) +
+			           "'";
+
+		return false;
+	}
+
+	if (!header.names.empty() &&
+		(!Graph::parseVertex(from, header, &from, &chunk->error) ||
+		 !Graph::parseVertex(to, header, &to, &chunk->error))) {
+
+		return false;
+	}
+
+	chunk->edges.emplace_back(from, to, weight);
+	++chunk->records;
+
+	if (header.symmetric && from != to) {
+
+		chunk->edges.emplace_back(to, from, weight);
+	}
+
+	return true;
+}
+
+/*
+* Helper for parseLine, parses the neighbors of a METIS Vertex
+* Blank lines after the last Vertex are allowed
+* @param token The first token of the line
+* @param pos The position after the first token
+* @param eol The end of the line
+* @param header The FileHeader of the file
+* @param vertex The index of the Vertex
+* @param chunk The Chunk to add Edges to
+* @return true if the line is valid, else false
+*/
+bool Graph::parseNeighbors(std::string_view token, const char* pos,
+	                       const char* eol, const FileHeader& header,
+	                       Id vertex, Chunk* chunk) {
+
+	int unused(Graph::EMPTY);
+
+	if (vertex >= header.names.size()) {
+
+		if (!token.empty()) {
+
+			chunk->error = "expected " + std::to_string(header.names.size()) +
+				           " Vertices, found more";
+		}
+
+		return token.empty();
+	}
+
+	std::string_view from = header.names[vertex];
+
+	for (int skip(0); skip < header.skip && !token.empty(); ++skip) {
+
+		chunk->lastLine = chunk->lines;
+		token = Graph::nextToken(&pos, eol, &unused);
+	}
+
+	for (; !token.empty(); token = Graph::nextToken(&pos, eol, &unused)) {
+
+		std::string_view to;
+		Weight weight(Graph::COUNT);
+
+		chunk->lastLine = chunk->lines;
+
+		if (!Graph::parseVertex(token, header, &to, &chunk->error)) {
+
+			return false;
+		}
+
+		if (header.weighted) {
+
+			token = Graph::nextToken(&pos, eol, &unused);
+
+			if (!Graph::parseWeight(token, false, &weight)) {
+
+				chunk->error = "expected Edge weight, found '" +
+					           std::string(token) + "'";
+
+				return false;
+			}
+		}
+
+		chunk->edges.emplace_back(from, to, weight);
+		++chunk->records;
+	}
+
+	return true;
+}
+
+/*
+* Helper for ReadFile, converts a numbered Vertex to its label
+* @param token The token
+* @param header The FileHeader declaring the Vertices
+* @param label Pointer to store the label
+* @param error Pointer to store the reason the token is not a Vertex
+* @return true if the token is a number from 1 to n, else false
+*/
+bool Graph::parseVertex(std::string_view token, const FileHeader& header,
+	                    std::string_view* label, std::string* error) {
+
+	int vertex;
+
+	if (!Graph::parseInt(token, &vertex) || vertex < Graph::COUNT ||
+		static_cast<std::size_t>(vertex) > header.names.size()) {
+
+		*error = "expected Vertex from 1 to " +
+			     std::to_string(header.names.size()) + ", found '" +
+			     std::string(token) + "'";
+
+		return false;
+	}
+
+	*label = header.names[vertex - 1];
+
+	return true;
+}
+
+/*
+* Helper for ReadFile, converts a whole token to a weight
+* @param token The token
+* @param real True to round a real number, else integers only
+* @param weight Pointer to store the weight
+* @return true if the token is a weight, else false
+*/
+bool Graph::parseWeight(std::string_view token, bool real, Weight* weight) {
+
+	if (!real) {
+
+		return Graph::parseInt(token, weight);
+	}
+
+	const char* end = token.data() + token.size();
+	double value;
+
+	std::from_chars_result result = std::from_chars(token.data(), end, value);
+
+	if (token.empty() || result.ec != std::errc() || result.ptr != end ||
+		!(std::fabs(value) < INT_MAX)) {
+
+		return false;
+	}
+
+	*weight = static_cast<Weight>(std::lround(value));
+
+	return true;
+}
+
+/*
+* Helper for ReadFile, replaces the contents of Graph with the first
+* Edges of the chunks, following the rules of Connect, an Edge without an
+* ending label only adds its starting Vertex
+* Labels are sorted once to give every label a rank in label order and ids
+* in order of first appearance, as Connect would. Edges are then grouped
+* by starting rank with a counting sort and each group is sorted by ending
+* rank, which is the order of the adjacency lists, keeping the first of
+* duplicate Edges
+* @param chunks The parsed chunks in file order
+* @param count The number of Edges to add, at most the Edges parsed
+* @param pool The ThreadPool to sort on
+*/
+void Graph::build(const ChunkList& chunks, std::size_t count,
+	              ThreadPool* pool) {
+
+	using LabelRef = std::pair<std::string_view, std::size_t>;
+	using RankEdge = std::pair<Id, std::size_t>;
+
+	std::vector<const RawEdge*> edges;
+	std::vector<LabelRef> refs;
+
+	edges.reserve(count);
+	refs.reserve(2 * count);
+
+	for (const Chunk& chunk : chunks) {
+
+		for (std::size_t i(0); i < chunk.edges.size() &&
+			                   edges.size() < count; ++i) {
+
+			const RawEdge& edge = chunk.edges[i];
+
+			if (std::get<1>(edge).empty()) {
+
+				refs.emplace_back(std::get<0>(edge), 2 * edges.size());
+
+			} else if (std::get<0>(edge) != std::get<1>(edge)) {
+
+				refs.emplace_back(std::get<0>(edge), 2 * edges.size());
+				refs.emplace_back(std::get<1>(edge), 2 * edges.size() + 1);
+			}
+
+			edges.push_back(&edge);
+		}
+	}
+
+	std::vector<std::size_t> splits(pool->Size() + 1, refs.size());
+
+	pool->Run([&refs, &splits, pool](int worker) {
+
+		std::size_t begin, end;
+
+		pool->Split(refs.size(), worker, &begin, &end);
+
+		splits[worker] = begin;
+
+		std::sort(refs.begin() + begin, refs.begin() + end);
+	});
+
+	for (std::size_t width(1); width + 1 < splits.size(); width *= 2) {
+
+		for (std::size_t i(0); i + width + 1 < splits.size(); i += 2 * width) {
+
+			std::inplace_merge(refs.begin() + splits[i],
+				               refs.begin() + splits[i + width],
+				               refs.begin() + splits[std::min(i + 2 * width,
+					                                          splits.size() - 1)]);
+		}
+	}
+
+	std::vector<std::string_view> sorted;
+	std::vector<std::size_t> first;
+	IdList rank(2 * edges.size(), Graph::NO_ID);
+
+	for (const LabelRef& ref : refs) {
+
+		if (sorted.empty() || sorted.back() != ref.first) {
+
+			sorted.push_back(ref.first);
+			first.push_back(ref.second);
+		}
+
+		rank[ref.second] = static_cast<Id>(sorted.size() - 1);
+	}
+
+	std::size_t vertices = sorted.size();
+	IdList order(vertices), ids(vertices), offsets(vertices + 1, 0);
+
+	for (Id r(0); r < vertices; ++r) {
+
+		order[r] = r;
+	}
+
+	std::sort(order.begin(), order.end(), [&first](const Id& a, const Id& b) {
+
+		return first[a] < first[b];
+	});
+
+	this->labels.resize(vertices);
+	this->vertices.resize(vertices);
+
+	for (Id id(0); id < vertices; ++id) {
+
+		ids[order[id]] = id;
+		this->labels[id] = Label(sorted[order[id]]);
+	}
+
+	for (Id r(0); r < vertices; ++r) {
+
+		this->map.emplace_hint(this->map.end(), this->labels[ids[r]], ids[r]);
+	}
+
+	for (std::size_t i(0); i < edges.size(); ++i) {
+
+		if (rank[2 * i + 1] != Graph::NO_ID) {
+
+			++offsets[rank[2 * i] + 1];
+		}
+	}
+
+	for (Id r(0); r < vertices; ++r) {
+
+		offsets[r + 1] += offsets[r];
+	}
+
+	std::vector<RankEdge> grouped(offsets[vertices]);
+	IdList next(offsets.begin(), offsets.end() - 1), ends(vertices);
+
+	for (std::size_t i(0); i < edges.size(); ++i) {
+
+		if (rank[2 * i + 1] != Graph::NO_ID) {
+
+			grouped[next[rank[2 * i]]++] = RankEdge(rank[2 * i + 1], i);
+		}
+	}
+
+	pool->Run([&](int worker) {
+
+		std::size_t begin, end;
+
+		pool->Split(vertices, worker, &begin, &end);
+
+		for (std::size_t r(begin); r < end; ++r) {
+
+			std::vector<RankEdge>::iterator group = grouped.begin() + offsets[r];
+
+			std::sort(group, grouped.begin() + offsets[r + 1]);
+
+			ends[r] = static_cast<Id>(std::unique(group,
+				grouped.begin() + offsets[r + 1],
+				[](const RankEdge& a, const RankEdge& b) {
+
+					return a.first == b.first;
+				}) - grouped.begin());
+		}
+	});
+
+	for (Id r(0); r < vertices; ++r) {
+
+		Edge* head = nullptr;
+
+		for (Id e(ends[r]); e > offsets[r]; --e) {
+
+			const RankEdge& edge = grouped[e - 1];
+
+			head = this->edgeArena()->allocate(ids[edge.first],
+				std::get<2>(*edges[edge.second]), head);
+		}
+
+		this->vertices[ids[r]] = Vertex(head, ends[r] - offsets[r]);
+		this->edges += ends[r] - offsets[r];
+	}
+}
+
+/*
+* Helper for ReadFile, gets the next whitespace separated token
+* @param pos Pointer to the position to read from, moved past the token
+* @param end The end of the text
+* @param line Pointer to the line number, counts the lines skipped unless
+* the text ends, so errors at the end name the last line with a token
+* @return the token, empty at the end of the text
+*/
+std::string_view Graph::nextToken(const char** pos, const char* end,
+	                              int* line) {
+
+	const char* curr = *pos;
+	int lines(Graph::EMPTY);
+
+	while (curr != end && std::isspace(static_cast<unsigned char>(*curr))) {
+
+		lines += (*curr == '\n');
+
+		++curr;
+	}
+
+	const char* start = curr;
+
+	while (curr != end && !std::isspace(static_cast<unsigned char>(*curr))) {
+
+		++curr;
+	}
+
+	*pos = curr;
+	*line += (start != end) ? lines : Graph::EMPTY;
+
+	return std::string_view(start, curr - start);
+}
+
+/*
+* Helper for ReadFile, converts a whole token to an integer
+* @param token The token
+* @param value Pointer to store the integer
+* @return true if the token is an integer, else false
+*/
+bool Graph::parseInt(std::string_view token, int* value) {
+
+	const char* end = token.data() + token.size();
+
+	std::from_chars_result result = std::from_chars(token.data(), end, *value);
+
+	return !token.empty() && result.ec == std::errc() && result.ptr == end;
+}
+
+/*
+* Helper for GetEdges, appends an Edge as "label(weight)"
+* @param text The string to append to
+* @param label The label of the adjacent Vertex
+* @param weight The weight of the Edge
+*/
+void Graph::appendEdge(std::string* text, std::string_view label,
+	                   const Weight& weight) {
+
+	text->append(label);
+	*text += Graph::LEFT_P;
+	Graph::appendWeight(text, weight);
+	*text += Graph::RIGHT_P;
+}
+
+/*
+* Helper for GetEdges, appends a weight in decimal without building a
+* temporary string
+* A Weight fits in the digits of its type, a sign and a leading digit
+* @param text The string to append to
+* @param weight The weight to append
+*/
+void Graph::appendWeight(std::string* text, const Weight& weight) {
+
+	char digits[std::numeric_limits<Weight>::digits10 + 2];
+
+	std::to_chars_result result = std::to_chars(digits, std::end(digits),
+		                                        weight);
+
+	text->append(digits, result.ptr);
+}
+
+/*
+* Helper for Dijkstra, repeatedly settles the closest Vertex in the heap
+* and relaxes its outgoing Edges, entries of settled Vertices are stale
+* and skipped
+* Settled Vertices are never reached again, so the search ends even when
+* negative Edges form a cycle
+* @param workspace The ShortestPathWorkspace holding the search
+*/
+void Graph::dijkstra(ShortestPathWorkspace* workspace) const {
+
+	WeightQ& heap = workspace->heap;
+
+	while (!heap.empty()) {
+
+		Id currId = std::get<2>(heap.top());
+
+		heap.pop();
+
+		if (workspace->settle(currId)) {
+
+			this->update(this->vertices[currId].getNext(), currId,
+				         workspace);
+		}
+	}
+}
+
+/*
+* Helper for Dijkstra, orders heap entries by weight, then by label, so
+* Vertices at equal distance are settled in label order as they were
+* before ids were interned
+* @param a The first entry
+* @param b The second entry
+* @return true if a is settled after b, else false
+*/
+bool Graph::settlesAfter(const WeightId& a, const WeightId& b) {
+
+	return std::get<0>(a) > std::get<0>(b) ||
+		   (std::get<0>(a) == std::get<0>(b) &&
+			*std::get<1>(a) > *std::get<1>(b));
+}
+
+/*
+* Helper for the batched Dijkstra and DistanceTable, searches from every
+* source in the workspace of the worker that takes it, sources are
+* taken one at a time so uneven searches balance out
+* An exception on a worker stops every worker from taking another source,
+* ThreadPool::Run rethrows it once all workers stopped
+* @param sources The labels of the origin Vertices
+* @param sink The callable to call with the index of each source and
+* the workspace holding its search
+* @param pool The ThreadPool to search on
+*/
+void Graph::dijkstra(const LabelList& sources, const SearchSink& sink,
+	                 ThreadPool* pool) const {
+
+	std::vector<ShortestPathWorkspace> workspaces(pool->Size());
+	std::atomic<std::size_t> next(0);
+
+	pool->Run([&](int worker) {
+
+		ShortestPathWorkspace& workspace = workspaces[worker];
+
+		try {
+
+			for (std::size_t source(next++); source < sources.size();
+				 source = next++) {
+
+				this->Dijkstra(sources[source], workspace);
+
+				sink(source, workspace);
+			}
+
+		} catch (...) {
+
+			next = sources.size();
+
+			throw;
+		}
+	});
+}
+
+/*
+* Helper for dijkstra, updates the distance of every unsettled Vertex
+* adjacent to the current Vertex if there is a shorter path through it
+* @param curr The first Edge of the current Vertex
+* @param currId The id of the current Vertex
+* @param workspace The ShortestPathWorkspace holding the search
+*/
+void Graph::update(const Edge* curr, const Id& currId,
+	               ShortestPathWorkspace* workspace) const {
+
+	Weight dist = workspace->dist[currId];
+
+	while (curr != nullptr) {
+
+		workspace->reach(curr->getId(), dist + curr->getWeight(), currId);
+
+		curr = curr->getNext();
+	}
+}
+
+/*
+* Helper for Dijkstra, records reached Vertices in WeightMap and PrevMap
+* leaving out the origin and Vertices with a path of cost 0 in the
+* WeightMap
+* @param workspace The ShortestPathWorkspace holding the search
+* @param wMap The WeightMap
+* @param pMap The PrevMap
+*/
+void Graph::cleanWeights(const ShortestPathWorkspace* workspace,
+	                     WeightMap* wMap, PrevMap* pMap) const {
+
+	for (const Id& id : workspace->reached) {
+
+		if (id != workspace->origin) {
+
+			if (workspace->dist[id] != Graph::NO_WEIGHT) {
+
+				(*wMap)[this->labels[id]] = workspace->dist[id];
+			}
+
+			(*pMap)[this->labels[id]] = this->labels[workspace->prev[id]];
+		}
+	}
+}
+
+/*
+* Helper for MinSpanningTree, adds the Edges from a Vertex to unvisited
+* Vertices as candidates
+* @param id The id of the Vertex
+* @param visited The visited marks
+* @param heap The candidate Edges
+*/
+void Graph::addCandidates(const Id& id, const VisitedSet* visited,
+	                      EdgeQ* heap) const {
+
+	const Edge* next = this->vertices[id].getNext();
+
+	while (next != nullptr) {
+
+		if (!visited->IsVisited(next->getId())) {
+
+			heap->emplace(next->getWeight(), id, next->getId());
+		}
+
+		next = next->getNext();
+	}
+}
+
+/*
+* Constructs empty VisitedSet
+*/
+Graph::VisitedSet::VisitedSet() :epoch(Graph::EMPTY) {}
+
+/*
+* Starts a new traversal, no Vertex is visited afterwards
+* Marks are only cleared when the traversal number wraps around
+* @param size The number of Vertex ids the traversal may visit
+*/
+void Graph::VisitedSet::Reset(std::size_t size) {
+
+	if (this->stamps.size() < size) {
+
+		this->stamps.resize(size, Graph::EMPTY);
+	}
+
+	if (++this->epoch == Graph::EMPTY) {
+
+		std::fill(this->stamps.begin(), this->stamps.end(), Graph::EMPTY);
+
+		this->epoch = Graph::COUNT;
+	}
+}
+
+/*
+* Marks a Vertex as visited
+* @param id The id of the Vertex
+* @return true if the Vertex was not visited before, else false
+*/
+bool Graph::VisitedSet::Visit(const Id& id) {
+
+	if (this->stamps[id] == this->epoch) {
+
+		return false;
+	}
+
+	this->stamps[id] = this->epoch;
+
+	return true;
+}
+
+/*
+* Returns true if Vertex visited, else false
+* @param id The id of the Vertex
+* @return true if Vertex visited, else false
+*/
+bool Graph::VisitedSet::IsVisited(const Id& id) const {
+
+	return this->stamps[id] == this->epoch;
+}
+
+/*
+* Constructs empty ShortestPathWorkspace
+*/
+Graph::ShortestPathWorkspace::ShortestPathWorkspace()
+
+	:graph(nullptr), origin(Graph::NO_ID), epoch(Graph::EMPTY),
+	 heap(Graph::settlesAfter) {}
+
+/*
+* Starts a new search, no Vertex is reached afterwards
+* The arrays only grow, so a workspace can move between Graphs
+* @param graph The Graph to search
+* @param origin The id of the origin Vertex, NO_ID for an empty search
+*/
+void Graph::ShortestPathWorkspace::reset(const Graph* graph,
+	                                     const Id& origin) {
+
+	std::size_t size = graph->vertices.size();
+
+	this->graph = graph;
+	this->origin = origin;
+
+	if (this->stamps.size() < size) {
+
+		this->stamps.resize(size, Graph::EMPTY);
+		this->settled.resize(size, Graph::EMPTY);
+		this->dist.resize(size);
+		this->prev.resize(size);
+	}
+
+	if (++this->epoch == Graph::EMPTY) {
+
+		std::fill(this->stamps.begin(), this->stamps.end(), Graph::EMPTY);
+		std::fill(this->settled.begin(), this->settled.end(), Graph::EMPTY);
+
+		this->epoch = Graph::COUNT;
+	}
+
+	this->reached.clear();
+}
+
+/*
+* Returns true if Vertex reached by the current search, else false
+* @param id The id of the Vertex
+* @return true if Vertex reached, else false
+*/
+bool Graph::ShortestPathWorkspace::isReached(const Id& id) const {
+
+	return this->stamps[id] == this->epoch;
+}
+
+/*
+* Marks a Vertex as settled, its distance no longer changes
+* @param id The id of the Vertex
+* @return true if the Vertex was not settled before, else false
+*/
+bool Graph::ShortestPathWorkspace::settle(const Id& id) {
+
+	if (this->settled[id] == this->epoch) {
+
+		return false;
+	}
+
+	this->settled[id] = this->epoch;
+
+	return true;
+}
+
+/*
+* Records a path to an unsettled Vertex if it is shorter than the one
+* known
+* @param id The id of the Vertex
+* @param weight The cost of the path
+* @param from The id of the previous Vertex on the path
+* @return true if the path is shorter, else false
+*/
+bool Graph::ShortestPathWorkspace::reach(const Id& id, const Weight& weight,
+	                                     const Id& from) {
+
+	if (this->settled[id] == this->epoch) {
+
+		return false;
+	}
+
+	if (!this->isReached(id)) {
+
+		this->stamps[id] = this->epoch;
+
+		this->reached.push_back(id);
+
+	} else if (weight >= this->dist[id]) {
+
+		return false;
+	}
+
+	this->dist[id] = weight;
+	this->prev[id] = from;
+
+	this->heap.emplace(weight, &this->graph->labels[id], id);
+
+	return true;
+}
+
+/*
+* Constructs ShortestPaths over the last search of a workspace
+* @param workspace The ShortestPathWorkspace searched in
+*/
+Graph::ShortestPaths::ShortestPaths(const ShortestPathWorkspace* workspace)
+
+	:workspace(workspace) {}
+
+/*
+* Get the label of the origin Vertex
+* @return label of the origin Vertex, NO_LABEL if it was not found
+*/
+const Graph::Label& Graph::ShortestPaths::Origin() const {
+
+	return (this->workspace->origin == Graph::NO_ID) ? Graph::NO_LABEL :
+		   this->workspace->graph->labels[this->workspace->origin];
+}
+
+/*
+* Get the number of Vertices reached, including the origin
+* @return number of Vertices reached
+*/
+int Graph::ShortestPaths::NumberOfReached() const {
+
+	return static_cast<int>(this->workspace->reached.size());
+}
+
+/*
+* Get the cost of the shortest path to a Vertex
+* @param label The label of the Vertex
+* @return cost of the shortest path, INT_MAX if there is no path
+*/
+Graph::Weight Graph::ShortestPaths::Distance(const Label& label) const {
+
+	Id id = this->find(label);
+
+	return (id == Graph::NO_ID) ? INT_MAX : this->workspace->dist[id];
+}
+
+/*
+* Get the Vertex before another on its shortest path
+* @param label The label of the Vertex
+* @return label of the previous Vertex, NO_LABEL for the origin or if
+* there is no path
+*/
+const Graph::Label& Graph::ShortestPaths::Previous(const Label& label) const {
+
+	Id id = this->find(label);
+
+	if (id == Graph::NO_ID || id == this->workspace->origin) {
+
+		return Graph::NO_LABEL;
+	}
+
+	return this->workspace->graph->labels[this->workspace->prev[id]];
+}
+
+/*
+* Get the shortest path to a Vertex
+* @param label The label of the Vertex
+* @param path The Path to fill with labels from origin to the Vertex,
+* empty if there is no path
+* @return cost of the shortest path, INT_MAX if there is no path
+*/
+Graph::Weight Graph::ShortestPaths::GetPath(const Label& label,
+	                                        Path& path) const {
+
+	Id id = this->find(label);
+
+	path.clear();
+
+	if (id == Graph::NO_ID) {
+
+		return INT_MAX;
+	}
+
+	for (Id curr(id); curr != Graph::NO_ID;
+		 curr = this->workspace->prev[curr]) {
+
+		path.push_back(this->workspace->graph->labels[curr]);
+	}
+
+	std::reverse(path.begin(), path.end());
+
+	return this->workspace->dist[id];
+}
+
+/*
+* Gets the id of a reached Vertex
+* @param label The label of the Vertex
+* @return id of the Vertex, or NO_ID if not found or not reached
+*/
+Graph::Id Graph::ShortestPaths::find(const Label& label) const {
+
+	if (this->workspace->graph == nullptr) {
+
+		return Graph::NO_ID;
+	}
+
+	Id id = this->workspace->graph->find(label);
+
+	return (id != Graph::NO_ID && this->workspace->isReached(id)) ?
+		   id : Graph::NO_ID;
+}
+
+/*
+* Constructs EdgeStream reading from an istream
+* @param in The istream to read from, such as std::cin
+* @param name The name of the stream in errors
+*/
+Graph::EdgeStream::EdgeStream(std::istream& in, const std::string& name)
+
+	:in(&in), name(name), lines(Graph::EMPTY) {}
+
+/*
+* Returns true if records may follow, else false
+* @return false once the stream ended or stopped, else true
+*/
+bool Graph::EdgeStream::Good() const {
+
+	return this->error.empty() && this->in->good();
+}
+
+/*
+* Gets the reason the stream stopped
+* @return the error as "name:line: message", empty if none
+*/
+const std::string& Graph::EdgeStream::Error() const {
+
+	return this->error;
+}
+
+/*
+* Gets the number of lines read
+* @return the number of lines read
+*/
+int Graph::EdgeStream::Lines() const {
+
+	return this->lines;
+}
+
+/*
+* Reads up to limit records, stopping at the end of the stream or at the
+* first line that is not valid
+* Lines are read one at a time, so a batch never waits for more input
+* than its records need. Labels are assigned into the records of earlier
+* batches to reuse their storage
+* @param limit The largest number of records to read
+* @return the number of records read
+*/
+std::size_t Graph::EdgeStream::read(std::size_t limit) {
+
+	std::size_t count(0);
+
+	while (count < limit && this->error.empty() &&
+		   std::getline(*this->in, this->line)) {
+
+		const char* pos = this->line.data();
+		const char* end = pos + this->line.size();
+		int unused(Graph::EMPTY);
+
+		++this->lines;
+
+		std::string_view from = Graph::nextToken(&pos, end, &unused);
+
+		if (from.empty()) {
+
+			continue;
+		}
+
+		bool remove = (from == "-");
+
+		from = (remove) ? Graph::nextToken(&pos, end, &unused) : from;
+
+		std::string_view to = Graph::nextToken(&pos, end, &unused),
+			             token = (remove) ? std::string_view() :
+			                     Graph::nextToken(&pos, end, &unused),
+			             extra = Graph::nextToken(&pos, end, &unused);
+		Weight weight(Graph::NO_WEIGHT);
+		std::string message;
+
+		if (from.empty()) {
+
+			message = "expected Edge starting label";
+
+		} else if (to.empty()) {
+
+			message = "expected Edge ending label";
+
+		} else if (!remove && !Graph::parseInt(token, &weight)) {
+
+			message = "expected Edge weight, found '" + std::string(token) +
+				      "'";
+
+		} else if (!extra.empty()) {
+
+			message = "expected end of line, found '" + std::string(extra) +
+				      "'";
+		}
+
+		if (!message.empty()) {
+
+			this->error = this->name + ":" + std::to_string(this->lines) +
+				          ": " + message;
+
+			break;
+		}
+
+		if (count == this->records.size()) {
+
+			this->records.emplace_back();
+		}
+
+		Record& record = this->records[count++];
+
+		record.from.assign(from);
+		record.to.assign(to);
+		record.weight = weight;
+		record.remove = remove;
+	}
+
+	return count;
+}
+
+/*
+* Constructs Traversal from a Vertex
+* @param graph The Graph to traverse
+* @param origin The id of the origin Vertex, NO_ID for an empty range
+* @param depthFirst True for depth-first, false for breadth-first order
+*/
+Graph::Traversal::Traversal(const Graph* graph, const Id& origin,
+	                        bool depthFirst)
+
+	:graph(graph), depthFirst(depthFirst), current(origin),
+	depth(Graph::EMPTY), skipped(false) {
+
+	if (origin != Graph::NO_ID) {
+
+		this->visited.Reset(graph->vertices.size());
+		this->visited.Visit(origin);
+	}
+}
+
+/*
+* Gets an Iterator at the current Vertex
+* @return Iterator at the current Vertex
+*/
+Graph::Traversal::Iterator Graph::Traversal::begin() {
+
+	return Iterator(this);
+}
+
+/*
+* Gets the Iterator past the last Vertex
+* @return Iterator past the last Vertex
+*/
+Graph::Traversal::Iterator Graph::Traversal::end() {
+
+	return Iterator();
+}
+
+/*
+* Gets the number of Edges from the origin to the current Vertex
+* @return depth of the current Vertex
+*/
+int Graph::Traversal::Depth() const {
+
+	return this->depth;
+}
+
+/*
+* Leaves out the adjacent Vertices of the current Vertex
+*/
+void Graph::Traversal::Skip() {
+
+	this->skipped = true;
+}
+
+/*
+* Moves to the next Vertex, expanding the current one unless skipped
+* Depth-first order resumes the stack where DFS would, breadth-first order
+* queues the unvisited adjacent Vertices before taking the next one
+*/
+void Graph::Traversal::advance() {
+
+	const Edge* edge = (this->skipped) ? nullptr :
+		               this->graph->vertices[this->current].getNext();
+
+	this->skipped = false;
+
+	if (this->depthFirst) {
+
+		if (edge != nullptr) {
+
+			this->stack.emplace(this->current, edge);
+		}
+
+		while (!this->stack.empty()) {
+
+			const Edge*& next = this->stack.top().second;
+
+			while (next != nullptr && this->visited.IsVisited(next->getId())) {
+
+				next = next->getNext();
+			}
+
+			if (next == nullptr) {
+
+				this->stack.pop();
+
+			} else {
+
+				this->current = next->getId();
+				this->depth = static_cast<int>(this->stack.size());
+
+				this->visited.Visit(this->current);
+
+				return;
+			}
+		}
+
+	} else {
+
+		while (edge != nullptr) {
+
+			if (this->visited.Visit(edge->getId())) {
+
+				this->q.emplace(edge->getId(), this->depth + Graph::COUNT);
+			}
+
+			edge = edge->getNext();
+		}
+
+		if (!this->q.empty()) {
+
+			this->current = this->q.front().first;
+			this->depth = this->q.front().second;
+
+			this->q.pop();
+
+			return;
+		}
+	}
+
+	this->current = Graph::NO_ID;
 }
 
 /*
-* Mark all verticies as unvisited
+* Constructs Iterator at the current Vertex of a Traversal
+* @param traversal The Traversal, defaults to none for the end
 */
-void Graph::unvisitVertices() {
+Graph::Traversal::Iterator::Iterator(Traversal* traversal)
 
-	for (const LabelVert& pair : this->map) {
+	:traversal(traversal) {}
 
-		pair.second->setVisited(false);
-	}
+/*
+* Gets the label of the current Vertex
+* @return label of the current Vertex
+*/
+Graph::Traversal::Iterator::reference
+Graph::Traversal::Iterator::operator*() const {
+
+	return this->traversal->graph->labels[this->traversal->current];
 }
 
 /*
-* Constructs Vertex with given Label
-* @param label The lable of the Vertex, default to blank
-* @param weight The weight of the Vertex, default to -1
-* @param next The next Vertex in the list
+* Gets the label of the current Vertex
+* @return pointer to label of the current Vertex
 */
-Graph::Vertex::Vertex(const Label& label, const Weight& weight, Vertex* next,
-	                  const int& edges)
-	
-	:label(label), weight(weight), visited(false), next(next), edges(edges) {
+Graph::Traversal::Iterator::pointer
+Graph::Traversal::Iterator::operator->() const {
+
+	return &**this;
 }
 
 /*
-* Copy constructor with pointers
-* @param other The other Vertex to copy
+* Moves to the next Vertex of the Traversal
+* @return this by reference
 */
-Graph::Vertex::Vertex(const Vertex& other)
-	
-	:label(other.label), weight(other.weight), visited(false), next(nullptr),
-	edges(other.edges) {
+Graph::Traversal::Iterator& Graph::Traversal::Iterator::operator++() {
 
-	*this = other;
+	this->traversal->advance();
+
+	return *this;
 }
 
 /*
-* Assignment operator overload
-* @param other The other Vertex to copy
-* @return this by reference
+* Moves to the next Vertex of the Traversal
+* @return Postfix holding the label of the Vertex before the move
 */
-Graph::Vertex& Graph::Vertex::operator=(const Vertex& other) {
+Graph::Traversal::Iterator::Postfix
+Graph::Traversal::Iterator::operator++(int) {
 
-	Vertex* curr = this,
-		  * nextCurr = other.next;
+	Postfix previous(&**this);
 
-	while (nextCurr != nullptr) {
+	this->traversal->advance();
 
-		curr->next = new Vertex(other.label, other.weight);
+	return previous;
+}
 
-		nextCurr = nextCurr->next;
-		curr = curr->next;
-	}
+/*
+* Constructs Postfix holding a label
+* @param label The label of the Vertex before the increment
+*/
+Graph::Traversal::Iterator::Postfix::Postfix(const Label* label)
 
-	return *this;
+	:label(label) {}
+
+/*
+* Gets the label of the Vertex before the increment
+* @return label of the Vertex before the increment
+*/
+const Graph::Label& Graph::Traversal::Iterator::Postfix::operator*() const {
+
+	return *this->label;
 }
 
 /*
-* Destroys Vertex
+* Checks if two Iterators are both at the end or both not
+* @param other The other Iterator
+* @return true if equal, else false
 */
-Graph::Vertex::~Vertex() {}
+bool Graph::Traversal::Iterator::operator==(const Iterator& other) const {
+
+	return this->atEnd() == other.atEnd();
+}
 
 /*
-* Gets Vertex label
-* @return Vertex label
+* Checks if two Iterators are not equal
+* @param other The other Iterator
+* @return true if not equal, else false
 */
-Graph::Label Graph::Vertex::getLabel() const {
+bool Graph::Traversal::Iterator::operator!=(const Iterator& other) const {
 
-	return this->label;
+	return !(*this == other);
 }
 
 /*
-* Gets Edge Weight (for adjacent Vertices)
-* @return Edge Weight
+* Returns true if the Iterator is past the last Vertex
+* @return true if at the end, else false
 */
-Graph::Weight Graph::Vertex::getWeight() const {
+bool Graph::Traversal::Iterator::atEnd() const {
 
-	return this->weight;
+	return this->traversal == nullptr ||
+		   this->traversal->current == Graph::NO_ID;
 }
 
 /*
-* Returns true if Vertex visited, else false
-* @return true if Vertex visited, else false
+* Constructs Edge to a given Vertex
+* @param id The id of the adjacent Vertex
+* @param weight The weight of the Edge
+* @param next The next Edge in the list
 */
-bool Graph::Vertex::isVisited() const {
-	
-	return this->visited;
+Graph::Edge::Edge(const Id& id, const Weight& weight, Edge* next)
+
+	:id(id), weight(weight), next(next) {}
+
+/*
+* Gets the id of the adjacent Vertex
+* @return id of the adjacent Vertex
+*/
+Graph::Id Graph::Edge::getId() const {
+
+	return this->id;
 }
 
 /*
-* Sets the Vertex as visited or unvisited
-* @param visited The boolean to indicated if visited(true) or
-* unvisited(false)
+* Gets Edge Weight
+* @return Edge Weight
 */
-void Graph::Vertex::setVisited(bool visited) {
+Graph::Weight Graph::Edge::getWeight() const {
 
-	this->visited = visited;
+	return this->weight;
 }
 
 /*
-* Gets the pointer to next Vertex in the adjacency list
-* @retrun pointer to next Vertex in the adjacency list
+* Gets the pointer to next Edge in the adjacency list
+* @return pointer to next Edge in the adjacency list
 */
-Graph::Vertex* Graph::Vertex::getNext() const {
+Graph::Edge* Graph::Edge::getNext() const {
 
 	return this->next;
 }
 
 /*
-* Sets next to new Vertex in the adjacency list
-* @param pointer to next Vertex in the adjacency list to add
+* Sets next to another Edge in the adjacency list
+* @param next pointer to next Edge in the adjacency list
 */
-void Graph::Vertex::setNext(Vertex* next) {
+void Graph::Edge::setNext(Edge* next) {
 
 	this->next = next;
 }
 
+/*
+* Constructs EdgeArena without slabs
+*/
+Graph::EdgeArena::EdgeArena()
+
+	:used(Graph::EMPTY), free(nullptr), restored(nullptr) {}
+
+/*
+* Frees all slabs
+*/
+Graph::EdgeArena::~EdgeArena() {
+
+	this->clear();
+}
+
+/*
+* Allocates an Edge
+* Takes a released Edge if any, moving the restored Edges to the released
+* ones once they ran out, else the next Edge of the last slab, adding a
+* slab twice the size of the last one when it is full
+* @param id The id of the adjacent Vertex
+* @param weight The weight of the Edge
+* @param next The next Edge in the list
+* @return pointer to the new Edge
+*/
+Graph::Edge* Graph::EdgeArena::allocate(const Id& id, const Weight& weight,
+	                                    Edge* next) {
+
+	if (this->free == nullptr &&
+		this->restored.load(std::memory_order_relaxed) != nullptr) {
+
+		this->free = this->restored.exchange(nullptr,
+			                                 std::memory_order_acquire);
+	}
+
+	Edge* edge = this->free;
+
+	if (edge != nullptr) {
+
+		this->free = edge->getNext();
+
+	} else {
+
+		if (this->slabs.empty() || this->used == this->slabs.back().second) {
+
+			std::size_t size = (this->slabs.empty()) ? EdgeArena::FIRST_SIZE :
+				               std::min(2 * this->slabs.back().second,
+				                        EdgeArena::SLAB_SIZE);
+
+			this->slabs.emplace_back(std::allocator<Edge>().allocate(size),
+				                     size);
+			this->used = Graph::EMPTY;
+		}
+
+		edge = this->slabs.back().first + this->used++;
+	}
+
+	return new (edge) Edge(id, weight, next);
+}
+
+/*
+* Releases an Edge to be reused by allocate
+* @param edge The Edge, no longer in any list
+*/
+void Graph::EdgeArena::release(Edge* edge) {
+
+	edge->setNext(this->free);
+	this->free = edge;
+}
+
+/*
+* Releases a list of Edges to be reused by allocate, from any thread
+* The list is linked in front of the restored Edges with a single
+* exchange, allocate only ever takes all of them at once
+* @param first The first Edge of the list, no longer in any adjacency list
+*/
+void Graph::EdgeArena::restore(Edge* first) {
+
+	Edge* last = first;
+
+	while (last->getNext() != nullptr) {
+
+		last = last->getNext();
+	}
+
+	Edge* head = this->restored.load(std::memory_order_relaxed);
+
+	do {
+
+		last->setNext(head);
+
+	} while (!this->restored.compare_exchange_weak(head, first,
+		                                           std::memory_order_release,
+		                                           std::memory_order_relaxed));
+}
+
+/*
+* Frees all slabs, every Edge allocated before is invalid
+* Edges need no destructor, so the slabs are freed without visiting them
+*/
+void Graph::EdgeArena::clear() {
+
+	for (const Slab& slab : this->slabs) {
+
+		std::allocator<Edge>().deallocate(slab.first, slab.second);
+	}
+
+	this->slabs.clear();
+	this->used = Graph::EMPTY;
+	this->free = nullptr;
+	this->restored = nullptr;
+}
+
+/*
+* Get the memory held by the slabs
+* @return number of bytes held
+*/
+std::size_t Graph::EdgeArena::bytes() const {
+
+	std::size_t edges(Graph::EMPTY);
+
+	for (const Slab& slab : this->slabs) {
+
+		edges += slab.second;
+	}
+
+	return edges * sizeof(Edge) + this->slabs.capacity() * sizeof(Slab);
+}
+
+/*
+* Constructs Vertex with given adjacency list
+* @param next The first Edge in the list, default to none
+* @param edges The number of Edges in the list, default to 0
+*/
+Graph::Vertex::Vertex(Edge* next, const int& edges)
+
+	:next(next), shared(nullptr), edges(edges) {}
+
+/*
+* Copy constructor, the copy refers to the same adjacency list
+* @param other The other Vertex to copy
+*/
+Graph::Vertex::Vertex(const Vertex& other)
+
+	:next(other.next), shared(other.getShare()), edges(other.edges) {}
+
+/*
+* Assignment operator, refers to the adjacency list of other
+* @param other The other Vertex to copy
+* @return this by reference
+*/
+Graph::Vertex& Graph::Vertex::operator=(const Vertex& other) {
+
+	this->next = other.next;
+	this->shared.store(other.getShare(), std::memory_order_relaxed);
+	this->edges = other.edges;
+
+	return (*this);
+}
+
+/*
+* Gets the holds on the adjacency list if it is shared
+* @return pointer to the Share, nullptr if only one Graph holds it
+*/
+Graph::Share* Graph::Vertex::getShare() const {
+
+	return this->shared.load(std::memory_order_acquire);
+}
+
+/*
+* Adds the hold of a copy on the adjacency list, an empty list is not
+* shared
+* A list not shared yet is held by the Graph copied and the copy. Copies
+* on several threads race to publish their Share, the others hold the
+* published Share and leave their own unused
+* @param fresh Pointer to the next unused Share of the copy, taken and
+* moved past if the list was not shared yet
+*/
+void Graph::Vertex::share(Share** fresh) const {
+
+	if (this->next == nullptr) {
+
+		return;
+	}
+
+	Share* shared = this->getShare();
+
+	if (shared == nullptr) {
+
+		(*fresh)->owners.store(Graph::COUNT + Graph::COUNT,
+			                   std::memory_order_relaxed);
+
+		if (this->shared.compare_exchange_strong(shared, *fresh,
+			                                     std::memory_order_acq_rel,
+			                                     std::memory_order_acquire)) {
+
+			++(*fresh);
+
+			return;
+		}
+	}
+
+	shared->owners.fetch_add(Graph::COUNT, std::memory_order_relaxed);
+}
+
+/*
+* Drops the hold of a Graph on the shared adjacency list
+* The last hold gives its Edges back to their EdgeArena unless they are
+* kept, and the last Share in use deletes its ShareBlock
+* @param restore True to give the Edges back to their EdgeArena if no
+* other Graph holds the list, false to keep them
+*/
+void Graph::Vertex::leave(bool restore) {
+
+	if (this->getShare()->owners.fetch_sub(Graph::COUNT,
+		                               std::memory_order_acq_rel) ==
+		Graph::COUNT) {
+
+		ShareBlock* block = this->getShare()->block;
+
+		if (restore) {
+
+			block->arena->restore(this->next);
+		}
+
+		block->release(Graph::COUNT);
+	}
+
+	this->shared.store(nullptr, std::memory_order_relaxed);
+}
+
+/*
+* Constructs ShareBlock of unused Shares
+* @param count The number of Shares
+* @param arena The EdgeArena of the lists to share
+*/
+Graph::ShareBlock::ShareBlock(int count,
+	                          const std::shared_ptr<EdgeArena>& arena)
+
+	:live(count), arena(arena), shares(new Share[count]) {
+
+	for (int i(0); i < count; ++i) {
+
+		this->shares[i].block = this;
+	}
+}
+
+/*
+* Gives back Shares that are no longer in use, the last one deletes the
+* ShareBlock
+* @param count The number of Shares given back
+*/
+void Graph::ShareBlock::release(int count) {
+
+	if (count != Graph::EMPTY &&
+		this->live.fetch_sub(count, std::memory_order_acq_rel) == count) {
+
+		delete this;
+	}
+}
+
+/*
+* Gets the pointer to first Edge in the adjacency list
+* @return pointer to first Edge in the adjacency list
+*/
+Graph::Edge* Graph::Vertex::getNext() const {
+
+	return this->next;
+}
+
 /*
 * Counts all Edges for a Vertex
 * @return number of Edges connected from Vertex
@@ -817,54 +2992,76 @@ int Graph::Vertex::numOfEdges() const {
 }
 
 /*
-* Gets string representation of Edges & adjacent Vertices
-* @return string representation of Edges & adjacent Vertices
+* Appends string representation of Edges & adjacent Vertices
+* @param labels The labels indexed by id
+* @param edges The string to append to
 */
-std::string Graph::Vertex::getEdges() const {
-
-	std::string edges;
+void Graph::Vertex::getEdges(const LabelList& labels,
+	                         std::string* edges) const {
 
-	Vertex* curr = this->next;
+	Edge* curr = this->next;
 
 	while (curr != nullptr) {
 
-		edges += curr->toString();
+		Graph::appendEdge(edges, labels[curr->getId()], curr->getWeight());
 
-		if (curr->next != nullptr) {
+		if (curr->getNext() != nullptr) {
 
-			edges += Graph::COMMA;
+			*edges += Graph::COMMA;
 		}
 
-		curr = curr->next;
+		curr = curr->getNext();
 	}
+}
 
-	return edges;
+/*
+* Copies the adjacency list of another Vertex
+* @param other The Vertex to copy, possibly of another Graph
+* @param arena The EdgeArena to allocate the Edges from
+*/
+void Graph::Vertex::clone(const Vertex& other, EdgeArena* arena) {
+
+	Edge* prev(nullptr);
+
+	for (Edge* curr = other.next; curr != nullptr; curr = curr->getNext()) {
+
+		Edge* edge = arena->allocate(curr->getId(), curr->getWeight(), nullptr);
+
+		this->link(prev, edge);
+
+		prev = edge;
+	}
+
+	this->edges = other.edges;
 }
 
 /*
-* Adds new Vertex with label in adjacent list
-* Must maintain sorted list, Vertex cant connect to itself
+* Adds new Edge to Vertex with id in adjacent list
+* Must maintain list sorted by label, Vertex cant connect to itself
 * No duplicate Edges
-* @param label The label to give the adjacent Vertex
+* @param id The id of the adjacent Vertex
 * @param weight The weight to label the Edge
+* @param labels The labels indexed by id
+* @param arena The EdgeArena to allocate the Edge from
 * @return true if connected, else false
 */
-bool Graph::Vertex::connect(const Label& label, const Weight& weight) {
+bool Graph::Vertex::connect(const Id& id, const Weight& weight,
+	                        const LabelList& labels, EdgeArena* arena) {
 	
 	bool connected(false);
 
-	Vertex* curr = this;
+	Edge* prev(nullptr),
+		* curr(this->next);
 
-	while (curr->next != nullptr && curr->next->label < label) {
+	while (curr != nullptr && labels[curr->getId()] < labels[id]) {
 
-		curr = curr->next;
+		prev = curr;
+		curr = curr->getNext();
 	}
 
-	if (curr->next == nullptr || curr->next->label != label) {
+	if (curr == nullptr || curr->getId() != id) {
 
-		Vertex* right = curr->next;
-
-		curr->next = new Vertex(label, weight, right);
+		this->link(prev, arena->allocate(id, weight, curr));
 
 		++this->edges;
 
@@ -875,28 +3072,29 @@ bool Graph::Vertex::connect(const Label& label, const Weight& weight) {
 }
 
 /*
-* Deletes Vertex with label in adjacent list
-* @param label The label of the adjacent Vertex to delete
+* Deletes Edge to Vertex with id in adjacent list
+* @param id The id of the adjacent Vertex
+* @param arena The EdgeArena to release the Edge to
 * @return true if disconnected, else false
 */
-bool Graph::Vertex::disconnect(const Label& label) {
+bool Graph::Vertex::disconnect(const Id& id, EdgeArena* arena) {
 	
 	bool disconnected(false);
 
-	Vertex* curr = this;
+	Edge* prev(nullptr),
+		* curr(this->next);
 
-	while (curr->next != nullptr && curr->next->label != label) {
+	while (curr != nullptr && curr->getId() != id) {
 
-		curr = curr->next;
+		prev = curr;
+		curr = curr->getNext();
 	}
 
-	if (curr->next != nullptr) {
-
-		Vertex* temp = curr->next->next;
+	if (curr != nullptr) {
 
-		delete curr->next;
+		this->link(prev, curr->getNext());
 
-		curr->next = temp;
+		arena->release(curr);
 
 		--this->edges;
 
@@ -907,46 +3105,127 @@ bool Graph::Vertex::disconnect(const Label& label) {
 }
 
 /*
-* Gets the adjacent Vertex with given label
-* or nullptr if it does not exist
-* @param label The label of the adjacent Vertex
-* @return pointer to adjacent Vertex or nullptr if it does not exist
+* Returns true if the changes of a batch would change the adjacent list,
+* so a shared list is only copied when it changes
+* @param begin The first change, changes sorted by label of the adjacent
+* Vertex, at most one per adjacent Vertex
+* @param end The end of the changes
+* @param labels The labels indexed by id
+* @return true if any change adds, replaces or removes an Edge, else false
 */
-Graph::Vertex* Graph::Vertex::getAdjacent(const Label& label) const {
+bool Graph::Vertex::changedBy(const EdgeChange* begin, const EdgeChange* end,
+	                          const LabelList& labels) const {
+
+	const Edge* curr(this->next);
+
+	for (const EdgeChange* change(begin); change != end; ++change) {
 
-	Vertex* adjacent = this->next;
+		Id id = std::get<1>(*change);
 
-	while (adjacent != nullptr && adjacent->label != label) {
+		while (curr != nullptr && labels[curr->getId()] < labels[id]) {
 
-		adjacent = adjacent->next;
+			curr = curr->getNext();
+		}
+
+		bool found = (curr != nullptr && curr->getId() == id);
+
+		if (std::get<3>(*change) == Change::REPLACE ||
+			found == (std::get<3>(*change) == Change::REMOVE)) {
+
+			return true;
+		}
 	}
 
-	return adjacent;
+	return false;
 }
 
 /*
-* Deallocate all adjacent Vertices
+* Applies the changes of a batch to the adjacent list in one pass
+* Both the list and the changes are in label order, so the list is walked
+* once for all changes instead of once per change
+* @param begin The first change, changes sorted by label of the adjacent
+* Vertex, at most one per adjacent Vertex
+* @param end The end of the changes
+* @param labels The labels indexed by id
+* @param arena The EdgeArena to allocate and release Edges with
+* @return the number of Edges added minus the number removed
 */
-void Graph::Vertex::clear() {
+int Graph::Vertex::update(const EdgeChange* begin, const EdgeChange* end,
+	                      const LabelList& labels, EdgeArena* arena) {
 
-	Vertex* curr = this->next;
+	int added(Graph::EMPTY);
 
-	while (curr != nullptr) {
+	Edge* prev(nullptr),
+		* curr(this->next);
 
-		Vertex* temp = curr;
+	for (const EdgeChange* change(begin); change != end; ++change) {
 
-		curr = curr->next;
+		Id id = std::get<1>(*change);
 
-		delete temp;
+		while (curr != nullptr && labels[curr->getId()] < labels[id]) {
+
+			prev = curr;
+			curr = curr->getNext();
+		}
+
+		bool found = (curr != nullptr && curr->getId() == id);
+
+		if (found && std::get<3>(*change) != Change::ADD) {
+
+			Edge* temp = curr->getNext();
+
+			arena->release(curr);
+
+			curr = temp;
+			this->link(prev, curr);
+			found = false;
+			--added;
+		}
+
+		if (!found && std::get<3>(*change) != Change::REMOVE) {
+
+			curr = arena->allocate(id, std::get<2>(*change), curr);
+			this->link(prev, curr);
+			++added;
+		}
+	}
+
+	this->edges += added;
+
+	return added;
+}
+
+/*
+* Gets the Edge to the adjacent Vertex with given id
+* or nullptr if it does not exist
+* @param id The id of the adjacent Vertex
+* @return pointer to Edge or nullptr if it does not exist
+*/
+Graph::Edge* Graph::Vertex::getAdjacent(const Id& id) const {
+
+	Edge* adjacent = this->next;
+
+	while (adjacent != nullptr && adjacent->getId() != id) {
+
+		adjacent = adjacent->getNext();
 	}
+
+	return adjacent;
 }
 
 /*
-* Makes string representation Vertex
-* @return string Vertex
+* Links an Edge into the adjacency list
+* @param prev The Edge to link after, nullptr to link first
+* @param edge The Edge to link
 */
-std::string Graph::Vertex::toString() const {
+void Graph::Vertex::link(Edge* prev, Edge* edge) {
+
+	if (prev == nullptr) {
 
-	return this->label + Graph::LEFT_P + std::to_string(this->weight)
-		+ Graph::RIGHT_P;
+		this->next = edge;
+
+	} else {
+
+		prev->setNext(edge);
+	}
 }
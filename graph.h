@@ -10,21 +10,35 @@
 #ifndef GRAPH_H
 #define GRAPH_H
 
+#include <atomic>
 #include <iostream>
 #include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <climits>
+#include <cstdint>
+#include <deque>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <string>
+#include <string_view>
 #include <stack>
 #include <queue>
 #include <set>
 #include <map>
+#include <vector>
+
+class ThreadPool;
 
 /*
 * A graph is made up of vertices and edges.
 * Vertex labels are unique.
 * A vertex can be connected to other vertices via weighted, directed edge.
 * A vertex cannot connect to itself or have multiple edges to the same vertex
+* Labels are interned to dense ids when a vertex is added, all internal
+* structures work on ids and labels are only used at the interface
 */
 class Graph {
 
@@ -36,6 +50,15 @@ class Graph {
 	*/
 	friend std::ostream& operator<<(std::ostream& out, const Graph& g);
 
+	/* FrozenGraph packs the AdjacencyMap into a read-only snapshot */
+	friend class FrozenGraph;
+
+	/* Snapshot writes the label dictionary and adjacency lists to a file */
+	friend class Snapshot;
+
+	/* Writer exports the adjacency lists as text */
+	friend class Writer;
+
 public:
 
 	/* Type definitions*/
@@ -48,9 +71,14 @@ public:
 	using PrevLabel    = std::pair<const Label, const Label>;
 	using WeightMap    = std::map<Label, Weight>;
 	using PrevMap      = std::map<Label, Label>;
+	using Id           = std::uint32_t;
+	using Path         = std::vector<Label>;
+	using LabelList    = std::vector<Label>;
+	using WeightTable  = std::vector<Weight>;
 
 	/* Constants for reuse with meaning*/
 	static const Label  NO_LABEL;
+	static const Id     NO_ID;
 	static const Weight NO_WEIGHT;
 	static const int    EMPTY;
 	static const int    COUNT;
@@ -58,28 +86,138 @@ public:
 	static const char   LEFT_P;
 	static const char   RIGHT_P;
 
+	/*
+	* What a traversal does after visiting a Vertex
+	* CONTINUE goes on to its adjacent Vertices, SKIP goes on without them
+	* and STOP ends the traversal
+	*/
+	enum class Control { CONTINUE, SKIP, STOP };
+
+	/*
+	* Formats of files read by ReadFile
+	* EDGES is a number of Edges then "label label weight" Edges
+	* DIMACS is a "p sp n m" problem line then "a u v weight" arcs
+	* SNAP is "label label" or "label label weight" lines, "#" comments
+	* MATRIX_MARKET is a coordinate matrix, an Edge for each entry
+	* METIS is a "n m" header then the neighbors of each Vertex on its line
+	* Vertices of DIMACS, MATRIX_MARKET and METIS files are labelled "1" to
+	* "n" and all n are added, Edges without a weight weigh 1
+	*/
+	enum class Format { EDGES, DIMACS, SNAP, MATRIX_MARKET, METIS };
+
+	/*
+	* Visited marks for one traversal at a time
+	* Every Vertex id holds the number of the traversal that last visited it,
+	* so starting a new traversal forgets all marks without touching them
+	* and a VisitedSet reused across traversals only pays for the Vertices
+	* each traversal reaches. Give each thread its own VisitedSet.
+	*/
+	class VisitedSet {
+
+	public:
+
+		/*
+		* Constructs empty VisitedSet
+		*/
+		VisitedSet();
+
+		/*
+		* Starts a new traversal, no Vertex is visited afterwards
+		* @param size The number of Vertex ids the traversal may visit
+		*/
+		void Reset(std::size_t size);
+
+		/*
+		* Marks a Vertex as visited
+		* @param id The id of the Vertex
+		* @return true if the Vertex was not visited before, else false
+		*/
+		bool Visit(const Id& id);
+
+		/*
+		* Returns true if Vertex visited, else false
+		* @param id The id of the Vertex
+		* @return true if Vertex visited, else false
+		*/
+		bool IsVisited(const Id& id) const;
+
+	private:
+
+		/* Traversal that last visited each Vertex id, 0 for none */
+		std::vector<std::uint32_t> stamps;
+
+		/* Number of the current traversal */
+		std::uint32_t epoch;
+	};
+
+	/* Lazy depth-first or breadth-first traversal, see DFSRange */
+	class Traversal;
+
+	/* Reusable storage for Dijkstra, see ShortestPaths */
+	class ShortestPathWorkspace;
+
+	/* Shortest paths from one Vertex held in a ShortestPathWorkspace */
+	class ShortestPaths;
+
+	/* Reads batches of Edge records from an istream, see ReadBatch */
+	class EdgeStream;
+
+	/* Receives the ShortestPaths of each source of a batched Dijkstra */
+	using PathsSink = std::function<void(std::size_t, const ShortestPaths&)>;
+
 	/*
 	* Constructs empty graph
 	*/
 	Graph();
 
 	/*
-	* Copy constructor overload
+	* Copy constructor overload, see SetCopyOnWrite
 	* @param other The other Graph to copy
 	*/
 	Graph(const Graph& other);
 
+	/*
+	* Move constructor, takes the contents of other and leaves it empty
+	* @param other The other Graph to move from
+	*/
+	Graph(Graph&& other) noexcept;
+
 	/*
 	* Destroys Graph, all Vertices, all Edges and deallocates dynamic memory
 	*/
 	virtual ~Graph();
 
 	/*
-	* Assignment operator overload
+	* Assignment operator overload, see SetCopyOnWrite
 	* @param other The other Graph to copy
 	*/
 	Graph& operator=(const Graph& other);
 
+	/*
+	* Move assignment operator, takes the contents of other and leaves it
+	* empty
+	* @param other The other Graph to move from
+	* @return this by reference
+	*/
+	Graph& operator=(Graph&& other) noexcept;
+
+	/*
+	* Sets whether copies of Graph share its adjacency lists
+	* Copies of a copy-on-write Graph copy the labels and share every
+	* adjacency list, a list is copied the first time either Graph changes
+	* it and its Edges are reused once no copy holds it. Copies are
+	* copy-on-write too. A Graph can be copied on several threads at once,
+	* its copies can be read, changed and destroyed on different threads
+	* @param enabled True to share adjacency lists, false to copy them
+	*/
+	void SetCopyOnWrite(bool enabled);
+
+	/*
+	* Returns true if copies of Graph share its adjacency lists
+	* @return true if copy-on-write, else false
+	*/
+	bool IsCopyOnWrite() const;
+
 	 /*
 	* Get the total number of Vertices in Graph
 	* @return total number of Vertices in Graph
@@ -99,6 +237,12 @@ public:
 	*/
 	int NumberOfEdges(const Label& label) const;
 
+	/*
+	* Get the memory used by the adjacency lists
+	* @return number of bytes used
+	*/
+	std::size_t MemoryUsage() const;
+
 	/*
 	* Add a Vertex to Graph, no duplicates allowed
 	* @param label The label of the Vertex
@@ -144,25 +288,142 @@ public:
 	* Read Edges from file, first line of file is an integer indicating
 	* number of Edges, each line represents an Edge in the form of
 	* "string string int", Vertex labels cannot contain spaces
-	* Clears previous contents
+	* Clears previous contents, unless the file cannot be read
 	* @param fileName The name of the file
 	* @return true if file successfully read, else false
 	*/
 	bool ReadFile(const std::string& fileName);
 
+	/*
+	* Read Edges from file, see ReadFile
+	* Each Edge must be on a single line, a line may hold several Edges
+	* @param fileName The name of the file
+	* @param error The string to set to the reason the file could not be
+	* read, as "file:line: message", empty if it was read
+	* @return true if file successfully read, else false
+	*/
+	bool ReadFile(const std::string& fileName, std::string& error);
+
+	/*
+	* Read Edges from file, see ReadFile, parsing on the workers of pool
+	* @param fileName The name of the file
+	* @param error The string to set to the reason the file could not be
+	* read, as "file:line: message", empty if it was read
+	* @param pool The ThreadPool to parse on
+	* @return true if file successfully read, else false
+	*/
+	bool ReadFile(const std::string& fileName, std::string& error,
+		          ThreadPool& pool);
+
+	/*
+	* Read Edges from file in a given format, see Format
+	* Clears previous contents, unless the file cannot be read
+	* @param fileName The name of the file
+	* @param format The format of the file
+	* @param error The string to set to the reason the file could not be
+	* read, as "file:line: message", empty if it was read
+	* @return true if file successfully read, else false
+	*/
+	bool ReadFile(const std::string& fileName, Format format,
+		          std::string& error);
+
+	/*
+	* Read Edges from file in a given format, see Format, parsing on the
+	* workers of pool
+	* @param fileName The name of the file
+	* @param format The format of the file
+	* @param error The string to set to the reason the file could not be
+	* read, as "file:line: message", empty if it was read
+	* @param pool The ThreadPool to parse on
+	* @return true if file successfully read, else false
+	*/
+	bool ReadFile(const std::string& fileName, Format format,
+		          std::string& error, ThreadPool& pool);
+
+	/*
+	* Read up to limit records from an EdgeStream and apply them as Connect
+	* and Disconnect would, in stream order
+	* Records before a line that is not valid are applied, the stream then
+	* stops with an error. Queries can run between batches
+	* @param stream The EdgeStream to read from
+	* @param limit The largest number of records to read
+	* @return the number of records read, 0 once the stream ended or stopped
+	*/
+	std::size_t ReadBatch(EdgeStream& stream, std::size_t limit);
+
+	/*
+	* Save Graph to a binary snapshot file, see Snapshot
+	* @param fileName The name of the file
+	* @return true if file successfully written, else false
+	*/
+	bool Save(const std::string& fileName) const;
+
+	/*
+	* Load Graph from a binary snapshot file written by Save
+	* Clears previous contents, unless the file cannot be read or fails its
+	* checksum
+	* @param fileName The name of the file
+	* @return true if file successfully read, else false
+	*/
+	bool Load(const std::string& fileName);
+
 	/*
 	* Depth-first traversal originating from Vertex with given label
 	* @param label The origin Vertex label
-	* @param func The function to call on each Vertex label
+	* @param func The function or other callable to call on each Vertex
+	* label, returning void or a Control
+	*/
+	template <typename Visitor>
+	void DFS(const Label& label, Visitor func) const;
+
+	/*
+	* Depth-first traversal reusing the visited marks of earlier traversals
+	* @param label The origin Vertex label
+	* @param func The function or other callable to call on each Vertex
+	* label, returning void or a Control
+	* @param visited The VisitedSet to track visited Vertices in
 	*/
-	void DFS(const Label& label, Visit func);
+	template <typename Visitor>
+	void DFS(const Label& label, Visitor func, VisitedSet& visited) const;
 
 	/*
 	* Breadth-first traversal originating from Vertex with given label
 	* @param label The origin Vertex label
-	* @param func The function to call on each Vertex label
+	* @param func The function or other callable to call on each Vertex
+	* label, returning void or a Control
+	*/
+	template <typename Visitor>
+	void BFS(const Label& label, Visitor func) const;
+
+	/*
+	* Breadth-first traversal reusing the visited marks of earlier traversals
+	* @param label The origin Vertex label
+	* @param func The function or other callable to call on each Vertex
+	* label, returning void or a Control
+	* @param visited The VisitedSet to track visited Vertices in
+	*/
+	template <typename Visitor>
+	void BFS(const Label& label, Visitor func, VisitedSet& visited) const;
+
+	/*
+	* Lazy depth-first traversal originating from Vertex with given label
+	* Vertices are visited in the same order as DFS, one at a time as the
+	* range is iterated, the Graph must not change while it is iterated
+	* @param label The origin Vertex label
+	* @return a range of the labels of visited Vertices, empty if Vertex
+	* not found
+	*/
+	Traversal DFSRange(const Label& label) const;
+
+	/*
+	* Lazy breadth-first traversal originating from Vertex with given label
+	* Vertices are visited in the same order as BFS, one at a time as the
+	* range is iterated, the Graph must not change while it is iterated
+	* @param label The origin Vertex label
+	* @return a range of the labels of visited Vertices, empty if Vertex
+	* not found
 	*/
-	void BFS(const Label& label, Visit func);
+	Traversal BFSRange(const Label& label) const;
 
 	/**
 	* Dijkstra's algorithm to find shortest distance to all other Vertices
@@ -173,14 +434,56 @@ public:
 	* @param wMap The map to record shortest path
 	* @param pMap The map to record previous Vertex
 	*/
-	void Dijkstra(const Label& label, WeightMap& wMap, PrevMap& pMap);
+	void Dijkstra(const Label& label, WeightMap& wMap, PrevMap& pMap) const;
+
+	/*
+	* Dijkstra's algorithm into a reusable workspace, nothing is allocated
+	* once the workspace has grown to the size of the Graph
+	* The result reads the workspace, it is valid until the next search
+	* into the same workspace or until the Graph changes
+	* @param label The label of the origin Vertex
+	* @param workspace The ShortestPathWorkspace to search in
+	* @return the ShortestPaths from the origin, empty if Vertex not found
+	*/
+	ShortestPaths Dijkstra(const Label& label,
+		                   ShortestPathWorkspace& workspace) const;
+
+	/*
+	* Dijkstra's algorithm from every source label, the sources are shared
+	* between the workers of pool and every worker searches in its own
+	* ShortestPathWorkspace
+	* The sink is called on the worker threads, at the same time for
+	* different sources, and the ShortestPaths it gets is only valid
+	* during the call
+	* If the sink throws, no further source is searched and the first
+	* exception is rethrown once every worker stopped
+	* @param sources The labels of the origin Vertices
+	* @param sink The callable to call with the index of each source and
+	* its ShortestPaths
+	* @param pool The ThreadPool to search on
+	*/
+	void Dijkstra(const LabelList& sources, const PathsSink& sink,
+		          ThreadPool& pool) const;
+
+	/*
+	* Shortest distances from every source to every target, computed like
+	* the batched Dijkstra
+	* @param sources The labels of the origin Vertices
+	* @param targets The labels of the destination Vertices
+	* @param table The WeightTable to fill row by row, the distance from
+	* sources[i] to targets[j] is at i * targets.size() + j, INT_MAX if
+	* there is no path
+	* @param pool The ThreadPool to search on
+	*/
+	void DistanceTable(const LabelList& sources, const LabelList& targets,
+		               WeightTable& table, ThreadPool& pool) const;
 
 	/*
 	* Creates a MinSpanningTree using Prim's algorithm
 	* @param label The label of the origin Vertex
 	* @return a Graph of the MinSpanningTree
 	*/
-	Graph* MinSpanningTree(const Label& label);
+	Graph MinSpanningTree(const Label& label) const;
 
 	/*
 	* Gets the sum cost of all Edges in Graph
@@ -191,77 +494,250 @@ public:
 private:
 
 	/*
-	* Private Vertex class of Graph
+	* What a batch of records does to an Edge, see ReadBatch
+	* ADD connects unless connected, REPLACE disconnects then connects and
+	* REMOVE disconnects
 	*/
-	class Vertex {
+	enum class Change { ADD, REPLACE, REMOVE };
+
+	/* Starting id, ending id, weight and Change of an Edge */
+	using EdgeChange     = std::tuple<Id, Id, Weight, Change>;
+	using EdgeChangeList = std::vector<EdgeChange>;
+
+	/*
+	* Private Edge class of Graph, a node of an adjacency list
+	* Holds no more than the list needs, Edges live in the EdgeArena of
+	* their Graph
+	*/
+	class Edge {
 
 	public:
 
 		/*
-		* Constructs Vertex with given Label 
-		* @param label The lable of the Vertex, default to blank
-		* @param weight The weight of the Vertex, default to -1
-		* @param next The next Vertex in the list
+		* Constructs Edge to a given Vertex
+		* @param id The id of the adjacent Vertex
+		* @param weight The weight of the Edge
+		* @param next The next Edge in the list
 		*/
-		explicit Vertex(const Label& label   = Graph::NO_LABEL,
-			            const Weight& weight = Graph::NO_WEIGHT,
-			            Vertex* next         = nullptr,
-			            const int& edges     = Graph::EMPTY);
+		Edge(const Id& id, const Weight& weight, Edge* next);
 
 		/*
-		* Copy constructor with pointers
-		* @param other The other Vertex to copy
+		* Gets the id of the adjacent Vertex
+		* @return id of the adjacent Vertex
 		*/
-		Vertex(const Vertex& other);
+		Id getId() const;
 
 		/*
-		* Assignment operator overload
-		* @param other The other Vertex to copy
-		* @return this by reference
+		* Gets Edge Weight
+		* @return Edge Weight
 		*/
-		Vertex& operator=(const Vertex& other);
+		Weight getWeight() const;
+
+		/*
+		* Gets the pointer to next Edge in the adjacency list
+		* @return pointer to next Edge in the adjacency list
+		*/
+		Edge* getNext() const;
+
+		/*
+		* Sets next to another Edge in the adjacency list
+		* @param next pointer to next Edge in the adjacency list
+		*/
+		void setNext(Edge* next);
+
+	private:
+
+		/* Id of the adjacent Vertex */
+		const Id id;
+
+		/* Edge weight */
+		const Weight weight;
+
+		/* Pointer to next Edge in adjacency list */
+		Edge* next;
+	};
+
+	/*
+	* Private EdgeArena class of Graph, allocates the Edges of a Graph
+	* Edges are carved out of slabs that double in size up to SLAB_SIZE,
+	* Edges released by disconnecting are reused before the slabs grow and
+	* all slabs are freed at once when the Graph is cleared
+	* Not thread safe, except restore which other Graphs call to give back
+	* the Edges of shared lists
+	*/
+	class EdgeArena {
+
+	public:
+
+		/* Largest number of Edges in a slab */
+		static const std::size_t SLAB_SIZE;
 
 		/*
-		* Destroys Vertex
+		* Constructs EdgeArena without slabs
 		*/
-		virtual ~Vertex();
+		EdgeArena();
 
 		/*
-		* Gets Vertex label
-		* @return Vertex label
+		* Frees all slabs
 		*/
-		Label getLabel() const;
+		~EdgeArena();
+
+		EdgeArena(const EdgeArena& other)            = delete;
+		EdgeArena& operator=(const EdgeArena& other) = delete;
 
 		/*
-		* Gets Edge Weight (for adjacent Vertices)
-		* @return Edge Weight
+		* Allocates an Edge
+		* @param id The id of the adjacent Vertex
+		* @param weight The weight of the Edge
+		* @param next The next Edge in the list
+		* @return pointer to the new Edge
 		*/
-		Weight getWeight() const;
+		Edge* allocate(const Id& id, const Weight& weight, Edge* next);
 
 		/*
-		* Returns true if Vertex visited, else false
-		* @return true if Vertex visited, else false
+		* Releases an Edge to be reused by allocate
+		* @param edge The Edge, no longer in any list
+		*/
+		void release(Edge* edge);
+
+		/*
+		* Releases a list of Edges to be reused by allocate, from any thread
+		* @param first The first Edge of the list, no longer in any
+		* adjacency list
+		*/
+		void restore(Edge* first);
+
+		/*
+		* Frees all slabs, every Edge allocated before is invalid
+		*/
+		void clear();
+
+		/*
+		* Get the memory held by the slabs
+		* @return number of bytes held
+		*/
+		std::size_t bytes() const;
+
+	private:
+
+		/* Number of Edges in the first slab */
+		static const std::size_t FIRST_SIZE;
+
+		/* Start and number of Edges of a slab */
+		using Slab = std::pair<Edge*, std::size_t>;
+
+		/* Slabs in allocation order, only the last one has room left */
+		std::vector<Slab> slabs;
+
+		/* Number of Edges used in the last slab */
+		std::size_t used;
+
+		/* Released Edges, linked through their next pointers */
+		Edge* free;
+
+		/* Edges restored by other Graphs, moved to free once it is empty */
+		std::atomic<Edge*> restored;
+	};
+
+	struct ShareBlock;
+
+	/*
+	* Private Share struct of Graph, the holds of copy-on-write Graphs on
+	* an adjacency list they share
+	*/
+	struct Share {
+
+		/* Number of Graphs holding the list */
+		std::atomic<int> owners;
+
+		/* The ShareBlock the Share was created in */
+		ShareBlock* block;
+	};
+
+	/*
+	* Private ShareBlock struct of Graph, the Shares created by one copy
+	* of a Graph, whose lists are all in the EdgeArena of that Graph
+	* Deleted with the last of its Shares
+	*/
+	struct ShareBlock {
+
+		/*
+		* Constructs ShareBlock of unused Shares
+		* @param count The number of Shares
+		* @param arena The EdgeArena of the lists to share
+		*/
+		ShareBlock(int count, const std::shared_ptr<EdgeArena>& arena);
+
+		/*
+		* Gives back Shares that are no longer in use, the last one deletes
+		* the ShareBlock
+		* @param count The number of Shares given back
+		*/
+		void release(int count);
+
+		/* Number of Shares still in use */
+		std::atomic<int> live;
+
+		/* The EdgeArena of the lists, kept alive while any is shared */
+		std::shared_ptr<EdgeArena> arena;
+
+		/* The Shares */
+		std::unique_ptr<Share[]> shares;
+	};
+
+	/*
+	* Private Vertex class of Graph, the header of an adjacency list
+	*/
+	class Vertex {
+
+	public:
+
+		/*
+		* Constructs Vertex with given adjacency list
+		* @param next The first Edge in the list, default to none
+		* @param edges The number of Edges in the list, default to 0
+		*/
+		explicit Vertex(Edge* next = nullptr, const int& edges = Graph::EMPTY);
+
+		/*
+		* Copy constructor, the copy refers to the same adjacency list
+		* @param other The other Vertex to copy
+		*/
+		Vertex(const Vertex& other);
+
+		/*
+		* Assignment operator, refers to the adjacency list of other
+		* @param other The other Vertex to copy
+		* @return this by reference
+		*/
+		Vertex& operator=(const Vertex& other);
+
+		/*
+		* Gets the holds on the adjacency list if it is shared
+		* @return pointer to the Share, nullptr if only one Graph holds it
 		*/
-		bool isVisited() const;
+		Share* getShare() const;
 
 		/*
-		* Sets the Vertex as visited or unvisited
-		* @param visited The boolean to indicated if visited(true) or
-		* unvisited(false)
+		* Adds the hold of a copy on the adjacency list, an empty list is not
+		* shared, safe to call on several threads at once
+		* @param fresh Pointer to the next unused Share of the copy, taken and
+		* moved past if the list was not shared yet
 		*/
-		void setVisited(bool visited = true);
+		void share(Share** fresh) const;
 
 		/*
-		* Gets the pointer to next Vertex in the adjacency list
-		* @retrun pointer to next Vertex in the adjacency list
+		* Drops the hold of a Graph on the shared adjacency list
+		* @param restore True to give the Edges back to their EdgeArena if no
+		* other Graph holds the list, false to keep them
 		*/
-		Vertex* getNext() const;
+		void leave(bool restore);
 
 		/*
-		* Sets next to new Vertex in the adjacency list
-		* @param pointer to next Vertex in the adjacency list to add
+		* Gets the pointer to first Edge in the adjacency list
+		* @return pointer to first Edge in the adjacency list
 		*/
-		void setNext(Vertex* next);
+		Edge* getNext() const;
 
 		/*
 		* Counts all Edges for a Vertex
@@ -270,196 +746,1055 @@ private:
 		int numOfEdges() const;
 
 		/*
-		* Gets string representation of Edges & adjacent Vertices
-		* @return string representation of Edges & adjacent Vertices
+		* Appends string representation of Edges & adjacent Vertices
+		* @param labels The labels indexed by id
+		* @param edges The string to append to
+		*/
+		void getEdges(const LabelList& labels, std::string* edges) const;
+
+		/*
+		* Copies the adjacency list of another Vertex
+		* @param other The Vertex to copy, possibly of another Graph
+		* @param arena The EdgeArena to allocate the Edges from
 		*/
-		std::string getEdges() const;
+		void clone(const Vertex& other, EdgeArena* arena);
 
 		/*
-		* Adds new Vertex with label in adjacent list
-		* Must maintain sorted list, Vertex cant connect to itself
+		* Adds new Edge to Vertex with id in adjacent list
+		* Must maintain list sorted by label, Vertex cant connect to itself
 		* No duplicate Edges
-		* @param label The label to give the adjacent Vertex
+		* @param id The id of the adjacent Vertex
 		* @param weight The weight to label the Edge
+		* @param labels The labels indexed by id
+		* @param arena The EdgeArena to allocate the Edge from
 		* @return true if connected, else false
 		*/
-		bool connect(const Label& label, const Weight& weight);
+		bool connect(const Id& id, const Weight& weight,
+			         const LabelList& labels, EdgeArena* arena);
 
 		/*
-		* Deletes Vertex with label in adjacent list
-		* @param label The label of the adjacent Vertex to delete
+		* Deletes Edge to Vertex with id in adjacent list
+		* @param id The id of the adjacent Vertex
+		* @param arena The EdgeArena to release the Edge to
 		* @return true if disconnected, else false
 		*/
-		bool disconnect(const Label& label);
+		bool disconnect(const Id& id, EdgeArena* arena);
 
 		/*
-		* Gets the adjacent Vertex with given label
-		* or nullptr if it does not exist
-		* @param label The label of the adjacent Vertex
-		* @return pointer to adjacent Vertex or nullptr if it does not exist
+		* Returns true if the changes of a batch would change the adjacent
+		* list
+		* @param begin The first change, changes sorted by label of the
+		* adjacent Vertex, at most one per adjacent Vertex
+		* @param end The end of the changes
+		* @param labels The labels indexed by id
+		* @return true if any change adds, replaces or removes an Edge, else
+		* false
 		*/
-		Vertex* getAdjacent(const Label& label) const;
+		bool changedBy(const EdgeChange* begin, const EdgeChange* end,
+			           const LabelList& labels) const;
 
 		/*
-		* Deallocate all adjacent Vertices
+		* Applies the changes of a batch to the adjacent list in one pass
+		* @param begin The first change, changes sorted by label of the
+		* adjacent Vertex, at most one per adjacent Vertex
+		* @param end The end of the changes
+		* @param labels The labels indexed by id
+		* @param arena The EdgeArena to allocate and release Edges with
+		* @return the number of Edges added minus the number removed
 		*/
-		void clear();
+		int update(const EdgeChange* begin, const EdgeChange* end,
+			       const LabelList& labels, EdgeArena* arena);
 
-	private:
-		
-		/* Label to uniquely ID each Vertex */
-		const Label label;
+		/*
+		* Gets the Edge to the adjacent Vertex with given id
+		* or nullptr if it does not exist
+		* @param id The id of the adjacent Vertex
+		* @return pointer to Edge or nullptr if it does not exist
+		*/
+		Edge* getAdjacent(const Id& id) const;
 
-		/* Edge weight */
-		const Weight weight;
+	private:
 
-		/* Visited mark for Graph traversals */
-		bool visited;
+		/* Pointer to first Edge in adjacency list */
+		Edge* next;
 
-		/* Pointer to next Vertex in adjacency list*/
-		Vertex* next;
+		/*
+		* Holds on the adjacency list, nullptr if not shared
+		* Set by the first copy, which may run on several threads at once
+		*/
+		mutable std::atomic<Share*> shared;
 
 		/* Number of Edges from Vertex */
 		int edges;
 
 		/*
-		* Makes string representation Vertex
-		* @return string Vertex
+		* Links an Edge into the adjacency list
+		* @param prev The Edge to link after, nullptr to link first
+		* @param edge The Edge to link
 		*/
-		std::string toString() const;
+		void link(Edge* prev, Edge* edge);
 	};
 
 	/* Type definitions */
-	using VertexSet    = std::set<const Vertex*>;
-	using LabelVert    = std::pair<const Label, Vertex*>;
-	using AdjacencyMap = std::map<const Label, Vertex*>;
-
-	/* Adjacency Map from label to Vertex */
-	AdjacencyMap map;
-
-	/* Number of Edges in graph */
-	int edges;
+	using LabelId      = std::pair<const Label, Id>;
+	using LabelMap     = std::map<const Label, Id>;
+	using VertexList   = std::vector<Vertex>;
+	using IdList       = std::vector<Id>;
+	using IdEdge       = std::pair<Id, const Edge*>;
+	using IdEdgeStack  = std::stack<IdEdge>;
+	using IdQ          = std::queue<Id>;
+	using WeightList   = std::vector<Weight>;
+	using WeightId     = std::tuple<Weight, const Label*, Id>;
+	using WeightOrder  = bool (*)(const WeightId&, const WeightId&);
+	using EdgeId       = std::tuple<Weight, Id, Id>;
+	using EdgeOrder    = std::function<bool(const EdgeId&, const EdgeId&)>;
+	using EdgeQ        = std::priority_queue<EdgeId, std::vector<EdgeId>,
+		                                     EdgeOrder>;
+	using WeightQ      = std::priority_queue<WeightId, std::vector<WeightId>,
+		                                     WeightOrder>;
+	using SearchSink   = std::function<void(std::size_t,
+		                                    const ShortestPathWorkspace&)>;
+	using RawEdge      = std::tuple<std::string_view, std::string_view,
+		                            Weight>;
+	using RawEdgeList  = std::vector<RawEdge>;
 
 	/*
-	* Helper for copy constructor and assignment operator overload
-	* Copies contents of AdjacencyMap in other Graph
-	* @param otherMap The map in the other Graph to clone
+	* Edges parsed from a range of whole lines of a file, the labels point
+	* into the text of the file
 	*/
-	void clone(const AdjacencyMap* otherMap);
+	struct Chunk {
 
+		/* Edges in file order */
+		RawEdgeList edges;
 
-	/*
-	* Deallocate all dynamic memory
-	*/
-	void clear();
+		/* Number of Edges, arcs, entries or neighbors read */
+		std::size_t records;
 
-	/*
-	* Extracts contents from file to create Vertices & Edges
-	* @param file The file to extract contents from
-	*/
-	void extractFile(std::ifstream* file);
+		/* Number of lines ended in the chunk */
+		int lines;
 
-	/*
-	* Helper for depthFirstTraversal
-	* @param stack The stack to search depth first with
-	*/
-	void dfs(LabelStack* stack, Visit func);
+		/* Line of the last token from the start of the chunk, -1 if none */
+		int lastLine;
 
-	/*
-	* Helper for search functions
-	* Gets the next unvisited Vertex label adjacent to Vertex with given label
-	* @param label The label of the Vertex to get next from
-	* @return next unvisited Vertex label adjacent to Vertex, or blank if none
-	*/
-	Label nextLabel(const Label& label);
+		/* Line of the first error from the start of the chunk, -1 if none */
+		int errorLine;
 
-	/*
-	* Helper for nextLabel
-	* Gets the next unvisited Vertex starting from curr
-	* @param curr The current Vertex
-	* @param nextLabel Pointer to store label of next unvisited Vertex
-	* @return next unvisited Vertexnext unvisited Vertex
-	*/
-	Vertex* nextVertex(Vertex* curr, Label* nextLabel) const;
+		/* Message of the first error */
+		std::string error;
 
-	/*
-	* Helper for breadthFirstTraversal
-	* @param q The queue to search breadth first with
-	* @param func The function to call on each Vertex
-	*/
-	void bfs(LabelQ* q, Visit func);
+		/* Index of the Vertex of the first line, METIS only */
+		Id vertex;
+	};
 
 	/*
-	* Helper for bfsHelper, adds all unvisited adjacent Vertices to q
-	* @param q The queue to search breadth first with
-	* @param curr The Vertex to get unvisited adjacent Vertices from
+	* What the header of a file declares, see Format
 	*/
-	void addUnvisited(LabelQ* q, Vertex* curr);
+	struct FileHeader {
 
-	/*
-	* Helper for Dijkstra, initializes WeightMap and PrevMap for all Vertices
-	* adjacent to the origin Vertex
-	* @param curr The origin Vertex
-	* @param label The label of the origin Vertex
-	* @param wMap The WeightMap
-	* @param pMap The PrevMap
-	*/
-	void initMaps(const Vertex* curr, const Label& label, WeightMap* wMap,
-		          PrevMap* pMap) const;
+		/* Format of the file */
+		Format format;
 
-	/*
-	* Helper for Dijkstra, iteratively gets the next smallest Vertex from
-	* WeightMap thats not in VertexSet and updates any possible shorter paths
-	* from the origin
-	* @param set The VertexSets
-	* @param wMap The WeightMap
-	* @param pMap The PrevMap
-	*/
-	void dijkstra(VertexSet* set, WeightMap* wMap, PrevMap* pMap) const;
+		/* Number of records the file declares */
+		std::size_t records;
 
-	/*
-	* Helper for dijkstra, gets the label for the next smallest Vertex from
-	* WeightMap thats not in VertexSet
-	* @param set The VertexSet
-	* @param wMap The WeightMap
-	* @param label The pointer to assign as the label of the next smallest Vertex
-	* @return pointer to the next smallest Vertex
+		/* Name of the records in errors */
+		std::string record;
+
+		/* Labels "1" to "n" of the Vertices the file declares, else empty */
+		LabelList names;
+
+		/* First character of comment lines, '\0' if none */
+		char comment;
+
+		/* True if records must have a weight */
+		bool weighted;
+
+		/* True if weights are real numbers, rounded to integers */
+		bool real;
+
+		/* True if each record is an Edge in both directions */
+		bool symmetric;
+
+		/* Number of Vertex weights before the neighbors, METIS only */
+		int skip;
+	};
+
+	using ChunkList    = std::vector<Chunk>;
+
+	/* Blocks of a file, a deque keeps labels in earlier blocks valid */
+	using TextList     = std::deque<std::string>;
+
+	/* Label dictionary from label to id, iterates in label order */
+	LabelMap map;
+
+	/* Labels indexed by id */
+	LabelList labels;
+
+	/* Adjacency lists indexed by id */
+	VertexList vertices;
+
+	/* Allocator of new Edges, created by the first Edge */
+	std::shared_ptr<EdgeArena> arena;
+
+	/* Number of Edges in graph */
+	int edges;
+
+	/* True if copies share adjacency lists, see SetCopyOnWrite */
+	bool copyOnWrite;
+
+	/*
+	* Helper for copy constructor and assignment operator overload
+	* Copies label dictionary and adjacency lists of other Graph
+	* @param other The other Graph to clone
+	*/
+	void clone(const Graph& other);
+
+	/*
+	* Helper for move constructor and move assignment operator, swaps the
+	* contents of an empty Graph with other
+	* @param other The other Graph to take from
+	*/
+	void take(Graph* other) noexcept;
+
+	/*
+	* Gets the adjacency list of a Vertex to change, copying it first if it
+	* may be shared with another Graph
+	* @param id The id of the Vertex
+	* @return the Vertex by reference
+	*/
+	Vertex& own(const Id& id);
+
+	/*
+	* Gets the EdgeArena of Graph, creating it if there is none
+	* @return pointer to the EdgeArena
+	*/
+	EdgeArena* edgeArena();
+
+	/*
+	* Gets the id of a Vertex, adding the Vertex if it is not in Graph
+	* @param label The label of the Vertex
+	* @return id of the Vertex
+	*/
+	Id intern(const Label& label);
+
+	/*
+	* Gets the id of a Vertex
+	* @param label The label of the Vertex
+	* @return id of the Vertex, or NO_ID if not found
+	*/
+	Id find(const Label& label) const;
+
+
+	/*
+	* Deallocate all dynamic memory
+	*/
+	void clear();
+
+	/*
+	* Helper for ReadFile, parses a block of whole lines on the workers of
+	* pool into one Chunk per worker
+	* @param begin The start of the block
+	* @param end The end of the block
+	* @param header The FileHeader of the file
+	* @param vertex Pointer to the index of the next METIS Vertex
+	* @param chunks The ChunkList to add the Chunks to
+	* @param pool The ThreadPool to parse on
+	*/
+	static void parseBlock(const char* begin, const char* end,
+		                   const FileHeader& header, Id* vertex,
+		                   ChunkList* chunks, ThreadPool* pool);
+
+	/*
+	* Helper for ReadFile, parses the header of a file
+	* @param pos Pointer to the start of the text, moved past the header
+	* @param end The end of the text
+	* @param line Pointer to the line number of pos
+	* @param header The FileHeader to fill, its format already set
+	* @param error Pointer to store the reason the header is not valid
+	* @return true if the header is valid, else false
+	*/
+	static bool parseHeader(const char** pos, const char* end, int* line,
+		                    FileHeader* header, std::string* error);
+
+	/*
+	* Helper for parseHeader, gets the first token of the next line that is
+	* not blank or a comment
+	* @param pos Pointer to the position to read from, moved past the token
+	* @param end The end of the text
+	* @param line Pointer to the line number of pos
+	* @param comment The first character of comment lines
+	* @return the token, empty at the end of the text
+	*/
+	static std::string_view headerToken(const char** pos, const char* end,
+		                                int* line, char comment);
+
+	/*
+	* Helper for ReadFile, parses the records of whole lines, stopping at
+	* the first line that is not valid
+	* @param begin The start of the first line
+	* @param end The end of the last line
+	* @param header The FileHeader of the file
+	* @param chunk The Chunk to fill, its vertex already set for METIS
+	*/
+	static void parseChunk(const char* begin, const char* end,
+		                   const FileHeader& header, Chunk* chunk);
+
+	/*
+	* Helper for parseChunk, parses a line of "label label weight" Edges
+	* @param pos The start of the line
+	* @param eol The end of the line
+	* @param chunk The Chunk to add Edges to
+	* @return true if the line is valid, else false
+	*/
+	static bool parseEdges(const char* pos, const char* eol, Chunk* chunk);
+
+	/*
+	* Helper for parseChunk, parses a line of a DIMACS, SNAP, Matrix Market
+	* or METIS file
+	* @param pos The start of the line
+	* @param eol The end of the line
+	* @param header The FileHeader of the file
+	* @param vertex Pointer to the index of the next METIS Vertex
+	* @param chunk The Chunk to add Edges to
+	* @return true if the line is valid, else false
+	*/
+	static bool parseLine(const char* pos, const char* eol,
+		                  const FileHeader& header, Id* vertex,
+		                  Chunk* chunk);
+
+	/*
+	* Helper for parseLine, parses the rest of a "from to weight" record
+	* @param from The starting label
+	* @param pos The position after the starting label
+	* @param eol The end of the line
+	* @param header The FileHeader of the file
+	* @param chunk The Chunk to add Edges to
+	* @return true if the record is valid, else false
+	*/
+	static bool parseRecord(std::string_view from, const char* pos,
+		                    const char* eol, const FileHeader& header,
+		                    Chunk* chunk);
+
+	/*
+	* Helper for parseLine, parses the neighbors of a METIS Vertex
+	* @param token The first token of the line
+	* @param pos The position after the first token
+	* @param eol The end of the line
+	* @param header The FileHeader of the file
+	* @param vertex The index of the Vertex
+	* @param chunk The Chunk to add Edges to
+	* @return true if the line is valid, else false
+	*/
+	static bool parseNeighbors(std::string_view token, const char* pos,
+		                       const char* eol, const FileHeader& header,
+		                       Id vertex, Chunk* chunk);
+
+	/*
+	* Helper for ReadFile, converts a numbered Vertex to its label
+	* @param token The token
+	* @param header The FileHeader declaring the Vertices
+	* @param label Pointer to store the label
+	* @param error Pointer to store the reason the token is not a Vertex
+	* @return true if the token is a number from 1 to n, else false
+	*/
+	static bool parseVertex(std::string_view token, const FileHeader& header,
+		                    std::string_view* label, std::string* error);
+
+	/*
+	* Helper for ReadFile, converts a whole token to a weight
+	* @param token The token
+	* @param real True to round a real number, else integers only
+	* @param weight Pointer to store the weight
+	* @return true if the token is a weight, else false
+	*/
+	static bool parseWeight(std::string_view token, bool real, Weight* weight);
+
+	/*
+	* Helper for ReadFile, replaces the contents of Graph with the first
+	* Edges of the chunks, following the rules of Connect, an Edge without an
+	* ending label only adds its starting Vertex
+	* @param chunks The parsed chunks in file order
+	* @param count The number of Edges to add, at most the Edges parsed
+	* @param pool The ThreadPool to sort on
+	*/
+	void build(const ChunkList& chunks, std::size_t count, ThreadPool* pool);
+
+	/*
+	* Helper for ReadFile, gets the next whitespace separated token
+	* @param pos Pointer to the position to read from, moved past the token
+	* @param end The end of the text
+	* @param line Pointer to the line number, counts the lines skipped unless
+	* the text ends
+	* @return the token, empty at the end of the text
+	*/
+	static std::string_view nextToken(const char** pos, const char* end,
+		                              int* line);
+
+	/*
+	* Helper for ReadFile, converts a whole token to an integer
+	* @param token The token
+	* @param value Pointer to store the integer
+	* @return true if the token is an integer, else false
+	*/
+	static bool parseInt(std::string_view token, int* value);
+
+	/*
+	* Helper for GetEdges, appends an Edge as "label(weight)"
+	* @param text The string to append to
+	* @param label The label of the adjacent Vertex
+	* @param weight The weight of the Edge
+	*/
+	static void appendEdge(std::string* text, std::string_view label,
+		                   const Weight& weight);
+
+	/*
+	* Helper for GetEdges, appends a weight in decimal without building a
+	* temporary string
+	* @param text The string to append to
+	* @param weight The weight to append
+	*/
+	static void appendWeight(std::string* text, const Weight& weight);
+
+	/*
+	* Helper for DFS and BFS, calls a visitor on a Vertex label
+	* @param func The callable to call
+	* @param label The label of the Vertex
+	* @return the Control returned by func, CONTINUE if it returns void
+	*/
+	template <typename Visitor>
+	static Control visit(Visitor& func, const Label& label);
+
+	/*
+	* Helper for Dijkstra, orders heap entries by weight, then by label, so
+	* Vertices at equal distance are settled in label order
+	* @param a The first entry
+	* @param b The second entry
+	* @return true if a is settled after b, else false
+	*/
+	static bool settlesAfter(const WeightId& a, const WeightId& b);
+
+	/*
+	* Helper for Dijkstra, repeatedly settles the closest Vertex in the heap
+	* and relaxes its outgoing Edges, stale heap entries are skipped
+	* @param workspace The ShortestPathWorkspace holding the search
+	*/
+	void dijkstra(ShortestPathWorkspace* workspace) const;
+
+	/*
+	* Helper for the batched Dijkstra and DistanceTable, searches from every
+	* source in the workspace of the worker that takes it, sources are
+	* taken one at a time so uneven searches balance out, the first
+	* exception thrown on a worker is rethrown once all workers stopped
+	* @param sources The labels of the origin Vertices
+	* @param sink The callable to call with the index of each source and
+	* the workspace holding its search
+	* @param pool The ThreadPool to search on
 	*/
-	Vertex* nextSmallest(const VertexSet* set, const WeightMap* wMap,
-		                 Label* label) const;
+	void dijkstra(const LabelList& sources, const SearchSink& sink,
+		          ThreadPool* pool) const;
 
 	/*
-	* Helper for dijkstra, updates an entry in the WeightMap if there is a shorter
-	* path
-	* @param curr The current Vertex
-	* @param pair The entry in the WeightMap to update
-	* @param label The label of the current Vertex
+	* Helper for dijkstra, updates the distance of every unsettled Vertex
+	* adjacent to the current Vertex if there is a shorter path through it
+	* @param curr The first Edge of the current Vertex
+	* @param currId The id of the current Vertex
+	* @param workspace The ShortestPathWorkspace holding the search
+	*/
+	void update(const Edge* curr, const Id& currId,
+		        ShortestPathWorkspace* workspace) const;
+
+	/*
+	* Helper for Dijkstra, records reached Vertices in WeightMap and PrevMap
+	* leaving out the origin and Vertices with a path of cost 0 in the
+	* WeightMap
+	* @param workspace The ShortestPathWorkspace holding the search
 	* @param wMap The WeightMap
 	* @param pMap The PrevMap
 	*/
-	void update(const Vertex* curr, const LabelWeight& pair,
-		        const Label& label, WeightMap* wMap, PrevMap* pMap) const;
+	void cleanWeights(const ShortestPathWorkspace* workspace,
+		              WeightMap* wMap, PrevMap* pMap) const;
 
 	/*
-	* Helper for Dijkstra, removes origin Vertex entry and entries in WeightMap that
-	* were not visited during Dijkstra 
-	* @param wMap The WeightMap
+	* Helper for MinSpanningTree, adds the Edges from a Vertex to unvisited
+	* Vertices as candidates
+	* @param id The id of the Vertex
+	* @param visited The visited marks
+	* @param heap The candidate Edges
+	*/
+	void addCandidates(const Id& id, const VisitedSet* visited,
+		               EdgeQ* heap) const;
+
+};
+
+/*
+* A ShortestPathWorkspace holds the distances, previous Vertices and heap
+* of one Dijkstra search at a time in flat arrays indexed by id.
+* Every Vertex id holds the number of the search that last reached it, so
+* a new search forgets the last one without touching its arrays and a
+* workspace reused across searches only allocates when the Graph grows.
+* Give each thread its own ShortestPathWorkspace.
+*/
+class Graph::ShortestPathWorkspace {
+
+	/* Graph runs searches in the workspace, ShortestPaths reads them */
+	friend class Graph;
+	friend class ShortestPaths;
+
+public:
+
+	/*
+	* Constructs empty ShortestPathWorkspace
+	*/
+	ShortestPathWorkspace();
+
+private:
+
+	/* The Graph searched last, nullptr before the first search */
+	const Graph* graph;
+
+	/* Id of the origin Vertex, NO_ID if it was not found */
+	Id origin;
+
+	/* Search that last reached each Vertex id, 0 for none */
+	std::vector<std::uint32_t> stamps;
+
+	/* Search that last settled each Vertex id, 0 for none */
+	std::vector<std::uint32_t> settled;
+
+	/* Number of the current search */
+	std::uint32_t epoch;
+
+	/* Distances indexed by id, valid for reached Vertices */
+	WeightList dist;
+
+	/* Previous Vertex ids indexed by id, valid for reached Vertices */
+	IdList prev;
+
+	/* Ids of reached Vertices in the order they were first reached */
+	IdList reached;
+
+	/* Tentative distances and Vertex ids, empty between searches */
+	WeightQ heap;
+
+	/*
+	* Starts a new search, no Vertex is reached afterwards
+	* @param graph The Graph to search
+	* @param origin The id of the origin Vertex, NO_ID for an empty search
 	*/
-	void cleanWeights(WeightMap* wMap);
+	void reset(const Graph* graph, const Id& origin);
 
 	/*
-	* Helper for MinSpanningTree, gets the Vertices connected to the next
-	* minimum cost Edge
-	* @param curr The starting Vertex on the next minimum cost Edge
-	* @param next The ending Vertex on the next minimum cost Edge
-	* @param label The label of the starting Vertex on the next minimum cost Edge
+	* Returns true if Vertex reached by the current search, else false
+	* @param id The id of the Vertex
+	* @return true if Vertex reached, else false
 	*/
-	void nextMinEdge(Vertex*& curr, Vertex*& next, Label* label);
+	bool isReached(const Id& id) const;
 
 	/*
-	* Mark all verticies as unvisited
+	* Marks a Vertex as settled, its distance no longer changes
+	* @param id The id of the Vertex
+	* @return true if the Vertex was not settled before, else false
 	*/
-	void unvisitVertices();
+	bool settle(const Id& id);
 
+	/*
+	* Records a path to an unsettled Vertex if it is shorter than the one
+	* known
+	* @param id The id of the Vertex
+	* @param weight The cost of the path
+	* @param from The id of the previous Vertex on the path
+	* @return true if the path is shorter, else false
+	*/
+	bool reach(const Id& id, const Weight& weight, const Id& from);
 };
+
+/*
+* ShortestPaths is the result of a Dijkstra search into a
+* ShortestPathWorkspace, it answers distances and paths by reading the
+* workspace arrays directly instead of copying them into maps.
+*/
+class Graph::ShortestPaths {
+
+public:
+
+	/*
+	* Constructs ShortestPaths over the last search of a workspace
+	* @param workspace The ShortestPathWorkspace searched in
+	*/
+	explicit ShortestPaths(const ShortestPathWorkspace* workspace);
+
+	/*
+	* Get the label of the origin Vertex
+	* @return label of the origin Vertex, NO_LABEL if it was not found
+	*/
+	const Label& Origin() const;
+
+	/*
+	* Get the number of Vertices reached, including the origin
+	* @return number of Vertices reached
+	*/
+	int NumberOfReached() const;
+
+	/*
+	* Get the cost of the shortest path to a Vertex
+	* @param label The label of the Vertex
+	* @return cost of the shortest path, INT_MAX if there is no path
+	*/
+	Weight Distance(const Label& label) const;
+
+	/*
+	* Get the Vertex before another on its shortest path
+	* @param label The label of the Vertex
+	* @return label of the previous Vertex, NO_LABEL for the origin or if
+	* there is no path
+	*/
+	const Label& Previous(const Label& label) const;
+
+	/*
+	* Get the shortest path to a Vertex
+	* @param label The label of the Vertex
+	* @param path The Path to fill with labels from origin to the Vertex,
+	* empty if there is no path
+	* @return cost of the shortest path, INT_MAX if there is no path
+	*/
+	Weight GetPath(const Label& label, Path& path) const;
+
+private:
+
+	/* The workspace holding the search */
+	const ShortestPathWorkspace* workspace;
+
+	/*
+	* Gets the id of a reached Vertex
+	* @param label The label of the Vertex
+	* @return id of the Vertex, or NO_ID if not found or not reached
+	*/
+	Id find(const Label& label) const;
+};
+
+/*
+* An EdgeStream reads Edge records from an istream one line at a time,
+* without a leading number of Edges, for ReadBatch to apply in batches.
+* A line "label label weight" connects two Vertices, a line "- label label"
+* disconnects them and blank lines are skipped, so a Vertex labelled "-"
+* cannot be connected. The records of a batch are kept between batches,
+* so a stream only allocates when its batches grow.
+*/
+class Graph::EdgeStream {
+
+	/* Graph applies the records read */
+	friend class Graph;
+
+public:
+
+	/*
+	* Constructs EdgeStream reading from an istream
+	* @param in The istream to read from, such as std::cin
+	* @param name The name of the stream in errors
+	*/
+	EdgeStream(std::istream& in, const std::string& name);
+
+	/*
+	* Returns true if records may follow, else false
+	* @return false once the stream ended or stopped, else true
+	*/
+	bool Good() const;
+
+	/*
+	* Gets the reason the stream stopped
+	* @return the error as "name:line: message", empty if none
+	*/
+	const std::string& Error() const;
+
+	/*
+	* Gets the number of lines read
+	* @return the number of lines read
+	*/
+	int Lines() const;
+
+private:
+
+	/* One line of the stream */
+	struct Record {
+
+		/* Starting Vertex label */
+		Label from;
+
+		/* Ending Vertex label */
+		Label to;
+
+		/* Edge weight, NO_WEIGHT when disconnecting */
+		Weight weight;
+
+		/* True to disconnect, false to connect */
+		bool remove;
+	};
+
+	/* The istream read from */
+	std::istream* in;
+
+	/* Name of the stream in errors */
+	std::string name;
+
+	/* The last line read */
+	std::string line;
+
+	/* Number of lines read */
+	int lines;
+
+	/* Reason the stream stopped, empty if none */
+	std::string error;
+
+	/* Records of the current batch, only the first ones read are valid */
+	std::vector<Record> records;
+
+	/* Changes of the current batch */
+	EdgeChangeList changes;
+
+	/*
+	* Reads up to limit records, stopping at the end of the stream or at
+	* the first line that is not valid
+	* @param limit The largest number of records to read
+	* @return the number of records read
+	*/
+	std::size_t read(std::size_t limit);
+};
+
+/*
+* A Traversal is a single-pass range over the labels of the Vertices
+* reached from an origin Vertex, depth-first or breadth-first.
+* Adjacent Vertices are only looked at when iteration moves past a Vertex,
+* so stopping early never pays for the rest of the traversal.
+*/
+class Graph::Traversal {
+
+public:
+
+	/*
+	* Input iterator over a Traversal, all copies share its position
+	*/
+	class Iterator {
+
+	public:
+
+		/*
+		* Result of post-increment, holds the label of the Vertex the
+		* Iterator was at before it moved
+		*/
+		class Postfix {
+
+		public:
+
+			/*
+			* Constructs Postfix holding a label
+			* @param label The label of the Vertex before the increment
+			*/
+			explicit Postfix(const Label* label);
+
+			/*
+			* Gets the label of the Vertex before the increment
+			* @return label of the Vertex before the increment
+			*/
+			const Label& operator*() const;
+
+		private:
+
+			/* The label, owned by the Graph traversed */
+			const Label* label;
+		};
+
+		/* Type definitions */
+		using iterator_category = std::input_iterator_tag;
+		using value_type        = Label;
+		using difference_type   = std::ptrdiff_t;
+		using pointer           = const Label*;
+		using reference         = const Label&;
+
+		/*
+		* Constructs Iterator at the current Vertex of a Traversal
+		* @param traversal The Traversal, defaults to none for the end
+		*/
+		explicit Iterator(Traversal* traversal = nullptr);
+
+		/*
+		* Gets the label of the current Vertex
+		* @return label of the current Vertex
+		*/
+		reference operator*() const;
+
+		/*
+		* Gets the label of the current Vertex
+		* @return pointer to label of the current Vertex
+		*/
+		pointer operator->() const;
+
+		/*
+		* Moves to the next Vertex of the Traversal
+		* @return this by reference
+		*/
+		Iterator& operator++();
+
+		/*
+		* Moves to the next Vertex of the Traversal
+		* @return Postfix holding the label of the Vertex before the move
+		*/
+		Postfix operator++(int);
+
+		/*
+		* Checks if two Iterators are both at the end or both not
+		* @param other The other Iterator
+		* @return true if equal, else false
+		*/
+		bool operator==(const Iterator& other) const;
+
+		/*
+		* Checks if two Iterators are not equal
+		* @param other The other Iterator
+		* @return true if not equal, else false
+		*/
+		bool operator!=(const Iterator& other) const;
+
+	private:
+
+		/* The Traversal iterated, nullptr for the end */
+		Traversal* traversal;
+
+		/*
+		* Returns true if the Iterator is past the last Vertex
+		* @return true if at the end, else false
+		*/
+		bool atEnd() const;
+	};
+
+	/*
+	* Constructs Traversal from a Vertex
+	* @param graph The Graph to traverse
+	* @param origin The id of the origin Vertex, NO_ID for an empty range
+	* @param depthFirst True for depth-first, false for breadth-first order
+	*/
+	Traversal(const Graph* graph, const Id& origin, bool depthFirst);
+
+	/*
+	* Gets an Iterator at the current Vertex
+	* @return Iterator at the current Vertex
+	*/
+	Iterator begin();
+
+	/*
+	* Gets the Iterator past the last Vertex
+	* @return Iterator past the last Vertex
+	*/
+	Iterator end();
+
+	/*
+	* Gets the number of Edges from the origin to the current Vertex along
+	* the Traversal, the shortest number for breadth-first order
+	* @return depth of the current Vertex
+	*/
+	int Depth() const;
+
+	/*
+	* Leaves out the adjacent Vertices of the current Vertex, unless they
+	* are reached through another Vertex
+	*/
+	void Skip();
+
+private:
+
+	/* Type definitions */
+	using IdDepth  = std::pair<Id, int>;
+	using IdDepthQ = std::queue<IdDepth>;
+
+	/* The Graph traversed */
+	const Graph* graph;
+
+	/* True for depth-first, false for breadth-first order */
+	bool depthFirst;
+
+	/* Vertices reached so far */
+	VisitedSet visited;
+
+	/* Depth-first path to the current Vertex with the next Edge to try */
+	IdEdgeStack stack;
+
+	/* Breadth-first queue of reached Vertices with their depth */
+	IdDepthQ q;
+
+	/* Id of the current Vertex, NO_ID once done */
+	Id current;
+
+	/* Depth of the current Vertex */
+	int depth;
+
+	/* True if the adjacent Vertices of the current Vertex are left out */
+	bool skipped;
+
+	/*
+	* Moves to the next Vertex, expanding the current one unless skipped
+	*/
+	void advance();
+};
+
+/*
+* Depth-first traversal originating from Vertex with given label
+* @param label The origin Vertex label
+* @param func The function or other callable to call on each Vertex
+* label, returning void or a Control
+*/
+template <typename Visitor>
+void Graph::DFS(const Label& label, Visitor func) const {
+
+	VisitedSet visited;
+
+	this->DFS(label, func, visited);
+}
+
+/*
+* Depth-first traversal reusing the visited marks of earlier traversals
+* The stack holds each Vertex on the current path with the next Edge to
+* try, so every Edge is looked at once
+* @param label The origin Vertex label
+* @param func The function or other callable to call on each Vertex
+* label, returning void or a Control
+* @param visited The VisitedSet to track visited Vertices in
+*/
+template <typename Visitor>
+void Graph::DFS(const Label& label, Visitor func, VisitedSet& visited) const {
+
+	Id id = this->find(label);
+
+	if (id == Graph::NO_ID) {
+
+		return;
+	}
+
+	IdEdgeStack stack;
+
+	visited.Reset(this->vertices.size());
+	visited.Visit(id);
+
+	Control control = Graph::visit(func, label);
+
+	if (control == Control::CONTINUE) {
+
+		stack.emplace(id, this->vertices[id].getNext());
+	}
+
+	while (!stack.empty() && control != Control::STOP) {
+
+		const Edge*& edge = stack.top().second;
+
+		while (edge != nullptr && visited.IsVisited(edge->getId())) {
+
+			edge = edge->getNext();
+		}
+
+		if (edge == nullptr) {
+
+			stack.pop();
+
+		} else {
+
+			id = edge->getId();
+
+			visited.Visit(id);
+
+			control = Graph::visit(func, this->labels[id]);
+
+			if (control == Control::CONTINUE) {
+
+				stack.emplace(id, this->vertices[id].getNext());
+			}
+		}
+	}
+}
+
+/*
+* Breadth-first traversal originating from Vertex with given label
+* @param label The origin Vertex label
+* @param func The function or other callable to call on each Vertex
+* label, returning void or a Control
+*/
+template <typename Visitor>
+void Graph::BFS(const Label& label, Visitor func) const {
+
+	VisitedSet visited;
+
+	this->BFS(label, func, visited);
+}
+
+/*
+* Breadth-first traversal reusing the visited marks of earlier traversals
+* Vertices are marked when queued and visited when dequeued
+* @param label The origin Vertex label
+* @param func The function or other callable to call on each Vertex
+* label, returning void or a Control
+* @param visited The VisitedSet to track visited Vertices in
+*/
+template <typename Visitor>
+void Graph::BFS(const Label& label, Visitor func, VisitedSet& visited) const {
+
+	Id id = this->find(label);
+
+	if (id == Graph::NO_ID) {
+
+		return;
+	}
+
+	IdQ q;
+
+	visited.Reset(this->vertices.size());
+	visited.Visit(id);
+
+	q.push(id);
+
+	while (!q.empty()) {
+
+		id = q.front();
+
+		q.pop();
+
+		Control control = Graph::visit(func, this->labels[id]);
+
+		if (control == Control::STOP) {
+
+			return;
+		}
+
+		const Edge* edge = (control == Control::CONTINUE) ?
+			               this->vertices[id].getNext() : nullptr;
+
+		while (edge != nullptr) {
+
+			if (visited.Visit(edge->getId())) {
+
+				q.push(edge->getId());
+			}
+
+			edge = edge->getNext();
+		}
+	}
+}
+
+/*
+* Helper for DFS and BFS, calls a visitor on a Vertex label
+* @param func The callable to call
+* @param label The label of the Vertex
+* @return the Control returned by func, CONTINUE if it returns void
+*/
+template <typename Visitor>
+Graph::Control Graph::visit(Visitor& func, const Label& label) {
+
+	if constexpr (std::is_void_v<std::invoke_result_t<Visitor&,
+		                                              const Label&>>) {
+
+		func(label);
+
+		return Control::CONTINUE;
+
+	} else {
+
+		return func(label);
+	}
+}
 #endif  // GRAPH_H
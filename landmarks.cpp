@@ -0,0 +1,129 @@
+/*
+* landmarks.cpp
+*
+* Implementations for Landmarks class
+*
+* @author Juan Arias
+*
+*/
+
+#include <algorithm>
+#include "landmarks.h"
+
+/*
+* Picks landmarks and computes their distances, each landmark is the
+* Vertex farthest from the landmarks picked before it, the first one is the
+* Vertex farthest from the first Vertex
+* Distance to the landmarks counts both ways, unreachable Vertices count as
+* farthest so every component ends up with a landmark when possible
+* @param graph The FrozenGraph to pick landmarks on
+* @param count The number of landmarks, at most the number of Vertices
+*/
+Landmarks::Landmarks(const FrozenGraph& graph, int count) {
+
+	std::size_t vertices = graph.labels.size(),
+		        size = std::min(vertices, static_cast<std::size_t>(
+					                std::max(count, Graph::EMPTY)));
+
+	FrozenGraph::WeightList forward, backward;
+	FrozenGraph::IdList prev(vertices);
+	std::vector<long long> farthest(vertices, LLONG_MAX);
+
+	this->from.resize(vertices * size);
+	this->to.resize(vertices * size);
+
+	Id next(0);
+
+	for (std::size_t k(0); k <= size && size > 0; ++k) {
+
+		forward.assign(vertices, INT_MAX);
+		backward.assign(vertices, INT_MAX);
+		forward[next] = Graph::NO_WEIGHT;
+		backward[next] = Graph::NO_WEIGHT;
+
+		graph.binaryHeap(next, &forward, &prev);
+		graph.binaryHeap(next, &backward, &prev, true);
+
+		if (k > 0) {
+
+			this->labels.push_back(graph.labels[next]);
+
+			for (std::size_t v(0); v < vertices; ++v) {
+
+				this->from[v * size + k - 1] = forward[v];
+				this->to[v * size + k - 1] = backward[v];
+			}
+		}
+
+		for (std::size_t v(0); v < vertices; ++v) {
+
+			farthest[v] = std::min(farthest[v],
+				static_cast<long long>(forward[v]) + backward[v]);
+		}
+
+		if (k > 0) {
+
+			farthest[next] = -Graph::COUNT;
+		}
+
+		next = static_cast<Id>(std::max_element(farthest.begin(),
+			                                    farthest.end()) -
+			                   farthest.begin());
+
+		if (k == 0) {
+
+			farthest.assign(vertices, LLONG_MAX);
+		}
+	}
+}
+
+/*
+* Get the number of landmarks
+* @return number of landmarks
+*/
+int Landmarks::Size() const {
+
+	return static_cast<int>(this->labels.size());
+}
+
+/*
+* Get the labels of the landmarks, in the order they were picked
+* @return labels of the landmarks
+*/
+std::vector<Landmarks::Label> Landmarks::GetLandmarks() const {
+
+	return this->labels;
+}
+
+/*
+* Gets a lower bound on the cost between two Vertices
+* @param id The id of the starting Vertex
+* @param target The id of the ending Vertex
+* @return lower bound on the cost, 0 if no landmark gives one
+*/
+Landmarks::Weight Landmarks::estimate(const Id& id, const Id& target) const {
+
+	std::size_t size = this->labels.size();
+
+	const Weight* fromV = this->from.data() + id * size,
+		        * fromT = this->from.data() + target * size,
+		        * toV = this->to.data() + id * size,
+		        * toT = this->to.data() + target * size;
+
+	Weight bound = Graph::NO_WEIGHT;
+
+	for (std::size_t k(0); k < size; ++k) {
+
+		if (fromT[k] != INT_MAX && fromV[k] != INT_MAX) {
+
+			bound = std::max(bound, fromT[k] - fromV[k]);
+		}
+
+		if (toV[k] != INT_MAX && toT[k] != INT_MAX) {
+
+			bound = std::max(bound, toV[k] - toT[k]);
+		}
+	}
+
+	return bound;
+}
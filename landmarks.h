@@ -0,0 +1,75 @@
+/*
+* landmarks.h
+*
+* Interface/specifications for Landmarks class
+*
+* @author Juan Arias
+*
+*/
+
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <vector>
+#include "frozengraph.h"
+
+/*
+* Landmarks are Vertices of a FrozenGraph whose distances to and from every
+* other Vertex are computed ahead of time.
+* By the triangle inequality, for any landmark L the cost from v to t is at
+* least d(L, t) - d(L, v) and at least d(v, L) - d(t, L), which gives
+* FrozenGraph::AStar a lower bound that never overestimates.
+* Landmarks are only valid for the FrozenGraph they were built on.
+*/
+class Landmarks {
+
+	/* FrozenGraph::AStar uses the estimates */
+	friend class FrozenGraph;
+
+public:
+
+	/* Type definitions */
+	using Label  = FrozenGraph::Label;
+	using Weight = FrozenGraph::Weight;
+	using Id     = FrozenGraph::Id;
+
+	/*
+	* Picks landmarks and computes their distances, each landmark is the
+	* Vertex farthest from the landmarks picked before it
+	* @param graph The FrozenGraph to pick landmarks on
+	* @param count The number of landmarks, at most the number of Vertices
+	*/
+	Landmarks(const FrozenGraph& graph, int count);
+
+	/*
+	* Get the number of landmarks
+	* @return number of landmarks
+	*/
+	int Size() const;
+
+	/*
+	* Get the labels of the landmarks, in the order they were picked
+	* @return labels of the landmarks
+	*/
+	std::vector<Label> GetLandmarks() const;
+
+private:
+
+	/* Labels of the landmarks */
+	std::vector<Label> labels;
+
+	/* Distance from landmark k to Vertex v at [v * Size() + k] */
+	std::vector<Weight> from;
+
+	/* Distance from Vertex v to landmark k at [v * Size() + k] */
+	std::vector<Weight> to;
+
+	/*
+	* Gets a lower bound on the cost between two Vertices
+	* @param id The id of the starting Vertex
+	* @param target The id of the ending Vertex
+	* @return lower bound on the cost, 0 if no landmark gives one
+	*/
+	Weight estimate(const Id& id, const Id& target) const;
+};
+#endif  // LANDMARKS_H
@@ -0,0 +1,512 @@
+/*
+* snapshot.cpp
+*
+* Implementations for Snapshot class
+*
+* @author Juan Arias
+*
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "snapshot.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* Constant definitions */
+const std::uint32_t Snapshot::VERSION(2);
+
+/* Magic bytes at the start of every file */
+static const char MAGIC[8] = { 'G', 'R', 'A', 'P', 'H', 'S', 'N', 'P' };
+
+/* Byte order mark, reads back differently on a machine of other order */
+static const std::uint32_t ORDER_MARK(0x01020304);
+
+/*
+* Constructs closed Snapshot
+*/
+Snapshot::Snapshot()
+
+	:data(nullptr), size(0), mapped(false), labelOffsets(nullptr),
+	offsets(nullptr), targets(nullptr), weights(nullptr), order(nullptr),
+	labelBytes(nullptr), vertices(0) {}
+
+/*
+* Unmaps the file if open
+*/
+Snapshot::~Snapshot() {
+
+	this->Close();
+}
+
+/*
+* Saves a Graph to a file
+* Vertices keep their ids, so adjacency lists copy straight into the Edge
+* arrays, and walking the label dictionary gives the ids in label order
+* @param graph The Graph to save
+* @param fileName The name of the file
+* @return true if file successfully written, else false
+*/
+bool Snapshot::Save(const Graph& graph, const std::string& fileName) {
+
+	std::size_t vertices = graph.labels.size();
+
+	std::vector<std::uint64_t> labelOffsets(Graph::COUNT, 0);
+	std::vector<std::uint32_t> offsets(Graph::COUNT, 0), targets, order;
+	std::vector<std::int32_t> weights;
+	std::string labelBytes;
+
+	for (Id id(0); id < vertices; ++id) {
+
+		labelBytes += graph.labels[id];
+		labelOffsets.push_back(labelBytes.size());
+
+		const Graph::Edge* edge = graph.vertices[id].getNext();
+
+		for (; edge != nullptr; edge = edge->getNext()) {
+
+			targets.push_back(edge->getId());
+			weights.push_back(edge->getWeight());
+		}
+
+		offsets.push_back(static_cast<std::uint32_t>(targets.size()));
+	}
+
+	order.reserve(vertices);
+
+	for (const Graph::LabelId& entry : graph.map) {
+
+		order.push_back(entry.second);
+	}
+
+	std::string payload;
+
+	for (const std::string_view& array : {
+		 std::string_view(reinterpret_cast<const char*>(labelOffsets.data()),
+			              labelOffsets.size() * sizeof(std::uint64_t)),
+		 std::string_view(reinterpret_cast<const char*>(offsets.data()),
+			              offsets.size() * sizeof(std::uint32_t)),
+		 std::string_view(reinterpret_cast<const char*>(targets.data()),
+			              targets.size() * sizeof(std::uint32_t)),
+		 std::string_view(reinterpret_cast<const char*>(weights.data()),
+			              weights.size() * sizeof(std::int32_t)),
+		 std::string_view(reinterpret_cast<const char*>(order.data()),
+			              order.size() * sizeof(std::uint32_t)),
+		 std::string_view(labelBytes) }) {
+
+		payload.append(array.data(), array.size());
+		payload.append(Snapshot::pad(array.size()) - array.size(), '\0');
+	}
+
+	Header header;
+
+	std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+	header.version = Snapshot::VERSION;
+	header.byteOrder = ORDER_MARK;
+	header.vertices = static_cast<std::uint32_t>(vertices);
+	header.edges = static_cast<std::uint32_t>(targets.size());
+	header.labelBytes = labelBytes.size();
+	header.checksum = Snapshot::checksum(payload.data(), payload.size());
+
+	std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+	file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+
+	return static_cast<bool>(file.flush());
+}
+
+/*
+* Maps a file written by Save, closing any file open before
+* Files are mapped read-only where mmap is available, elsewhere they are
+* read into memory with a single read
+* @param fileName The name of the file
+* @param verify True to check the checksum, defaults to true
+* @return true if file successfully mapped, else false
+*/
+bool Snapshot::Open(const std::string& fileName, bool verify) {
+
+	this->Close();
+
+#if defined(__unix__) || defined(__APPLE__)
+	int fd = ::open(fileName.c_str(), O_RDONLY);
+
+	if (fd != -1) {
+
+		struct stat info;
+
+		if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+
+			std::size_t bytes = static_cast<std::size_t>(info.st_size);
+			void* start = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+
+			if (start != MAP_FAILED) {
+
+				this->data = static_cast<const char*>(start);
+				this->size = bytes;
+				this->mapped = true;
+			}
+		}
+
+		::close(fd);
+	}
+#endif
+
+	if (this->data == nullptr) {
+
+		std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+		std::streamoff bytes = (file.is_open()) ?
+			                   static_cast<std::streamoff>(file.tellg()) : -1;
+
+		if (bytes <= 0) {
+
+			return false;
+		}
+
+		this->buffer.resize(static_cast<std::size_t>(bytes));
+
+		file.seekg(0);
+
+		if (!file.read(this->buffer.data(), bytes)) {
+
+			this->buffer.clear();
+
+			return false;
+		}
+
+		this->data = this->buffer.data();
+		this->size = this->buffer.size();
+	}
+
+	if (!this->attach(verify)) {
+
+		this->Close();
+
+		return false;
+	}
+
+	return true;
+}
+
+/*
+* Unmaps the file if open
+*/
+void Snapshot::Close() {
+
+#if defined(__unix__) || defined(__APPLE__)
+	if (this->mapped) {
+
+		::munmap(const_cast<char*>(this->data), this->size);
+	}
+#endif
+
+	this->buffer.clear();
+	this->buffer.shrink_to_fit();
+	this->data = nullptr;
+	this->size = 0;
+	this->mapped = false;
+	this->labelOffsets = nullptr;
+	this->offsets = nullptr;
+	this->targets = nullptr;
+	this->weights = nullptr;
+	this->order = nullptr;
+	this->labelBytes = nullptr;
+	this->vertices = 0;
+}
+
+/*
+* Returns true if a file is open, else false
+* @return true if a file is open, else false
+*/
+bool Snapshot::IsOpen() const {
+
+	return this->data != nullptr;
+}
+
+/*
+* Get the total number of Vertices in Snapshot
+* @return total number of Vertices in Snapshot
+*/
+int Snapshot::NumberOfVertices() const {
+
+	return static_cast<int>(this->vertices);
+}
+
+/*
+* Get the total number of Edges in Snapshot
+* @return total number of Edges in Snapshot
+*/
+int Snapshot::NumberOfEdges() const {
+
+	return (this->IsOpen()) ? static_cast<int>(this->offsets[this->vertices]) :
+		                      Graph::EMPTY;
+}
+
+/*
+* Get the number of Edges connected to a given Vertex
+* @param label The label of the Vertex
+* @return number of edges from Vertex, -1 if Vertex not found
+*/
+int Snapshot::NumberOfEdges(const Label& label) const {
+
+	int edges(Graph::EMPTY - Graph::COUNT);
+
+	Id id = this->find(label);
+
+	if (id != Graph::NO_ID) {
+
+		edges = static_cast<int>(this->offsets[id + 1] - this->offsets[id]);
+	}
+
+	return edges;
+}
+
+/*
+* Check is Vertex exists in Snapshot
+* @param label The label of the vertex to find
+* @return true if Vertex in Snapshot, else false
+*/
+bool Snapshot::HasVertex(const Label& label) const {
+
+	return this->find(label) != Graph::NO_ID;
+}
+
+/*
+* String representation of Edges from a given Vertex
+* @param label The label of the Vertex to get Edges from
+* @return string representing Edges and weights, "" if Vertex not found
+*/
+std::string Snapshot::GetEdges(const Label& label) const {
+
+	std::string edges;
+
+	Id id = this->find(label);
+
+	if (id != Graph::NO_ID) {
+
+		for (Id e(this->offsets[id]); e < this->offsets[id + 1]; ++e) {
+
+			if (e != this->offsets[id]) {
+
+				edges += Graph::COMMA;
+			}
+
+			Graph::appendEdge(&edges, this->label(this->targets[e]),
+				              this->weights[e]);
+		}
+	}
+
+	return edges;
+}
+
+/*
+* Breadth-first traversal originating from Vertex with given label
+* Vertices are marked when queued and visited when dequeued
+* @param label The origin Vertex label
+* @param func The function to call on each Vertex label
+*/
+void Snapshot::BFS(const Label& label, Visit func) const {
+
+	Id id = this->find(label);
+
+	if (id == Graph::NO_ID) {
+
+		return;
+	}
+
+	Graph::VisitedSet visited;
+	std::vector<Id> queue(Graph::COUNT, id);
+
+	visited.Reset(this->vertices);
+	visited.Visit(id);
+
+	for (std::size_t next(0); next < queue.size(); ++next) {
+
+		Id curr = queue[next];
+
+		func(Label(this->label(curr)));
+
+		for (Id e(this->offsets[curr]); e < this->offsets[curr + 1]; ++e) {
+
+			if (visited.Visit(this->targets[e])) {
+
+				queue.push_back(this->targets[e]);
+			}
+		}
+	}
+}
+
+/*
+* Gets the label of a Vertex
+* @param id The id of the Vertex
+* @return view of the label in the file
+*/
+std::string_view Snapshot::label(const Id& id) const {
+
+	return std::string_view(this->labelBytes + this->labelOffsets[id],
+		                    this->labelOffsets[id + 1] -
+		                    this->labelOffsets[id]);
+}
+
+/*
+* Gets the id of the Vertex with given label
+* The ids sorted by label are binary searched
+* @param label The label of the Vertex
+* @return id of the Vertex, or NO_ID if not found
+*/
+Snapshot::Id Snapshot::find(const Label& label) const {
+
+	Id low(0), high(this->vertices);
+
+	while (low < high) {
+
+		Id middle = low + (high - low) / 2;
+
+		if (this->label(this->order[middle]) < label) {
+
+			low = middle + 1;
+
+		} else {
+
+			high = middle;
+		}
+	}
+
+	return (low < this->vertices && this->label(this->order[low]) == label) ?
+		   this->order[low] : Graph::NO_ID;
+}
+
+/*
+* Helper for Open, points the arrays into the file after checking the
+* header describes arrays that fit in it
+* Verifying also checks the arrays only hold ids and offsets in range, so
+* a file that passes can be queried without further checks
+* @param verify True to check the checksum
+* @return true if the file holds a valid Snapshot, else false
+*/
+bool Snapshot::attach(bool verify) {
+
+	if (this->size < sizeof(Header)) {
+
+		return false;
+	}
+
+	const Header* header = reinterpret_cast<const Header*>(this->data);
+
+	if (std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+		header->version != Snapshot::VERSION ||
+		header->byteOrder != ORDER_MARK) {
+
+		return false;
+	}
+
+	std::uint64_t vertices = header->vertices,
+		          edges = header->edges,
+		          expected = sizeof(Header) +
+		                     Snapshot::pad((vertices + 1) * 8) +
+		                     Snapshot::pad((vertices + 1) * 4) +
+		                     Snapshot::pad(edges * 4) * 2 +
+		                     Snapshot::pad(vertices * 4) +
+		                     Snapshot::pad(header->labelBytes);
+
+	if (expected != this->size) {
+
+		return false;
+	}
+
+	const char* pos = this->data + sizeof(Header);
+
+	this->labelOffsets = reinterpret_cast<const std::uint64_t*>(pos);
+	pos += Snapshot::pad((vertices + 1) * 8);
+	this->offsets = reinterpret_cast<const std::uint32_t*>(pos);
+	pos += Snapshot::pad((vertices + 1) * 4);
+	this->targets = reinterpret_cast<const std::uint32_t*>(pos);
+	pos += Snapshot::pad(edges * 4);
+	this->weights = reinterpret_cast<const std::int32_t*>(pos);
+	pos += Snapshot::pad(edges * 4);
+	this->order = reinterpret_cast<const std::uint32_t*>(pos);
+	pos += Snapshot::pad(vertices * 4);
+	this->labelBytes = pos;
+	this->vertices = header->vertices;
+
+	if (this->offsets[vertices] != edges ||
+		this->labelOffsets[vertices] != header->labelBytes) {
+
+		return false;
+	}
+
+	if (verify) {
+
+		std::uint64_t sum = Snapshot::checksum(this->data + sizeof(Header),
+			                                   this->size - sizeof(Header));
+
+		if (sum != header->checksum) {
+
+			return false;
+		}
+
+		for (std::uint64_t id(0); id < vertices; ++id) {
+
+			if (this->offsets[id] > this->offsets[id + 1] ||
+				this->labelOffsets[id] > this->labelOffsets[id + 1]) {
+
+				return false;
+			}
+		}
+
+		for (std::uint64_t i(0); i < vertices; ++i) {
+
+			if (this->order[i] >= vertices || (i > 0 &&
+				!(this->label(this->order[i - 1]) <
+				  this->label(this->order[i])))) {
+
+				return false;
+			}
+		}
+
+		for (std::uint64_t e(0); e < edges; ++e) {
+
+			if (this->targets[e] >= vertices) {
+
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/*
+* Gets the size of an array rounded up to a multiple of 8 bytes
+* @param bytes The size of the array
+* @return the padded size
+*/
+std::uint64_t Snapshot::pad(const std::uint64_t& bytes) {
+
+	return (bytes + 7) / 8 * 8;
+}
+
+/*
+* FNV-1a hash of a range of bytes
+* @param bytes The start of the range
+* @param count The number of bytes
+* @return the hash
+*/
+std::uint64_t Snapshot::checksum(const char* bytes, std::size_t count) {
+
+	std::uint64_t hash(0xcbf29ce484222325ULL);
+
+	for (std::size_t i(0); i < count; ++i) {
+
+		hash ^= static_cast<unsigned char>(bytes[i]);
+		hash *= 0x100000001b3ULL;
+	}
+
+	return hash;
+}
@@ -0,0 +1,227 @@
+/*
+* snapshot.h
+*
+* Interface/specifications for Snapshot class
+*
+* @author Juan Arias
+*
+*/
+
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "graph.h"
+
+/*
+* A Snapshot is a Graph saved in a binary file and mapped back into memory.
+* The file holds a header, the label table, compressed-sparse-row offsets,
+* targets and weights, all in id order so a loaded Graph keeps the ids of
+* the saved one, the ids sorted by label for lookups, and a checksum of
+* everything after the header. Queries read the mapped arrays directly, so opening a
+* Snapshot costs no parsing and processes opening the same file share its
+* pages. Files use the byte order of the machine that saved them.
+*/
+class Snapshot {
+
+	/* Graph::Load rebuilds its adjacency lists from the mapped arrays */
+	friend class Graph;
+
+public:
+
+	/* Type definitions */
+	using Label  = Graph::Label;
+	using Weight = Graph::Weight;
+	using Id     = Graph::Id;
+	using Visit  = Graph::Visit;
+
+	/* Version of the file layout written by Save */
+	static const std::uint32_t VERSION;
+
+	/*
+	* Constructs closed Snapshot
+	*/
+	Snapshot();
+
+	/*
+	* Unmaps the file if open
+	*/
+	virtual ~Snapshot();
+
+	Snapshot(const Snapshot& other)            = delete;
+	Snapshot& operator=(const Snapshot& other) = delete;
+
+	/*
+	* Saves a Graph to a file
+	* @param graph The Graph to save
+	* @param fileName The name of the file
+	* @return true if file successfully written, else false
+	*/
+	static bool Save(const Graph& graph, const std::string& fileName);
+
+	/*
+	* Maps a file written by Save, closing any file open before
+	* The header and array sizes are always checked, the checksum reads the
+	* whole file and can be skipped for files that are trusted
+	* @param fileName The name of the file
+	* @param verify True to check the checksum, defaults to true
+	* @return true if file successfully mapped, else false
+	*/
+	bool Open(const std::string& fileName, bool verify = true);
+
+	/*
+	* Unmaps the file if open
+	*/
+	void Close();
+
+	/*
+	* Returns true if a file is open, else false
+	* @return true if a file is open, else false
+	*/
+	bool IsOpen() const;
+
+	/*
+	* Get the total number of Vertices in Snapshot
+	* @return total number of Vertices in Snapshot
+	*/
+	int NumberOfVertices() const;
+
+	/*
+	* Get the total number of Edges in Snapshot
+	* @return total number of Edges in Snapshot
+	*/
+	int NumberOfEdges() const;
+
+	/*
+	* Get the number of Edges connected to a given Vertex
+	* @param label The label of the Vertex
+	* @return number of edges from Vertex, -1 if Vertex not found
+	*/
+	int NumberOfEdges(const Label& label) const;
+
+	/*
+	* Check is Vertex exists in Snapshot
+	* @param label The label of the vertex to find
+	* @return true if Vertex in Snapshot, else false
+	*/
+	bool HasVertex(const Label& label) const;
+
+	/*
+	* String representation of Edges from a given Vertex
+	* @param label The label of the Vertex to get Edges from
+	* @return string representing Edges and weights, "" if Vertex not found
+	*/
+	std::string GetEdges(const Label& label) const;
+
+	/*
+	* Breadth-first traversal originating from Vertex with given label
+	* @param label The origin Vertex label
+	* @param func The function to call on each Vertex label
+	*/
+	void BFS(const Label& label, Visit func) const;
+
+private:
+
+	/*
+	* Start of the file, every array after it starts on a multiple of 8
+	* bytes in the order labelOffsets, offsets, targets, weights, order,
+	* labelBytes
+	*/
+	struct Header {
+
+		/* "GRAPHSNP" */
+		char magic[8];
+
+		/* Layout version, VERSION */
+		std::uint32_t version;
+
+		/* 0x01020304 in the byte order of the machine that saved it */
+		std::uint32_t byteOrder;
+
+		/* Number of Vertices */
+		std::uint32_t vertices;
+
+		/* Number of Edges */
+		std::uint32_t edges;
+
+		/* Number of bytes of all labels */
+		std::uint64_t labelBytes;
+
+		/* FNV-1a hash of every byte after the header */
+		std::uint64_t checksum;
+	};
+
+	/* Contents of the file when it could not be mapped */
+	std::vector<char> buffer;
+
+	/* Start of the file, nullptr if closed */
+	const char* data;
+
+	/* Size of the file in bytes */
+	std::size_t size;
+
+	/* True if data is mapped, false if it points into buffer */
+	bool mapped;
+
+	/* Label of Vertex id is in [labelOffsets[id], labelOffsets[id + 1]) */
+	const std::uint64_t* labelOffsets;
+
+	/* Edges of Vertex id are in [offsets[id], offsets[id + 1]) */
+	const std::uint32_t* offsets;
+
+	/* Ending Vertex id of each Edge */
+	const std::uint32_t* targets;
+
+	/* Weight of each Edge */
+	const std::int32_t* weights;
+
+	/* Vertex ids sorted by label */
+	const std::uint32_t* order;
+
+	/* Characters of all labels, in id order */
+	const char* labelBytes;
+
+	/* Number of Vertices */
+	std::uint32_t vertices;
+
+	/*
+	* Gets the label of a Vertex
+	* @param id The id of the Vertex
+	* @return view of the label in the file
+	*/
+	std::string_view label(const Id& id) const;
+
+	/*
+	* Gets the id of the Vertex with given label
+	* @param label The label of the Vertex
+	* @return id of the Vertex, or NO_ID if not found
+	*/
+	Id find(const Label& label) const;
+
+	/*
+	* Helper for Open, points the arrays into the file after checking the
+	* header describes arrays that fit in it
+	* @param verify True to check the checksum
+	* @return true if the file holds a valid Snapshot, else false
+	*/
+	bool attach(bool verify);
+
+	/*
+	* Gets the size of an array rounded up to a multiple of 8 bytes
+	* @param bytes The size of the array
+	* @return the padded size
+	*/
+	static std::uint64_t pad(const std::uint64_t& bytes);
+
+	/*
+	* FNV-1a hash of a range of bytes
+	* @param bytes The start of the range
+	* @param count The number of bytes
+	* @return the hash
+	*/
+	static std::uint64_t checksum(const char* bytes, std::size_t count);
+};
+#endif  // SNAPSHOT_H
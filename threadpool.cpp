@@ -0,0 +1,173 @@
+/*
+* threadpool.cpp
+*
+* Implementations for ThreadPool class
+*
+* @author Juan Arias
+*
+*/
+
+#include "threadpool.h"
+
+/*
+* Constructs ThreadPool and starts its worker threads
+* @param threads The number of workers, defaults to one per hardware thread
+*/
+ThreadPool::ThreadPool(int threads)
+
+	:task(nullptr), generation(0), running(0), stopping(false) {
+
+	if (threads <= 0) {
+
+		threads = static_cast<int>(std::thread::hardware_concurrency());
+	}
+
+	for (int worker(1); worker < threads; ++worker) {
+
+		this->threads.emplace_back(&ThreadPool::work, this, worker);
+	}
+}
+
+/*
+* Stops and joins all worker threads
+*/
+ThreadPool::~ThreadPool() {
+
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->stopping = true;
+	}
+
+	this->posted.notify_all();
+
+	for (std::thread& thread : this->threads) {
+
+		thread.join();
+	}
+}
+
+/*
+* Gets the number of workers, including the calling thread
+* @return number of workers
+*/
+int ThreadPool::Size() const {
+
+	return static_cast<int>(this->threads.size()) + 1;
+}
+
+/*
+* Calls task once on every worker and waits for all of them to finish,
+* the first exception thrown by task is rethrown once all of them
+* finished, so no worker runs task after Run returns
+* Run is not reentrant, do not call it from a task or from two threads
+* at once
+* @param task The task to call with each worker index in [0, Size())
+*/
+void ThreadPool::Run(const Task& task) {
+
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		this->task = &task;
+		this->running = static_cast<int>(this->threads.size());
+		this->error = nullptr;
+
+		++this->generation;
+	}
+
+	this->posted.notify_all();
+
+	this->call(task, 0);
+
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	this->finished.wait(lock, [this] { return this->running == 0; });
+
+	this->task = nullptr;
+
+	if (this->error) {
+
+		std::exception_ptr error(std::move(this->error));
+
+		this->error = nullptr;
+
+		std::rethrow_exception(error);
+	}
+}
+
+/*
+* Gets the part of [0, count) that a worker should handle
+* @param count The number of items to split between workers
+* @param worker The index of the worker
+* @param begin Pointer to store the first item of the worker
+* @param end Pointer to store one past the last item of the worker
+*/
+void ThreadPool::Split(std::size_t count, int worker, std::size_t* begin,
+	                   std::size_t* end) const {
+
+	std::size_t size = static_cast<std::size_t>(this->Size());
+
+	*begin = count * worker / size;
+	*end = count * (worker + 1) / size;
+}
+
+/*
+* Loop of every worker thread
+* @param worker The index of the worker
+*/
+void ThreadPool::work(int worker) {
+
+	unsigned long seen(0);
+
+	std::unique_lock<std::mutex> lock(this->mutex);
+
+	while (true) {
+
+		this->posted.wait(lock, [this, seen] {
+			return this->stopping || this->generation != seen;
+		});
+
+		if (this->stopping) {
+
+			break;
+		}
+
+		seen = this->generation;
+
+		const Task* task = this->task;
+
+		lock.unlock();
+
+		this->call(*task, worker);
+
+		lock.lock();
+
+		if (--this->running == 0) {
+
+			this->finished.notify_one();
+		}
+	}
+}
+
+/*
+* Calls the task of the current Run, keeps the first exception it throws
+* @param task The task to call
+* @param worker The index of the worker
+*/
+void ThreadPool::call(const Task& task, int worker) {
+
+	try {
+
+		task(worker);
+
+	} catch (...) {
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+
+		if (!this->error) {
+
+			this->error = std::current_exception();
+		}
+	}
+}
@@ -0,0 +1,116 @@
+/*
+* threadpool.h
+*
+* Interface/specifications for ThreadPool class
+*
+* @author Juan Arias
+*
+*/
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+* A ThreadPool keeps worker threads alive between parallel steps.
+* Run hands the same task to every worker, each worker gets its own index
+* and uses it to pick its share of the work. The calling thread works as
+* worker 0, so a ThreadPool of size 1 runs everything on the caller.
+*/
+class ThreadPool {
+
+public:
+
+	/* Type definitions */
+	using Task = std::function<void(int)>;
+
+	/*
+	* Constructs ThreadPool and starts its worker threads
+	* @param threads The number of workers, defaults to one per hardware thread
+	*/
+	explicit ThreadPool(int threads = 0);
+
+	/*
+	* Stops and joins all worker threads
+	*/
+	virtual ~ThreadPool();
+
+	ThreadPool(const ThreadPool& other)            = delete;
+	ThreadPool& operator=(const ThreadPool& other) = delete;
+
+	/*
+	* Gets the number of workers, including the calling thread
+	* @return number of workers
+	*/
+	int Size() const;
+
+	/*
+	* Calls task once on every worker and waits for all of them to finish,
+	* the first exception thrown by task is rethrown once all of them
+	* finished
+	* Run is not reentrant, do not call it from a task or from two threads
+	* at once
+	* @param task The task to call with each worker index in [0, Size())
+	*/
+	void Run(const Task& task);
+
+	/*
+	* Gets the part of [0, count) that a worker should handle
+	* @param count The number of items to split between workers
+	* @param worker The index of the worker
+	* @param begin Pointer to store the first item of the worker
+	* @param end Pointer to store one past the last item of the worker
+	*/
+	void Split(std::size_t count, int worker, std::size_t* begin,
+		       std::size_t* end) const;
+
+private:
+
+	/* Worker threads, the calling thread is worker 0 and is not stored */
+	std::vector<std::thread> threads;
+
+	/* Guards all members below */
+	std::mutex mutex;
+
+	/* Signals workers that a task was posted or the pool is stopping */
+	std::condition_variable posted;
+
+	/* Signals the caller that a worker finished its task */
+	std::condition_variable finished;
+
+	/* Task of the current Run */
+	const Task* task;
+
+	/* Incremented on every Run so workers notice new tasks */
+	unsigned long generation;
+
+	/* First exception thrown by the current task, nullptr if none */
+	std::exception_ptr error;
+
+	/* Number of worker threads still running the current task */
+	int running;
+
+	/* True once the pool is being destroyed */
+	bool stopping;
+
+	/*
+	* Loop of every worker thread
+	* @param worker The index of the worker
+	*/
+	void work(int worker);
+
+	/*
+	* Calls the task of the current Run, keeps the first exception it
+	* throws
+	* @param task The task to call
+	* @param worker The index of the worker
+	*/
+	void call(const Task& task, int worker);
+};
+#endif  // THREADPOOL_H
@@ -0,0 +1,309 @@
+/*
+* writer.cpp
+*
+* Implementations for Writer class
+*
+* @author Juan Arias
+*
+*/
+
+#include <cctype>
+#include <fstream>
+#include "writer.h"
+
+/* Constant definitions */
+const std::size_t Writer::BUFFER_SIZE(1 << 20);
+
+/* Hexadecimal digits of JSON \u escapes */
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+/*
+* Constructs Writer writing to an ostream
+* @param out The ostream to write to, such as std::cout
+*/
+Writer::Writer(std::ostream& out) :out(&out) {}
+
+/*
+* Writes a Graph in a given format
+* EDGES needs labels that ReadFile can read back, not empty and without
+* whitespace, nothing is written if a label is not
+* Labels are checked before writing so a failed EDGES write leaves the
+* ostream untouched
+* @param graph The Graph to write
+* @param format The format to write in
+* @return true if written, else false
+*/
+bool Writer::Write(const Graph& graph, Format format) {
+
+	if (format == Format::EDGES) {
+
+		for (const Graph::LabelId& pair : graph.map) {
+
+			if (!Writer::isToken(pair.first)) {
+
+				return false;
+			}
+		}
+	}
+
+	switch (format) {
+
+	case Format::EDGES:
+
+		this->writeEdges(graph);
+		break;
+
+	case Format::DOT:
+
+		this->writeDot(graph);
+		break;
+
+	case Format::JSON:
+
+		this->writeJson(graph);
+		break;
+
+	default:
+
+		this->writeAdjacency(graph);
+		break;
+	}
+
+	this->spill(true);
+
+	return this->out->good();
+}
+
+/*
+* Writes a Graph to a file in a given format, see Write
+* @param graph The Graph to write
+* @param fileName The name of the file
+* @param format The format to write in
+* @return true if file successfully written, else false
+*/
+bool Writer::Save(const Graph& graph, const std::string& fileName,
+	              Format format) {
+
+	std::ofstream file(fileName, std::ios::binary);
+
+	if (!file.is_open()) {
+
+		return false;
+	}
+
+	Writer writer(file);
+
+	bool written = writer.Write(graph, format);
+
+	file.close();
+
+	return written && !file.fail();
+}
+
+/*
+* Helper for Write, formats the lines of operator<<
+* @param graph The Graph to write
+*/
+void Writer::writeAdjacency(const Graph& graph) {
+
+	for (const Graph::LabelId& pair : graph.map) {
+
+		this->buffer += pair.first;
+		this->buffer += ": ";
+		graph.vertices[pair.second].getEdges(graph.labels, &this->buffer);
+		this->buffer += '\n';
+
+		this->spill();
+	}
+}
+
+/*
+* Helper for Write, formats an edge list ReadFile can read
+* @param graph The Graph to write
+*/
+void Writer::writeEdges(const Graph& graph) {
+
+	Graph::appendWeight(&this->buffer, graph.edges);
+	this->buffer += '\n';
+
+	for (const Graph::LabelId& pair : graph.map) {
+
+		for (const Graph::Edge* curr = graph.vertices[pair.second].getNext();
+			 curr != nullptr; curr = curr->getNext()) {
+
+			this->buffer += pair.first;
+			this->buffer += ' ';
+			this->buffer += graph.labels[curr->getId()];
+			this->buffer += ' ';
+			Graph::appendWeight(&this->buffer, curr->getWeight());
+			this->buffer += '\n';
+		}
+
+		this->spill();
+	}
+}
+
+/*
+* Helper for Write, formats a GraphViz digraph
+* Vertices without Edges from them are declared as nodes, every other
+* Vertex appears in its Edges
+* @param graph The Graph to write
+*/
+void Writer::writeDot(const Graph& graph) {
+
+	this->buffer += "digraph {\n";
+
+	for (const Graph::LabelId& pair : graph.map) {
+
+		const Graph::Vertex& vertex = graph.vertices[pair.second];
+
+		if (vertex.numOfEdges() == Graph::EMPTY) {
+
+			this->buffer += '\t';
+			this->appendQuoted(pair.first, false);
+			this->buffer += ";\n";
+		}
+
+		for (const Graph::Edge* curr = vertex.getNext(); curr != nullptr;
+			 curr = curr->getNext()) {
+
+			this->buffer += '\t';
+			this->appendQuoted(pair.first, false);
+			this->buffer += " -> ";
+			this->appendQuoted(graph.labels[curr->getId()], false);
+			this->buffer += " [label=";
+			Graph::appendWeight(&this->buffer, curr->getWeight());
+			this->buffer += "];\n";
+		}
+
+		this->spill();
+	}
+
+	this->buffer += "}\n";
+}
+
+/*
+* Helper for Write, formats a JSON object
+* @param graph The Graph to write
+*/
+void Writer::writeJson(const Graph& graph) {
+
+	bool first(true);
+
+	this->buffer += "{\n\t\"vertices\": [";
+
+	for (const Graph::LabelId& pair : graph.map) {
+
+		this->buffer += (first) ? "\n\t\t" : ",\n\t\t";
+		this->appendQuoted(pair.first, true);
+
+		first = false;
+
+		this->spill();
+	}
+
+	this->buffer += (first) ? "],\n\t\"edges\": [" :
+	                "\n\t],\n\t\"edges\": [";
+
+	first = true;
+
+	for (const Graph::LabelId& pair : graph.map) {
+
+		for (const Graph::Edge* curr = graph.vertices[pair.second].getNext();
+			 curr != nullptr; curr = curr->getNext()) {
+
+			this->buffer += (first) ? "\n\t\t{\"from\": " :
+			                ",\n\t\t{\"from\": ";
+			this->appendQuoted(pair.first, true);
+			this->buffer += ", \"to\": ";
+			this->appendQuoted(graph.labels[curr->getId()], true);
+			this->buffer += ", \"weight\": ";
+			Graph::appendWeight(&this->buffer, curr->getWeight());
+			this->buffer += '}';
+
+			first = false;
+		}
+
+		this->spill();
+	}
+
+	this->buffer += (first) ? "]\n}\n" : "\n\t]\n}\n";
+}
+
+/*
+* Helper for Write, appends a label as a quoted string, escaping the
+* characters DOT or JSON do not allow in one
+* Quotes and backslashes are escaped in both, JSON also escapes control
+* characters as \u00XX. Labels without any are appended in one piece
+* @param label The label to append
+* @param json True to escape for JSON, false for DOT
+*/
+void Writer::appendQuoted(const Label& label, bool json) {
+
+	std::size_t start(0);
+
+	this->buffer += '"';
+
+	for (std::size_t i(0); i < label.size(); ++i) {
+
+		unsigned char c = static_cast<unsigned char>(label[i]);
+
+		if (c != '"' && c != '\\' && (!json || c >= 0x20)) {
+
+			continue;
+		}
+
+		this->buffer.append(label, start, i - start);
+		this->buffer += '\\';
+
+		if (c < 0x20) {
+
+			this->buffer += "u00";
+			this->buffer += HEX_DIGITS[c >> 4];
+			this->buffer += HEX_DIGITS[c & 0xf];
+
+		} else {
+
+			this->buffer += static_cast<char>(c);
+		}
+
+		start = i + 1;
+	}
+
+	this->buffer.append(label, start, std::string::npos);
+	this->buffer += '"';
+}
+
+/*
+* Writes the buffer to the ostream once it reached BUFFER_SIZE
+* The buffer is cleared and keeps its memory for the text that follows
+* @param force True to write the buffer whatever its size
+*/
+void Writer::spill(bool force) {
+
+	if (this->buffer.size() >= Writer::BUFFER_SIZE ||
+		(force && !this->buffer.empty())) {
+
+		this->out->write(this->buffer.data(),
+			             static_cast<std::streamsize>(this->buffer.size()));
+		this->buffer.clear();
+	}
+}
+
+/*
+* Checks that a label can be read back by ReadFile
+* @param label The label to check
+* @return true if the label is not empty and has no whitespace
+*/
+bool Writer::isToken(const Label& label) {
+
+	for (char c : label) {
+
+		if (std::isspace(static_cast<unsigned char>(c))) {
+
+			return false;
+		}
+	}
+
+	return !label.empty();
+}
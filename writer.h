@@ -0,0 +1,128 @@
+/*
+* writer.h
+*
+* Interface/specifications for Writer class
+*
+* @author Juan Arias
+*
+*/
+
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include "graph.h"
+
+/*
+* A Writer exports a Graph as text to an ostream.
+* Text is formatted into a buffer with std::to_chars and no temporary
+* strings, and the buffer is written to the ostream in large blocks. The
+* buffer keeps its memory between writes, so a Writer reused for many
+* Graphs stops allocating once it reached BUFFER_SIZE.
+* Vertices and Edges are written in label order.
+*/
+class Writer {
+
+public:
+
+	/* Type definitions */
+	using Label  = Graph::Label;
+	using Weight = Graph::Weight;
+
+	/*
+	* Formats written by Write
+	* ADJACENCY is the format of operator<<, a line "label: " then the
+	* Edges of the Vertex as GetEdges returns them
+	* EDGES is the format read by ReadFile, the number of Edges then a line
+	* "from to weight" per Edge, Vertices without Edges are not written
+	* DOT is a GraphViz digraph with the weight as the label of each Edge
+	* JSON is an object with a "vertices" array of labels and an "edges"
+	* array of {"from", "to", "weight"} objects
+	*/
+	enum class Format { ADJACENCY, EDGES, DOT, JSON };
+
+	/* Size the buffer grows to before it is written to the ostream */
+	static const std::size_t BUFFER_SIZE;
+
+	/*
+	* Constructs Writer writing to an ostream
+	* @param out The ostream to write to, such as std::cout
+	*/
+	explicit Writer(std::ostream& out);
+
+	/*
+	* Writes a Graph in a given format
+	* EDGES needs labels that ReadFile can read back, not empty and without
+	* whitespace, nothing is written if a label is not
+	* @param graph The Graph to write
+	* @param format The format to write in
+	* @return true if written, else false
+	*/
+	bool Write(const Graph& graph, Format format);
+
+	/*
+	* Writes a Graph to a file in a given format, see Write
+	* @param graph The Graph to write
+	* @param fileName The name of the file
+	* @param format The format to write in
+	* @return true if file successfully written, else false
+	*/
+	static bool Save(const Graph& graph, const std::string& fileName,
+		             Format format);
+
+private:
+
+	/* The ostream written to */
+	std::ostream* out;
+
+	/* Text formatted and not yet written to the ostream */
+	std::string buffer;
+
+	/*
+	* Helper for Write, formats the lines of operator<<
+	* @param graph The Graph to write
+	*/
+	void writeAdjacency(const Graph& graph);
+
+	/*
+	* Helper for Write, formats an edge list ReadFile can read
+	* @param graph The Graph to write
+	*/
+	void writeEdges(const Graph& graph);
+
+	/*
+	* Helper for Write, formats a GraphViz digraph
+	* @param graph The Graph to write
+	*/
+	void writeDot(const Graph& graph);
+
+	/*
+	* Helper for Write, formats a JSON object
+	* @param graph The Graph to write
+	*/
+	void writeJson(const Graph& graph);
+
+	/*
+	* Helper for Write, appends a label as a quoted string, escaping the
+	* characters DOT or JSON do not allow in one
+	* @param label The label to append
+	* @param json True to escape for JSON, false for DOT
+	*/
+	void appendQuoted(const Label& label, bool json);
+
+	/*
+	* Writes the buffer to the ostream once it reached BUFFER_SIZE
+	* @param force True to write the buffer whatever its size
+	*/
+	void spill(bool force = false);
+
+	/*
+	* Checks that a label can be read back by ReadFile
+	* @param label The label to check
+	* @return true if the label is not empty and has no whitespace
+	*/
+	static bool isToken(const Label& label);
+};
+#endif  // WRITER_H